@@ -0,0 +1,436 @@
+#include "blopp.hpp"
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <random>
+#include <string_view>
+
+namespace {
+    struct benchmark_node {
+        int32_t value = 0;
+        std::vector<std::shared_ptr<benchmark_node>> children = {};
+    };
+
+    struct benchmark_chain_node {
+        int32_t value = 0;
+        std::unique_ptr<benchmark_chain_node> next = {};
+    };
+
+    struct benchmark_inner_object {
+        int32_t x = 0;
+        int32_t y = 0;
+    };
+
+    struct benchmark_outer_object {
+        int32_t value = 0;
+        benchmark_inner_object inner = {};
+    };
+
+    struct benchmark_parallel_options : blopp::default_options {
+        static constexpr size_t parallel_write_chunk_size = 4096;
+        static constexpr size_t parallel_read_chunk_size = 4096;
+    };
+
+    struct benchmark_varint_integers_options : blopp::default_options {
+        static constexpr auto varint_integers = true;
+    };
+
+    template<blopp::reference_policy Vpolicy>
+    struct benchmark_policy_options : blopp::default_options {
+        static constexpr auto reference_policy = Vpolicy;
+    };
+
+    template<size_t Vindex>
+    struct benchmark_alternative {
+        int32_t value = 0;
+    };
+
+    template<size_t ... Vindices>
+    auto make_benchmark_variant(std::index_sequence<Vindices...>) -> std::variant<benchmark_alternative<Vindices>...>;
+
+    template<size_t Vcount>
+    using benchmark_variant = decltype(make_benchmark_variant(std::make_index_sequence<Vcount>{}));
+}
+
+template<size_t Vindex>
+struct blopp::object<benchmark_alternative<Vindex>> {
+    static auto map(auto& context, auto& value) {
+        context.map(value.value);
+    }
+};
+
+template<>
+struct blopp::object<benchmark_inner_object> {
+    static auto map(auto& context, auto& value) {
+        context.map(
+            value.x,
+            value.y);
+    }
+};
+
+template<>
+struct blopp::object<benchmark_outer_object> {
+    static auto map(auto& context, auto& value) {
+        context.map(
+            value.value,
+            value.inner);
+    }
+};
+
+template<>
+struct blopp::object<benchmark_chain_node> {
+    static auto map(auto& context, auto& value) {
+        context.map(
+            value.value,
+            value.next);
+    }
+};
+
+template<>
+struct blopp::object<benchmark_node> {
+    static auto map(auto& context, auto& value) {
+        context.map(
+            value.value,
+            value.children);
+    }
+};
+
+namespace {
+    static volatile size_t dummy_result = 0;
+
+    // Runs function until at least min_duration has passed, and prints the mean duration of a run.
+    void run_benchmark(const std::string_view name, const std::function<size_t()>& function) {
+        using clock = std::chrono::steady_clock;
+        constexpr auto min_duration = std::chrono::milliseconds{ 500 };
+
+        dummy_result = function();
+
+        auto run_count = size_t{ 0 };
+        const auto start = clock::now();
+        auto duration = clock::duration{};
+
+        do {
+            dummy_result = function();
+            ++run_count;
+            duration = clock::now() - start;
+        } while (duration < min_duration);
+
+        const auto mean_ms = std::chrono::duration<double, std::milli>(duration).count() / static_cast<double>(run_count);
+        std::printf("%-48.*s %12.3f ms %8zu runs\n", static_cast<int>(name.size()), name.data(), mean_ms, run_count);
+    }
+
+    // Layers of nodes, where every node has a few children, picked at random from the next layer.
+    std::shared_ptr<benchmark_node> create_dag(const size_t layer_count, const size_t layer_size, const size_t child_count) {
+        auto random = std::mt19937{ 1234 };
+        auto pick = std::uniform_int_distribution<size_t>{ 0, layer_size - 1 };
+
+        auto layers = std::vector<std::vector<std::shared_ptr<benchmark_node>>>(layer_count);
+        auto value = int32_t{ 0 };
+        for (auto& layer : layers) {
+            for (size_t i = 0; i < layer_size; i++) {
+                auto node = std::make_shared<benchmark_node>();
+                node->value = value++;
+                layer.push_back(std::move(node));
+            }
+        }
+
+        for (size_t layer = 0; layer + 1 < layer_count; layer++) {
+            for (auto& node : layers.at(layer)) {
+                for (size_t i = 0; i < child_count; i++) {
+                    node->children.push_back(layers.at(layer + 1).at(pick(random)));
+                }
+            }
+        }
+
+        auto root = std::make_shared<benchmark_node>();
+        root->children = layers.front();
+        return root;
+    }
+
+    template<blopp::reference_policy Vpolicy>
+    void run_dag_benchmarks(const std::string_view policy_name, const std::shared_ptr<benchmark_node>& dag) {
+        using options = benchmark_policy_options<Vpolicy>;
+
+        auto buffer = blopp::write_output_type{};
+        run_benchmark(std::string{ "dag_write/" } + std::string{ policy_name }, [&]() {
+            auto write_result = blopp::write<options>(dag, buffer, blopp::write_output_mode::replace);
+            return write_result ? write_result->size() : size_t{ 0 };
+        });
+
+        run_benchmark(std::string{ "dag_read/" } + std::string{ policy_name }, [&]() {
+            auto read_result = blopp::read<options, std::shared_ptr<benchmark_node>>(buffer);
+            return read_result ? read_result->value->children.size() : size_t{ 0 };
+        });
+    }
+
+    void run_dag_benchmarks() {
+        const auto dag = create_dag(8, 25000, 4);
+
+        run_dag_benchmarks<blopp::reference_policy::ordered_map>("ordered_map", dag);
+        run_dag_benchmarks<blopp::reference_policy::hash_map>("hash_map", dag);
+        run_dag_benchmarks<blopp::reference_policy::flat_vector>("flat_vector", dag);
+    }
+
+    void run_nested_benchmarks() {
+        auto chain = benchmark_chain_node{};
+        auto* node = &chain;
+        for (int32_t i = 1; i < 10000; ++i) {
+            node->next = std::make_unique<benchmark_chain_node>(benchmark_chain_node{ .value = i });
+            node = node->next.get();
+        }
+
+        auto write_result = blopp::write(chain);
+        if (!write_result) {
+            std::printf("Failed to write nested benchmark data.\n");
+            return;
+        }
+
+        run_benchmark("nested_read/chain", [&]() {
+            auto read_result = blopp::read<benchmark_chain_node>(*write_result);
+            return read_result ? static_cast<size_t>(read_result->value.value) : size_t{ 0 };
+        });
+
+        const auto objects = std::vector<benchmark_outer_object>(100000);
+        auto objects_write_result = blopp::write(objects);
+        if (!objects_write_result) {
+            std::printf("Failed to write nested benchmark data.\n");
+            return;
+        }
+
+        auto objects_output = std::vector<benchmark_outer_object>{};
+        run_benchmark("nested_read/objects", [&]() {
+            auto read_result = blopp::read_into(*objects_write_result, objects_output);
+            return read_result ? objects_output.size() : size_t{ 0 };
+        });
+    }
+
+    void run_parallel_write_benchmarks() {
+        auto products = std::vector<benchmark_outer_object>(2000000);
+        for (size_t i = 0; i < products.size(); ++i) {
+            products[i].value = static_cast<int32_t>(i);
+        }
+
+        auto buffer = blopp::write_output_type{};
+        run_benchmark("parallel_write/serial", [&]() {
+            auto write_result = blopp::write(products, buffer, blopp::write_output_mode::replace);
+            return write_result ? write_result->size() : size_t{ 0 };
+        });
+
+        run_benchmark("parallel_write/thread_pool", [&]() {
+            auto write_result = blopp::write<benchmark_parallel_options>(products, buffer, blopp::write_output_mode::replace);
+            return write_result ? write_result->size() : size_t{ 0 };
+        });
+    }
+
+    void run_parallel_read_benchmarks() {
+        auto products = std::vector<benchmark_outer_object>(2000000);
+        for (size_t i = 0; i < products.size(); ++i) {
+            products[i].value = static_cast<int32_t>(i);
+        }
+
+        auto write_result = blopp::write(products);
+        if (!write_result) {
+            std::printf("Failed to write parallel read benchmark data.\n");
+            return;
+        }
+
+        auto output = std::vector<benchmark_outer_object>{};
+        run_benchmark("parallel_read/serial", [&]() {
+            auto read_result = blopp::read_into(*write_result, output);
+            return read_result ? output.size() : size_t{ 0 };
+        });
+
+        run_benchmark("parallel_read/thread_pool", [&]() {
+            auto read_result = blopp::read_into<benchmark_parallel_options>(*write_result, output);
+            return read_result ? output.size() : size_t{ 0 };
+        });
+    }
+
+    void run_parallel_read_reference_benchmarks() {
+        using map_t = std::map<std::shared_ptr<int32_t>, int32_t>;
+
+        // Every map is keyed by values shared with maps far away, in other chunks.
+        auto shared_values = std::vector<std::shared_ptr<int32_t>>(1000);
+        for (size_t i = 0; i < shared_values.size(); ++i) {
+            shared_values[i] = std::make_shared<int32_t>(static_cast<int32_t>(i));
+        }
+
+        auto maps = std::vector<map_t>(200000);
+        for (size_t i = 0; i < maps.size(); ++i) {
+            for (size_t j = 0; j < 4; ++j) {
+                maps[i].emplace(shared_values[(i * 7 + j * 251) % shared_values.size()], static_cast<int32_t>(j));
+            }
+        }
+
+        auto write_result = blopp::write(maps);
+        if (!write_result) {
+            std::printf("Failed to write parallel read reference benchmark data.\n");
+            return;
+        }
+
+        auto output = std::vector<map_t>{};
+        run_benchmark("parallel_read_reference/serial", [&]() {
+            auto read_result = blopp::read_into(*write_result, output);
+            return read_result ? output.size() : size_t{ 0 };
+        });
+
+        run_benchmark("parallel_read_reference/thread_pool", [&]() {
+            auto read_result = blopp::read_into<benchmark_parallel_options>(*write_result, output);
+            return read_result ? output.size() : size_t{ 0 };
+        });
+    }
+
+    void run_varint_benchmarks() {
+        auto strings = std::vector<std::string>(1000000);
+        for (size_t i = 0; i < strings.size(); ++i) {
+            strings[i] = "Product " + std::to_string(i);
+        }
+
+        auto buffer = blopp::write_output_type{};
+        run_benchmark("varint_write/fixed", [&]() {
+            auto write_result = blopp::write(strings, buffer, blopp::write_output_mode::replace);
+            return write_result ? write_result->size() : size_t{ 0 };
+        });
+        const auto fixed_size = buffer.size();
+
+        auto output = std::vector<std::string>{};
+        run_benchmark("varint_read/fixed", [&]() {
+            auto read_result = blopp::read_into(buffer, output);
+            return read_result ? output.size() : size_t{ 0 };
+        });
+
+        run_benchmark("varint_write/varint", [&]() {
+            auto write_result = blopp::write<blopp::varint_default_options>(strings, buffer, blopp::write_output_mode::replace);
+            return write_result ? write_result->size() : size_t{ 0 };
+        });
+        const auto varint_size = buffer.size();
+
+        run_benchmark("varint_read/varint", [&]() {
+            auto read_result = blopp::read_into<blopp::varint_default_options>(buffer, output);
+            return read_result ? output.size() : size_t{ 0 };
+        });
+
+        std::printf("varint_size/fixed %zu bytes, varint %zu bytes\n", fixed_size, varint_size);
+    }
+
+    void run_varint_integers_benchmarks() {
+        // Small values of both signs, with a large value now and then.
+        auto random = std::mt19937_64{ 1234 };
+        auto values = std::vector<int64_t>(4000000);
+        for (auto& value : values) {
+            value = random() % 16 == 0 ? static_cast<int64_t>(random()) : static_cast<int64_t>(random() % 128) - 64;
+        }
+
+        auto buffer = blopp::write_output_type{};
+        run_benchmark("varint_integers_write/fixed", [&]() {
+            auto write_result = blopp::write(values, buffer, blopp::write_output_mode::replace);
+            return write_result ? write_result->size() : size_t{ 0 };
+        });
+        const auto fixed_size = buffer.size();
+
+        auto output = std::vector<int64_t>{};
+        run_benchmark("varint_integers_read/fixed", [&]() {
+            auto read_result = blopp::read_into(buffer, output);
+            return read_result ? output.size() : size_t{ 0 };
+        });
+
+        run_benchmark("varint_integers_write/varint", [&]() {
+            auto write_result = blopp::write<benchmark_varint_integers_options>(values, buffer, blopp::write_output_mode::replace);
+            return write_result ? write_result->size() : size_t{ 0 };
+        });
+        const auto varint_size = buffer.size();
+
+        run_benchmark("varint_integers_read/varint", [&]() {
+            auto read_result = blopp::read_into(buffer, output);
+            return read_result ? output.size() : size_t{ 0 };
+        });
+
+        std::printf("varint_integers_size/fixed %zu bytes, varint %zu bytes\n", fixed_size, varint_size);
+
+        // Typical 32 bit integers, as counts and identifiers, of random bit widths and so of one to five bytes as varints.
+        auto int32_values = std::vector<int32_t>(4000000);
+        for (auto& value : int32_values) {
+            value = static_cast<int32_t>(random() >> (32 + random() % 32));
+        }
+
+        run_benchmark("varint_integers_write/int32_fixed", [&]() {
+            auto write_result = blopp::write(int32_values, buffer, blopp::write_output_mode::replace);
+            return write_result ? write_result->size() : size_t{ 0 };
+        });
+
+        auto int32_output = std::vector<int32_t>{};
+        run_benchmark("varint_integers_read/int32_fixed", [&]() {
+            auto read_result = blopp::read_into(buffer, int32_output);
+            return read_result ? int32_output.size() : size_t{ 0 };
+        });
+
+        run_benchmark("varint_integers_write/int32_varint", [&]() {
+            auto write_result = blopp::write<benchmark_varint_integers_options>(int32_values, buffer, blopp::write_output_mode::replace);
+            return write_result ? write_result->size() : size_t{ 0 };
+        });
+
+        run_benchmark("varint_integers_read/int32_varint", [&]() {
+            auto read_result = blopp::read_into(buffer, int32_output);
+            return read_result ? int32_output.size() : size_t{ 0 };
+        });
+    }
+
+    template<size_t Vcount>
+    void run_variant_benchmark() {
+        using variant_t = benchmark_variant<Vcount>;
+
+        // Alternatives picked at random, to not favor alternatives with low indices.
+        auto random = std::mt19937{ 1234 };
+        auto pick = std::uniform_int_distribution<size_t>{ 0, Vcount - 1 };
+
+        auto input = std::vector<variant_t>(100000);
+        for (auto& value : input) {
+            const auto index = pick(random);
+            [&]<size_t ... Vindices>(std::index_sequence<Vindices...>) {
+                (void)((index == Vindices && (value.template emplace<Vindices>(), true)) || ...);
+            }(std::make_index_sequence<Vcount>{});
+        }
+
+        auto write_result = blopp::write(input);
+        if (!write_result) {
+            std::printf("Failed to write variant benchmark data.\n");
+            return;
+        }
+
+        auto output = std::vector<variant_t>{};
+        run_benchmark("variant_read/" + std::to_string(Vcount), [&]() {
+            auto read_result = blopp::read_into(*write_result, output);
+            return read_result ? output.size() : size_t{ 0 };
+        });
+    }
+
+    void run_variant_benchmarks() {
+        run_variant_benchmark<4>();
+        run_variant_benchmark<32>();
+        run_variant_benchmark<128>();
+    }
+}
+
+// Runs all benchmarks, or the ones whose group name is passed as argument.
+int main(int argc, char** argv) {
+    const auto filter = argc > 1 ? std::string_view{ argv[1] } : std::string_view{};
+
+    const auto benchmarks = std::vector<std::pair<std::string_view, std::function<void()>>>{
+        { "dag", [] { run_dag_benchmarks(); } },
+        { "nested", [] { run_nested_benchmarks(); } },
+        { "parallel_write", [] { run_parallel_write_benchmarks(); } },
+        { "parallel_read", [] { run_parallel_read_benchmarks(); } },
+        { "parallel_read_reference", [] { run_parallel_read_reference_benchmarks(); } },
+        { "variant", [] { run_variant_benchmarks(); } },
+        { "varint", [] { run_varint_benchmarks(); } },
+        { "varint_integers", [] { run_varint_integers_benchmarks(); } }
+    };
+
+    for (const auto& [name, benchmark] : benchmarks) {
+        if (filter.empty() || filter == name) {
+            benchmark();
+        }
+    }
+
+    return 0;
+}
@@ -28,6 +28,9 @@
 
 //#define BLOPP_USE_RESULT_WRAPPER
 //#define BLOPP_NO_FILESYSTEM
+//#define BLOPP_NO_MEMORY_MAPPING
+//#define BLOPP_NO_SIMD
+//#define BLOPP_NO_THREADS
 
 #if __has_include(<expected>) && !defined(BLOPP_USE_RESULT_WRAPPER)
 #include <expected>
@@ -46,12 +49,25 @@
 #include <list>
 #include <span>
 #include <map>
+#include <memory_resource>
 #include <tuple>
+#include <utility>
+#include <any>
 #include <variant>
 #include <typeindex>
+#include <string_view>
+#include <bit>
 #include <stdint.h>
 #include <stddef.h>
 #include <cstring>
+#include <functional>
+
+#if defined(BLOPP_THREADS)
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#endif
 
 #if !defined(BLOPP_NO_FILESYSTEM)
 #include <filesystem>
@@ -59,6 +75,34 @@
 #include <ostream>
 #endif
 
+#if !defined(BLOPP_NO_FILESYSTEM) && !defined(BLOPP_NO_MEMORY_MAPPING) && (defined(__unix__) || defined(__APPLE__))
+#define BLOPP_HAS_MEMORY_MAPPING
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#if !defined(BLOPP_NO_SIMD) && defined(__AVX2__)
+#define BLOPP_HAS_AVX2
+#endif
+
+#if !defined(BLOPP_NO_SIMD) && (defined(__SSSE3__) || defined(__AVX2__))
+#define BLOPP_HAS_SSSE3
+#endif
+
+#if !defined(BLOPP_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define BLOPP_HAS_SSE2
+#endif
+
+#if defined(BLOPP_HAS_AVX2)
+#include <immintrin.h>
+#elif defined(BLOPP_HAS_SSSE3)
+#include <tmmintrin.h>
+#elif defined(BLOPP_HAS_SSE2)
+#include <emmintrin.h>
+#endif
+
 #if !defined(__cpp_lib_expected) || defined(BLOPP_USE_RESULT_WRAPPER)
 #define BLOPP_EXPECTED_IS_RESULT_WRAPPER
 #endif
@@ -174,6 +218,163 @@ namespace blopp {
         using format_size_type = uint8_t;
     };
 
+    // Binary format type written as an unsigned LEB128 varint, 7 bits per byte, holding values of up to T.
+    // Valid for offsets, counts and variant indices, but not for string_char_size_type and format_size_type.
+    // Passed to map_as of contexts, writes integers of T as varints, ZigZag encoded if T is signed.
+    template<std::integral T>
+    struct varint {
+        using value_type = T;
+    };
+
+    struct varint_binary_format_types {
+        using string_offset_type = varint<uint64_t>;
+        using string_char_size_type = uint8_t;
+        using object_offset_type = varint<uint64_t>;
+        using object_property_count_type = varint<uint16_t>;
+        using list_offset_type = varint<uint64_t>;
+        using list_element_count_type = varint<uint64_t>;
+        using map_offset_type = varint<uint64_t>;
+        using map_element_count_type = varint<uint64_t>;
+        using variant_index_type = varint<uint16_t>;
+        using format_size_type = uint16_t;
+    };
+
+    // How shared pointers are tracked, to write and read references to values written earlier. 
+    // Selected via reference_policy of the options, ordered_map if not defined.
+    enum class reference_policy : uint8_t {
+        ordered_map, // std::map.
+        hash_map, // Open addressing hash map.
+        flat_vector, // Sorted vector while reading, as values are read in the order written. Hash map while writing.
+        none // Not tracked. Every shared pointer is written as a value of its own, and references fail to read.
+    };
+
+    /*
+    * Runs the tasks of parallel writes and reads, selected via write_executor and read_executor of the options, 
+    * serial_executor if not defined, or thread_pool_executor if BLOPP_THREADS is defined.
+    * - run: Calls task once per index in [0, task_count), possibly in parallel, and returns when all calls have returned.
+    */
+    template<typename T>
+    concept task_executor = requires(size_t task_count, const std::function<void(size_t)>& task) {
+        T::run(task_count, task);
+    };
+
+    // Runs tasks one after another on the calling thread.
+    struct serial_executor {
+        static void run(const size_t task_count, const std::function<void(size_t)>& task) {
+            for (size_t i = 0; i < task_count; ++i) {
+                task(i);
+            }
+        }
+    };
+
+#if defined(BLOPP_THREADS)
+
+    // Runs tasks on a shared pool of threads, one per hardware thread including the calling thread. 
+    // Tasks are claimed one at a time, so threads finishing their tasks early take over the remaining ones.
+    class thread_pool_executor {
+
+    public:
+
+        static void run(const size_t task_count, const std::function<void(size_t)>& task) {
+            static auto pool = thread_pool_executor{ std::max(std::thread::hardware_concurrency(), 1u) - 1 };
+            pool.run_tasks(task_count, task);
+        }
+
+        explicit thread_pool_executor(const size_t thread_count) {
+            m_threads.reserve(thread_count);
+            for (size_t i = 0; i < thread_count; ++i) {
+                m_threads.emplace_back([this]() { run_thread(); });
+            }
+        }
+
+        ~thread_pool_executor() {
+            {
+                auto lock = std::lock_guard{ m_mutex };
+                m_stopping = true;
+            }
+            m_task_condition.notify_all();
+
+            for (auto& thread : m_threads) {
+                thread.join();
+            }
+        }
+
+        thread_pool_executor(const thread_pool_executor&) = delete;
+        thread_pool_executor(thread_pool_executor&&) = delete;
+        thread_pool_executor& operator = (const thread_pool_executor&) = delete;
+        thread_pool_executor& operator = (thread_pool_executor&&) = delete;
+
+        void run_tasks(const size_t task_count, const std::function<void(size_t)>& task) {
+            auto run_lock = std::lock_guard{ m_run_mutex };
+
+            {
+                // Threads woken late by the previous run may still be claiming its tasks.
+                auto lock = std::unique_lock{ m_mutex };
+                m_done_condition.wait(lock, [&]() { return m_active_thread_count == 0; });
+
+                m_task = &task;
+                m_task_count = task_count;
+                m_next_task_index.store(0);
+                ++m_generation;
+            }
+            m_task_condition.notify_all();
+
+            run_claimed_tasks();
+
+            auto lock = std::unique_lock{ m_mutex };
+            m_done_condition.wait(lock, [&]() { return m_active_thread_count == 0; });
+        }
+
+    private:
+
+        void run_thread() {
+            auto generation = uint64_t{ 0 };
+            auto lock = std::unique_lock{ m_mutex };
+
+            while (true) {
+                m_task_condition.wait(lock, [&]() { return m_stopping || m_generation != generation; });
+                if (m_stopping) {
+                    return;
+                }
+
+                generation = m_generation;
+                ++m_active_thread_count;
+                lock.unlock();
+
+                run_claimed_tasks();
+
+                lock.lock();
+                if (--m_active_thread_count == 0) {
+                    m_done_condition.notify_all();
+                }
+            }
+        }
+
+        void run_claimed_tasks() {
+            for (auto index = m_next_task_index.fetch_add(1); index < m_task_count; index = m_next_task_index.fetch_add(1)) {
+                (*m_task)(index);
+            }
+        }
+
+        std::vector<std::thread> m_threads = {};
+        std::mutex m_run_mutex = {};
+        std::mutex m_mutex = {};
+        std::condition_variable m_task_condition = {};
+        std::condition_variable m_done_condition = {};
+        const std::function<void(size_t)>* m_task = nullptr;
+        size_t m_task_count = 0;
+        std::atomic<size_t> m_next_task_index = 0;
+        uint64_t m_generation = 0;
+        size_t m_active_thread_count = 0;
+        bool m_stopping = false;
+
+    };
+
+    using default_executor = thread_pool_executor;
+#else
+    using default_executor = serial_executor;
+#endif
+
     struct default_options : default_binary_format_types {
         static constexpr auto allow_object_excess_bytes = true;
         static constexpr auto allow_more_object_members = true;
@@ -184,6 +385,17 @@ namespace blopp {
         static constexpr auto allow_more_object_members = true;
     };
 
+    // Writes offsets, counts and variant indices as varints, at the cost of an extra pass over the value while writing.
+    struct varint_default_options : varint_binary_format_types {
+        static constexpr auto allow_object_excess_bytes = true;
+        static constexpr auto allow_more_object_members = true;
+    };
+
+    // Skips bounds and type checks while reading, for input already validated by blopp::verify.
+    struct trusted_default_options : default_options {
+        static constexpr auto trusted_input = true;
+    };
+
 
     enum class write_error_code {
         cannot_open_file,
@@ -197,6 +409,12 @@ namespace blopp {
         list_element_count_overflow,
         map_offset_overflow,
         map_element_count_overflow,
+        insufficient_buffer,
+        cannot_write_stream,
+        cannot_write_file,
+        max_depth_exceeded,
+        mismatching_varint_plan,
+        cyclic_shared_ptr
     };
 
     enum class read_error_code {
@@ -218,2012 +436,7460 @@ namespace blopp {
         bad_reference_position,
         bad_reference_type,
         bad_variant_index,
-        bad_boolean_value
+        bad_boolean_value,
+        bad_data_type,
+        misaligned_data,
+        null_value,
+        out_of_range,
+        fragmented_data,
+        bad_utf8_string,
+        max_depth_exceeded,
+        bad_list_element_index,
+        bad_varint,
+        max_message_size_exceeded
     };
 
 
     using write_output_type = std::vector<uint8_t>;
     using write_result_type = expected<write_output_type, write_error_code>;
 
+    enum class write_output_mode : uint8_t {
+        append,
+        replace
+    };
+
+    using write_output_span_type = std::span<const uint8_t>;
+    using write_span_result_type = expected<write_output_span_type, write_error_code>;
+
     template<typename T>
     [[nodiscard]] auto write(const T& value) -> write_result_type;
 
     template<typename TOptions, typename T>
     [[nodiscard]] auto write(const T& value) -> write_result_type;
 
-#if !defined(BLOPP_NO_FILESYSTEM)
-
-    using write_void_result_type = expected<void, write_error_code>;
-
     template<typename T>
-    [[nodiscard]] auto write(const T& value, std::ostream& stream) -> write_void_result_type;
+    [[nodiscard]] auto write(
+        const T& value,
+        write_output_type& output,
+        write_output_mode output_mode = write_output_mode::append) -> write_span_result_type;
 
     template<typename TOptions, typename T>
-    [[nodiscard]] auto write(const T& value, std::ostream& stream) -> write_void_result_type;
+    [[nodiscard]] auto write(
+        const T& value,
+        write_output_type& output,
+        write_output_mode output_mode = write_output_mode::append) -> write_span_result_type;
+
+    using write_to_output_type = std::span<uint8_t>;
+    using write_to_result_type = expected<size_t, write_error_code>;
 
     template<typename T>
-    [[nodiscard]] auto write(const T& value, const std::filesystem::path& path) -> write_void_result_type;
+    [[nodiscard]] auto write_to(write_to_output_type output, const T& value) -> write_to_result_type;
 
     template<typename TOptions, typename T>
-    [[nodiscard]] auto write(const T& value, const std::filesystem::path& path) -> write_void_result_type;
+    [[nodiscard]] auto write_to(write_to_output_type output, const T& value) -> write_to_result_type;
 
-#endif
-
-    using read_input_type = std::span<const uint8_t>;
+    using serialized_size_result_type = expected<size_t, write_error_code>;
 
     template<typename T>
-    struct read_result
-    {
-        using value_type = T;
+    [[nodiscard]] auto serialized_size(const T& value) -> serialized_size_result_type;
 
-        T value = {};
-        read_input_type remaining = {};
+    template<typename TOptions, typename T>
+    [[nodiscard]] auto serialized_size(const T& value) -> serialized_size_result_type;
+
+    /*
+    * Destination of written bytes.
+    * - position: Number of bytes written so far.
+    * - append: Appends bytes to the end of the output.
+    * - reserve: Appends placeholder bytes, later overwritten via patch. Returns position of first reserved byte.
+    * - patch: Overwrites bytes previously reserved at position.
+    * - error: Error of the output, if any, checked after all data has been written.
+    */
+    template<typename T>
+    concept output_sink = requires(T& sink, const T& const_sink, const uint8_t* data, size_t size) {
+        { const_sink.position() } -> std::convertible_to<size_t>;
+        sink.append(uint8_t{});
+        sink.append(data, size);
+        { sink.reserve(size) } -> std::convertible_to<size_t>;
+        sink.patch(size, data, size);
+        { const_sink.error() } -> std::same_as<std::optional<write_error_code>>;
     };
 
-    template<typename T>
-    using read_result_type = expected<read_result<T>, read_error_code>;
+    template<typename TAllocator = std::allocator<uint8_t>>
+    class vector_output_sink {
 
-    template<typename T>
-    [[nodiscard]] auto read(read_input_type input) -> read_result_type<T>;
+    public:
 
-    template<typename TOptions, typename T>
-    [[nodiscard]] auto read(read_input_type input) -> read_result_type<T>;
+        using output_type = std::vector<uint8_t, TAllocator>;
 
-#if !defined(BLOPP_NO_FILESYSTEM)
+        // Appends after bytes already in output, which aren't part of the positions of the sink.
+        explicit vector_output_sink(output_type& output) :
+            m_output{ output },
+            m_start_position{ output.size() }
+        {}
 
-    template<typename T>
-    [[nodiscard]] auto read(std::istream& stream) -> read_result_type<T>;
+        [[nodiscard]] inline size_t position() const {
+            return m_output.size() - m_start_position;
+        }
 
-    template<typename TOptions, typename T>
-    [[nodiscard]] auto read(std::istream& stream) -> read_result_type<T>;
+        inline void append(const uint8_t value) {
+            m_output.push_back(value);
+        }
 
-    template<typename T>
-    [[nodiscard]] auto read(const std::filesystem::path& path) -> read_result_type<T>;
+        inline void append(const uint8_t* data, const size_t size) {
+            m_output.insert(m_output.end(), data, data + size);
+        }
 
-    template<typename TOptions, typename T>
-    [[nodiscard]] auto read(const std::filesystem::path& path) -> read_result_type<T>;
+        [[nodiscard]] inline size_t reserve(const size_t size) {
+            const auto position = this->position();
+            m_output.resize(m_output.size() + size);
+            return position;
+        }
 
-#endif
+        inline void patch(const size_t position, const uint8_t* data, const size_t size) {
+            std::memcpy(m_output.data() + m_start_position + position, data, size);
+        }
 
-    template<typename T>
-    struct object;
+        [[nodiscard]] inline auto error() const -> std::optional<write_error_code> {
+            return {};
+        }
+
+    private:
+
+        output_type& m_output;
+        size_t m_start_position;
 
-    enum class context_direction : uint8_t {
-        read,
-        write
     };
 
-}
+    using pmr_vector_output_sink = vector_output_sink<std::pmr::polymorphic_allocator<uint8_t>>;
 
+    class span_output_sink {
 
-// Implementations.
-namespace blopp::impl {
+    public:
 
-    template<typename T>
-    constexpr bool always_false = false;
+        explicit span_output_sink(write_to_output_type output) :
+            m_output{ output }
+        {}
 
-    enum class data_types : uint8_t {
-        unspecified = 0,
-        boolean = 1,
-        character = 2,
-        int8 = 3,
-        int16 = 4,
-        int32 = 5,
-        int64 = 6,
-        uint8 = 7,
-        uint16 = 8,
-        uint32 = 9,
-        uint64 = 10,
-        float32 = 11,
-        float64 = 12,
-        string = 13,
-        object = 14,
-        list = 15,
-        map = 16,
-        variant = 17
-    };
+        [[nodiscard]] inline size_t position() const {
+            return m_position;
+        }
 
-    enum class nullable_value_flags : uint8_t {
-        is_null = 0,
-        has_value = 1,
-        is_reference = 2,
-        has_value_and_is_reference = 3
-    };
+        inline void append(const uint8_t value) {
+            if (m_position < m_output.size()) {
+                m_output[m_position] = value;
+            }
+            else {
+                m_overflow = true;
+            }
+            ++m_position;
+        }
 
+        inline void append(const uint8_t* data, const size_t size) {
+            if (size <= m_output.size() - std::min(m_position, m_output.size())) {
+                std::memcpy(m_output.data() + m_position, data, size);
+            }
+            else {
+                m_overflow = true;
+            }
+            m_position += size;
+        }
 
-    template<data_types Vdata_type>
-    struct fundamental_traits_base {
-        static constexpr auto is_fundamental = true;
-        static constexpr auto data_type = Vdata_type;
-    };
+        [[nodiscard]] inline size_t reserve(const size_t size) {
+            const auto position = m_position;
+            if (size <= m_output.size() - std::min(m_position, m_output.size())) {
+                std::memset(m_output.data() + m_position, 0, size);
+            }
+            else {
+                m_overflow = true;
+            }
+            m_position += size;
+            return position;
+        }
 
-    template<typename T>
-    struct fundamental_traits {
-        static constexpr auto is_fundamental = false;
-    };
+        inline void patch(const size_t position, const uint8_t* data, const size_t size) {
+            if (!m_overflow) {
+                std::memcpy(m_output.data() + position, data, size);
+            }
+        }
 
-    template<>
-    struct fundamental_traits<bool> : fundamental_traits_base< data_types::boolean> {};
-    template<>
-    struct fundamental_traits<int8_t> : fundamental_traits_base< data_types::int8> {};
-    template<>
-    struct fundamental_traits<int16_t> : fundamental_traits_base< data_types::int16> {};
-    template<>
-    struct fundamental_traits<int32_t> : fundamental_traits_base< data_types::int32> {};
-    template<>
-    struct fundamental_traits<int64_t> : fundamental_traits_base< data_types::int64> {};
-    template<>
-    struct fundamental_traits<uint8_t> : fundamental_traits_base< data_types::uint8> {};
-    template<>
-    struct fundamental_traits<uint16_t> : fundamental_traits_base< data_types::uint16> {};
-    template<>
-    struct fundamental_traits<uint32_t> : fundamental_traits_base< data_types::uint32> {};
-    template<>
-    struct fundamental_traits<uint64_t> : fundamental_traits_base< data_types::uint64> {};
-    template<>
-    struct fundamental_traits<char> : fundamental_traits_base< data_types::character> {};
-    template<>
-    struct fundamental_traits<char8_t> : fundamental_traits_base< data_types::character> {};
-    template<>
-    struct fundamental_traits<float> : fundamental_traits_base< data_types::float32> {};
-    template<>
-    struct fundamental_traits<double> : fundamental_traits_base< data_types::float64> {};
+        [[nodiscard]] inline auto error() const -> std::optional<write_error_code> {
+            if (m_overflow) {
+                return write_error_code::insufficient_buffer;
+            }
+            return {};
+        }
 
+    private:
 
-    template<typename T, template<typename...> typename TRef>
-    struct is_specialization : std::false_type {};
+        write_to_output_type m_output;
+        size_t m_position = 0;
+        bool m_overflow = false;
 
-    template<template<typename...> typename TRef, typename... TArgs>
-    struct is_specialization<TRef<TArgs...>, TRef> : std::true_type {};
+    };
 
-    template<typename T, template<typename...> typename TRef>
-    static constexpr bool is_specialization_v = is_specialization<T, TRef>::value;
+    class counting_output_sink {
 
-    template<typename T>
-    struct is_std_array : std::false_type {};
+    public:
 
-    template<typename T, size_t Vn>
-    struct is_std_array<std::array<T, Vn>> : std::true_type {};
+        [[nodiscard]] inline size_t position() const {
+            return m_position;
+        }
 
-    template<typename T>
-    struct is_std_span : std::false_type {};
+        inline void append(const uint8_t) {
+            ++m_position;
+        }
 
-    template<typename T, size_t Vextent>
-    struct is_std_span<std::span<T, Vextent>> : std::true_type {};
+        inline void append(const uint8_t*, const size_t size) {
+            m_position += size;
+        }
 
-    template<typename T>
-    static constexpr bool is_std_array_v = is_std_array<T>::value;
+        [[nodiscard]] inline size_t reserve(const size_t size) {
+            const auto position = m_position;
+            m_position += size;
+            return position;
+        }
 
-    template<typename T>
-    static constexpr bool is_std_span_v = is_std_span<T>::value;
+        inline void patch(const size_t, const uint8_t*, const size_t) {
+        }
 
-    template<typename T>
-    static constexpr bool is_std_vector_v = is_specialization_v<T, std::vector>;
+        [[nodiscard]] inline auto error() const -> std::optional<write_error_code> {
+            return {};
+        }
 
-    template<typename T>
-    static constexpr bool is_std_list_v = is_specialization_v<T, std::list>;
+    private:
 
-    template<typename T>
-    static constexpr bool is_std_string_v = is_specialization_v<T, std::basic_string>;
+        size_t m_position = 0;
 
-    template<typename T>
-    static constexpr bool is_std_unique_ptr_v = is_specialization_v<T, std::unique_ptr>;
-
-    template<typename T>
-    static constexpr bool is_std_shared_ptr_v = is_specialization_v<T, std::shared_ptr>;
-
-    template<typename T>
-    static constexpr bool is_std_optional_v = is_specialization_v<T, std::optional>;
-
-    template<typename T>
-    static constexpr bool is_std_variant_v = is_specialization_v<T, std::variant>;
+    };
 
-    template<typename T>
-    static constexpr bool is_std_map_v = 
-        is_specialization_v<T, std::map> ||
-        is_specialization_v<T, std::multimap>;
+    using write_void_result_type = expected<void, write_error_code>;
 
-    template<typename T>
-    static constexpr bool is_nullable_v =
-        is_std_unique_ptr_v<T> ||
-        is_std_shared_ptr_v<T> ||
-        is_std_optional_v<T>;
+    template<typename T, output_sink TOutputSink>
+    [[nodiscard]] auto write(const T& value, TOutputSink& output_sink) -> write_void_result_type;
 
-    template<typename T>
-    struct value_size_trait {
-        static constexpr size_t size = sizeof(T);
-    };
+    template<typename TOptions, typename T, output_sink TOutputSink>
+    [[nodiscard]] auto write(const T& value, TOutputSink& output_sink) -> write_void_result_type;
 
-    template<typename T, size_t Vsize>
-    struct value_size_trait<std::array<T, Vsize>> {
-        static constexpr size_t size = sizeof(T) * Vsize;
-    };
+#if !defined(BLOPP_NO_FILESYSTEM)
 
-    template<typename T, size_t Vsize>
-    struct value_size_trait<T[Vsize]> {
-        static constexpr size_t size = sizeof(T) * Vsize;
-    };
+    /*
+    * Output sink writing to a std::ostream in chunks of at most chunk_size bytes.
+    * Offsets of already flushed chunks are patched by seeking back in the stream.
+    * Streams not supporting seeking are buffered in memory until flush is called.
+    * flush must be called after writing, to write the last chunk to the stream.
+    * Chunks are written as they fill up, so a failed write leaves the chunks written before the failure in the stream.
+    */
+    class stream_output_sink {
 
-    struct dummy_read_write_context {
-        static constexpr auto direction = context_direction::write;
-        auto map(auto& ...) { return true; }
+    public:
 
-        template<typename Tas, typename T>
-        auto map_as(T&) { }
-    };
+        static constexpr size_t default_chunk_size = 64 * 1024;
 
-    template<typename T>
-    [[nodiscard]] constexpr auto object_is_mapped() -> bool {
-        return
-            std::is_class_v<T> == true &&
-            requires(T & value, dummy_read_write_context dummy) { { blopp::object<T>::map(dummy, value) }; };
-    }
+        explicit stream_output_sink(std::ostream& stream, const size_t chunk_size = default_chunk_size) :
+            m_stream{ stream },
+            m_stream_start{ get_stream_start(stream) },
+            m_chunk_size{ std::max(chunk_size, size_t{ 1 }) }
+        {
+            m_buffer.reserve(m_stream_start != std::ostream::pos_type(-1) ? m_chunk_size : 0);
+        }
 
-    struct dummy_format_read_write_context {
-        static constexpr auto direction = context_direction::write;
-        auto format(auto& ...) { return true; }
-    };
+        stream_output_sink(const stream_output_sink&) = delete;
+        stream_output_sink(stream_output_sink&&) = delete;
+        stream_output_sink& operator = (const stream_output_sink&) = delete;
+        stream_output_sink& operator = (stream_output_sink&&) = delete;
 
-    template<typename T>
-    [[nodiscard]] constexpr auto object_is_formatted() -> bool {
-        return
-            std::is_class_v<T> == true &&
-            requires(T & value, dummy_format_read_write_context dummy) { { blopp::object<T>::format(dummy, value) }; };
-    }
+        [[nodiscard]] inline size_t position() const {
+            return m_flushed_size + m_buffer.size();
+        }
 
-    template<typename Tfrom, typename Tto>
-    constexpr auto conversion_overflows(const Tfrom from) -> bool {
-        if constexpr (std::is_signed_v<Tfrom> == false && std::is_signed_v<Tto> == false) {
-            return 
-                static_cast<uint64_t>(from) > static_cast<uint64_t>(std::numeric_limits<Tto>::max());
+        inline void append(const uint8_t value) {
+            m_buffer.push_back(value);
+            flush_full_chunk();
         }
-        else if constexpr (std::is_signed_v<Tfrom> == true && std::is_signed_v<Tto> == true) {
-            if constexpr (std::is_floating_point_v< Tto> == true) {
-                return false;
-            }
-            else {
-                return
-                    static_cast<int64_t>(from) > static_cast<int64_t>(std::numeric_limits<Tto>::max()) ||
-                    static_cast<int64_t>(from) < static_cast<int64_t>(std::numeric_limits<Tto>::min());
-            }
 
-            
+        inline void append(const uint8_t* data, size_t size) {
+            while (size > 0) {
+                const auto chunk_left = m_buffer.size() < m_chunk_size ? m_chunk_size - m_buffer.size() : size;
+                const auto append_size = std::min(size, chunk_left);
+                m_buffer.insert(m_buffer.end(), data, data + append_size);
+                data += append_size;
+                size -= append_size;
+                flush_full_chunk();
+            }
         }
-        else if constexpr (std::is_signed_v<Tfrom> == true && std::is_signed_v<Tto> == false) {
-            return 
-                from < Tfrom{} ||
-                static_cast<uint64_t>(from) > static_cast<uint64_t>(std::numeric_limits<Tto>::max());
+
+        [[nodiscard]] inline size_t reserve(size_t size) {
+            const auto position = this->position();
+            while (size > 0) {
+                const auto chunk_left = m_buffer.size() < m_chunk_size ? m_chunk_size - m_buffer.size() : size;
+                const auto reserve_size = std::min(size, chunk_left);
+                m_buffer.resize(m_buffer.size() + reserve_size);
+                size -= reserve_size;
+                flush_full_chunk();
+            }
+            return position;
         }
-        else if constexpr (std::is_signed_v<Tfrom> == false && std::is_signed_v<Tto> == true) {
-            if constexpr (std::is_floating_point_v< Tto> == true) {
-                return false;
+
+        inline void patch(const size_t position, const uint8_t* data, const size_t size) {
+            auto patch_position = position;
+            auto patch_data = data;
+            auto patch_size = size;
+
+            if (patch_position < m_flushed_size) {
+                const auto flushed_patch_size = std::min(patch_size, m_flushed_size - patch_position);
+
+                m_stream.seekp(m_stream_start + static_cast<std::streamoff>(patch_position));
+                m_stream.write(reinterpret_cast<const char*>(patch_data), static_cast<std::streamsize>(flushed_patch_size));
+                m_stream.seekp(m_stream_start + static_cast<std::streamoff>(m_flushed_size));
+
+                patch_position += flushed_patch_size;
+                patch_data += flushed_patch_size;
+                patch_size -= flushed_patch_size;
             }
-            else {
-                return 
-                    static_cast<uint64_t>(from) > static_cast<uint64_t>(std::numeric_limits<Tto>::max());
+
+            if (patch_size > 0) {
+                std::memcpy(m_buffer.data() + (patch_position - m_flushed_size), patch_data, patch_size);
             }
         }
-        else {
-            static_assert(always_false<Tfrom>, "Missing conversion_overflows case.");
-        }
-    }
 
-    template<typename T>
-    [[nodiscard]] constexpr data_types get_data_type() {
-        using value_fundamental_traits = fundamental_traits<T>;
-        if constexpr (value_fundamental_traits::is_fundamental == true) {
-            return value_fundamental_traits::data_type;
-        }
-        else if constexpr (std::is_enum_v<T> == true) {
-            using underlying_t = std::underlying_type_t<T>;
-            using underlying_fundamental_traits = fundamental_traits<underlying_t>;
-            return underlying_fundamental_traits::data_type;
-        }
-        else if constexpr (is_std_string_v<T> == true) {
-            return data_types::string;
-        }
-        else if constexpr (
-            is_std_unique_ptr_v<T> == true ||
-            is_std_shared_ptr_v<T> == true)
-        {
-            using element_t = typename T::element_type;
-            return get_data_type<element_t>();
-        }
-        else if constexpr (is_std_optional_v<T> == true) {
-            using element_t = typename T::value_type;
-            return get_data_type<element_t>();
-        }
-        else if constexpr (
-            is_std_array_v<T> == true ||
-            is_std_vector_v<T> == true ||
-            is_std_list_v<T> == true ||
-            std::is_array_v<T> == true)
-        {
-            return data_types::list;
+        inline void flush() {
+            m_stream.write(reinterpret_cast<const char*>(m_buffer.data()), static_cast<std::streamsize>(m_buffer.size()));
+            m_flushed_size += m_buffer.size();
+            m_buffer.clear();
         }
-        else if constexpr (is_std_map_v<T> == true) {
-            return data_types::map;
-        }
-        else if constexpr (is_std_variant_v<T> == true) {
-            return data_types::variant;
-        }
-        else if constexpr (std::is_class_v<T> == true && object_is_mapped<T>() == true) {
-            return data_types::object;
-        }
-        else if constexpr (std::is_class_v<T> == true && object_is_formatted<T>() == true) {
-            return data_types::unspecified;
-        }
-        else {
-            static_assert(always_false<T>, "Unmapped blopp data type.");
-        }
-    }
 
-    template<typename TValue>
-    [[nodiscard]] inline bool nullable_has_value([[maybe_unused]] const TValue& value) {
-        if constexpr (
-            is_std_unique_ptr_v<TValue> == true ||
-            is_std_shared_ptr_v<TValue> == true)
-        {
-            return value != nullptr;
-        }
-        else if constexpr (is_std_optional_v<TValue> == true) {
-            return value.has_value();
-        }
-        else {
-            static_assert(always_false<TValue>, "Unmapped blopp nullable value.");
+        [[nodiscard]] inline auto error() const -> std::optional<write_error_code> {
+            if (!m_stream) {
+                return write_error_code::cannot_write_stream;
+            }
+            return {};
         }
-    }
 
-    template<typename T>
-    inline void clear_nullable_value(T& value) {
-        value.reset();
-    }
+    private:
 
-    template<typename TContainer>
-    inline void clear_container([[maybe_unused]] TContainer& container) {
-        using container_t = std::remove_cvref_t<decltype(container)>;
-        if constexpr (
-            is_std_vector_v<container_t> == true ||
-            is_std_list_v<container_t> == true ||
-            is_std_map_v<container_t> == true)
-        {
-            container.clear();
-        }
-    }
-    template<typename TContainer>
-    inline void resize_add_container([[maybe_unused]] TContainer& container, [[maybe_unused]] size_t size) {
-        using container_t = std::remove_cvref_t<decltype(container)>;
-        if constexpr (is_std_vector_v<container_t> == true) {
-            container.resize(container.size() + size);
+        [[nodiscard]] static std::ostream::pos_type get_stream_start(std::ostream& stream) {
+            const auto state = stream.rdstate();
+            const auto position = stream.tellp();
+            stream.clear(state);
+            return position;
         }
-    }
 
-    template<typename TContainer>
-    inline auto& emplace_container(TContainer& container, [[maybe_unused]] const size_t index) {
-        using container_t = std::remove_cvref_t<decltype(container)>;
-        if constexpr (is_std_array_v<container_t> == true) {
-            return container.at(index);
-        }
-        else {
-            return container.emplace_back();
+        inline void flush_full_chunk() {
+            if (m_buffer.size() >= m_chunk_size && m_stream_start != std::ostream::pos_type(-1)) {
+                flush();
+            }
         }
-    }
 
+        std::ostream& m_stream;
+        std::ostream::pos_type m_stream_start;
+        size_t m_chunk_size;
+        size_t m_flushed_size = 0;
+        std::vector<uint8_t> m_buffer = {};
 
-    template<typename T>
-    class post_output_writer
-    {
+    };
 
-    public:
+    template<typename T>
+    [[nodiscard]] auto write(
+        const T& value,
+        std::ostream& stream,
+        size_t chunk_size = stream_output_sink::default_chunk_size) -> write_void_result_type;
 
-        post_output_writer(write_output_type& output) :
-            m_output{ output },
-            m_position{ m_output.size() }
-        {
-            auto default_value = T{};
-            const auto* value_ptr = reinterpret_cast<const uint8_t*>(&default_value);
-            std::copy(value_ptr, value_ptr + sizeof(T), std::back_inserter(m_output));
-        }
+    template<typename TOptions, typename T>
+    [[nodiscard]] auto write(
+        const T& value,
+        std::ostream& stream,
+        size_t chunk_size = stream_output_sink::default_chunk_size) -> write_void_result_type;
 
-        post_output_writer(const post_output_writer&) = delete;
-        post_output_writer(post_output_writer&&) = delete;
-        post_output_writer& operator = (const post_output_writer&) = delete;
-        post_output_writer& operator = (post_output_writer&&) = delete;
+    template<typename T>
+    [[nodiscard]] auto write(const T& value, const std::filesystem::path& path) -> write_void_result_type;
 
-        void update(const T value) {
-            std::memcpy(m_output.data() + m_position, &value, sizeof(T));
-        }
+    template<typename TOptions, typename T>
+    [[nodiscard]] auto write(const T& value, const std::filesystem::path& path) -> write_void_result_type;
 
-    private:
+#endif
 
-        write_output_type& m_output;
-        size_t m_position;
+    enum class encode_status : uint8_t {
+        suspended,
+        complete
+    };
 
+    struct encode_result {
+        encode_status status;
+        size_t written_size;
     };
 
-    class write_context_base {
+    using encode_result_type = expected<encode_result, write_error_code>;
 
-    protected:
+    /*
+    * Resumable writer, filling one fixed size output window at a time.
+    * Offsets, sizes and shared_ptr references are computed in a pre-pass at the first call, so each window is written in its final form.
+    * Blocks outside of the current window are skipped by their planned size, and lists and maps are resumed 
+    * at the last planned element before the window, so each call writes in time of its window rather than of the value.
+    * The value must outlive the encoder and stay unchanged until it's complete, so temporaries cannot be encoded.
+    */
+    template<typename T, typename TOptions = default_options>
+    class encoder {
 
-        explicit write_context_base(write_output_type& output) :
-            m_output{ output }
+    public:
+
+        explicit encoder(const T& value) :
+            m_value{ value }
         {}
 
-        template<bool Vis_nullable>
-        inline void write_data_type(data_types data_type) {
-            auto value = static_cast<uint8_t>(data_type);
-            if constexpr (Vis_nullable == true) {
-                value = static_cast<uint8_t>(value | 0b10000000);
-            }
-            m_output.push_back(value);
-        }
+        explicit encoder(const T&&) = delete;
 
-        template<typename TValue>
-        inline void write_value(const TValue& value) {
-            const auto* value_ptr = reinterpret_cast<const uint8_t*>(&value);
-            std::copy(value_ptr, value_ptr + sizeof(value), std::back_inserter(m_output));
-        }
+        // Writes the next bytes to output, suspending when output is full.
+        [[nodiscard]] auto write(write_to_output_type output) -> encode_result_type;
 
-        template<typename TContainer>
-        inline void write_contiguous_container(const TContainer& container) {
-            using element_t = typename TContainer::value_type;
-            const auto container_ptr = reinterpret_cast<const uint8_t*>(container.data());
-            const auto container_byte_count = sizeof(element_t) * container.size();
-            std::copy(container_ptr, container_ptr + container_byte_count, std::back_inserter(m_output));
+        [[nodiscard]] encode_status status() const {
+            return m_is_planned && m_position == m_size ? encode_status::complete : encode_status::suspended;
         }
 
-        write_output_type& m_output;
+    private:
 
-    };
+        struct planned_reservation {
+            uint64_t value = 0;
+            size_t end_index = 0;
+        };
 
-    template<typename TOptions>
-    class write_format_context : private write_context_base {
+        // Writer state at the start of an element of a list or map, resumed by windows starting after it.
+        struct planned_element {
+            size_t sequence = 0; // Reservation index at the start of the elements.
+            size_t index = 0;
+            size_t position = 0;
+            size_t reservation_index = 0;
+            size_t varint_index = 0;
+            std::any iterator = {}; // Iterator of containers without random access.
+        };
 
-    private:
+        struct write_plan {
+            std::vector<planned_reservation> reservations = {};
+            std::vector<std::pair<uint64_t, uint64_t>> references = {}; // Address and position of shared values, by address.
+            std::vector<planned_element> elements = {}; // By sequence and position.
+        };
 
-        using options = TOptions;
-        using options_format_size_type = typename options::format_size_type;
-        static constexpr auto max_format_size = static_cast<size_t>(std::numeric_limits<options_format_size_type>::max());
+        const T& m_value;
+        write_plan m_plan = {};
+        std::vector<std::pair<uint64_t, size_t>> m_varint_plan = {};
+        std::optional<write_error_code> m_error = {};
+        size_t m_position = 0;
+        size_t m_size = 0;
+        bool m_is_planned = false;
 
-    public:      
+    };
 
-        static constexpr auto direction = context_direction::write;
-        
-        explicit write_format_context(
-            write_output_type& output
-        ) :
-            write_context_base{ output }
-        {}
+    using read_input_type = std::span<const uint8_t>;
 
-        write_format_context(const write_format_context&) = delete;
-        write_format_context(write_format_context&&) = delete;
-        write_format_context& operator = (const write_format_context&) = delete;
+    // Deletes values allocated from a memory resource, used by unique pointers read with a memory resource.
+    template<typename T>
+    struct pmr_deleter
+    {
+        std::pmr::memory_resource* memory_resource = std::pmr::get_default_resource();
+
+        void operator () (T* pointer) const {
+            std::pmr::polymorphic_allocator<>{ memory_resource }.delete_object(pointer);
+        }
+    };
+
+    template<typename T>
+    using pmr_unique_ptr = std::unique_ptr<T, pmr_deleter<T>>;
+
+    template<typename T>
+    struct read_result
+    {
+        using value_type = T;
+
+        T value = {};
+        read_input_type remaining = {};
+    };
+
+    template<typename T>
+    using read_result_type = expected<read_result<T>, read_error_code>;
+
+    template<typename T>
+    [[nodiscard]] auto read(read_input_type input) -> read_result_type<T>;
+
+    template<typename TOptions, typename T>
+    [[nodiscard]] auto read(read_input_type input) -> read_result_type<T>;
+
+    // Allocates std::pmr strings and containers, shared pointers and blopp::pmr_unique_ptr values from memory_resource.
+    template<typename T>
+    [[nodiscard]] auto read(read_input_type input, std::pmr::memory_resource* memory_resource) -> read_result_type<T>;
+
+    template<typename TOptions, typename T>
+    [[nodiscard]] auto read(read_input_type input, std::pmr::memory_resource* memory_resource) -> read_result_type<T>;
+
+    // Remaining input after the value read by read_into.
+    using read_into_result_type = expected<read_input_type, read_error_code>;
+
+    // Remaining input after the value validated by verify.
+    using verify_result_type = expected<read_input_type, read_error_code>;
+
+    // Validates structure, offsets, counts and types of input as T, without keeping any of the values read.
+    template<typename T>
+    [[nodiscard]] auto verify(read_input_type input) -> verify_result_type;
+
+    template<typename TOptions, typename T>
+    [[nodiscard]] auto verify(read_input_type input) -> verify_result_type;
+
+    // Reads into an existing value, reusing allocations of its strings, containers and unique pointers.
+    template<typename T>
+    [[nodiscard]] auto read_into(read_input_type input, T& value) -> read_into_result_type;
+
+    template<typename TOptions, typename T>
+    [[nodiscard]] auto read_into(read_input_type input, T& value) -> read_into_result_type;
+
+    // Input made of several buffers, such as a chain of network buffers, read without first being copied into one.
+    using read_segmented_input_type = std::span<const read_input_type>;
+
+    template<typename T>
+    struct segmented_read_result
+    {
+        using value_type = T;
+
+        T value = {};
+        size_t read_size = 0;
+    };
+
+    template<typename T>
+    using segmented_read_result_type = expected<segmented_read_result<T>, read_error_code>;
+
+    template<typename T>
+    [[nodiscard]] auto read(read_segmented_input_type input) -> segmented_read_result_type<T>;
+
+    template<typename TOptions, typename T>
+    [[nodiscard]] auto read(read_segmented_input_type input) -> segmented_read_result_type<T>;
+
+#if !defined(BLOPP_NO_FILESYSTEM)
+
+    template<typename T>
+    [[nodiscard]] auto read(std::istream& stream) -> read_result_type<T>;
+
+    template<typename TOptions, typename T>
+    [[nodiscard]] auto read(std::istream& stream) -> read_result_type<T>;
+
+    template<typename T>
+    [[nodiscard]] auto read(const std::filesystem::path& path) -> read_result_type<T>;
+
+    template<typename TOptions, typename T>
+    [[nodiscard]] auto read(const std::filesystem::path& path) -> read_result_type<T>;
+
+#endif
+
+    enum class decode_status : uint8_t {
+        need_more_data,
+        complete
+    };
+
+    struct decode_result {
+        decode_status status;
+        size_t consumed_size;
+    };
+
+    using decode_result_type = expected<decode_result, read_error_code>;
+
+    /*
+    * Push-style decoder of a single message, accepting input in chunks as they arrive.
+    * The message size is found from its headers as soon as they have arrived, and the message is read once when complete.
+    * Bytes after the end of the message are not consumed. A message arriving in one chunk is read without being copied.
+    * Messages with headers claiming a size larger than max_message_size fail, before any of it is buffered.
+    */
+    template<typename T, typename TOptions = default_options>
+    class decoder {
+
+    public:
+
+        static constexpr size_t default_max_message_size = 64 * 1024 * 1024;
+
+        explicit decoder(const size_t max_message_size = default_max_message_size) :
+            m_max_message_size{ max_message_size }
+        {}
+
+        [[nodiscard]] auto push(read_input_type input) -> decode_result_type;
+
+        [[nodiscard]] decode_status status() const {
+            return m_stage == scan_stage::complete ? decode_status::complete : decode_status::need_more_data;
+        }
+
+        [[nodiscard]] T& value() {
+            return m_value;
+        }
+
+        [[nodiscard]] const T& value() const {
+            return m_value;
+        }
+
+        // Prepares for decoding the next message, keeping the capacity of the internal buffer.
+        void reset() {
+            m_buffer.clear();
+            m_value = T{};
+            m_error = {};
+            m_stage = scan_stage::data_type;
+            m_scan_position = 0;
+            m_required_size = 1;
+            m_message_size = 0;
+            m_data_type = 0;
+        }
+
+    private:
+
+        enum class scan_stage : uint8_t {
+            data_type,
+            nullable_value_flags,
+            payload,
+            message,
+            complete
+        };
+
+        [[nodiscard]] auto scan(read_input_type input) -> std::optional<read_error_code>;
+
+        template<typename TSize>
+        [[nodiscard]] auto scan_block_size(read_input_type input) -> std::optional<read_error_code>;
+
+        // Scans a value of binary format type TValue at the scan position, setting value once it has arrived.
+        template<typename TValue>
+        [[nodiscard]] auto scan_format_value(read_input_type input, std::optional<size_t>& value) -> std::optional<read_error_code>;
+
+        [[nodiscard]] auto read_message(read_input_type input) -> decode_result_type;
+
+        std::vector<uint8_t> m_buffer = {};
+        T m_value = {};
+        std::optional<read_error_code> m_error = {};
+        scan_stage m_stage = scan_stage::data_type;
+        size_t m_scan_position = 0;
+        size_t m_required_size = 1;
+        size_t m_message_size = 0;
+        size_t m_max_message_size = default_max_message_size;
+        uint8_t m_data_type = 0;
+
+    };
+
+    template<typename TOptions = default_options>
+    class view;
+
+    template<typename TOptions = default_options>
+    class object_view;
+
+    template<typename TOptions = default_options>
+    class list_view;
+
+    template<typename TOptions = default_options>
+    class map_view;
+
+    template<typename TOptions>
+    using view_result_type = expected<view<TOptions>, read_error_code>;
+
+    template<typename TOptions>
+    using object_view_result_type = expected<object_view<TOptions>, read_error_code>;
+
+    template<typename TOptions>
+    using list_view_result_type = expected<list_view<TOptions>, read_error_code>;
+
+    template<typename TOptions>
+    using map_view_result_type = expected<map_view<TOptions>, read_error_code>;
+
+    template<typename TOptions = default_options>
+    [[nodiscard]] auto make_view(read_input_type input) -> view_result_type<TOptions>;
+
+    /*
+    * Lazy view of a serialized value, pointing into the input buffer which must outlive the view.
+    * Nothing is decoded until a leaf is requested via as<T>, and block offsets are used to jump over data not visited.
+    */
+    template<typename TOptions>
+    class view {
+
+    public:
+
+        view() = default;
+
+        [[nodiscard]] bool has_value() const {
+            return m_has_value;
+        }
+
+        template<typename T>
+        [[nodiscard]] auto as() const -> expected<T, read_error_code>;
+
+        [[nodiscard]] auto as_object() const -> object_view_result_type<TOptions>;
+
+        [[nodiscard]] auto as_list() const -> list_view_result_type<TOptions>;
+
+        [[nodiscard]] auto as_map() const -> map_view_result_type<TOptions>;
+
+    private:
+
+        template<typename TViewOptions>
+        friend auto make_view(read_input_type input) -> view_result_type<TViewOptions>;
+
+        friend class object_view<TOptions>;
+        friend class list_view<TOptions>;
+        friend class map_view<TOptions>;
+
+        [[nodiscard]] static auto read_value(read_input_type root, read_input_type input) -> view_result_type<TOptions>;
+
+        [[nodiscard]] static auto read_element(
+            read_input_type root,
+            read_input_type input,
+            uint8_t data_type,
+            bool is_nullable) -> view_result_type<TOptions>;
+
+        template<typename T>
+        [[nodiscard]] auto read_payload(T& value) const -> std::optional<read_error_code>;
+
+        read_input_type m_root = {};
+        read_input_type m_input = {};
+        uint8_t m_data_type = 0;
+        bool m_is_nullable = false;
+        bool m_has_value = false;
+
+    };
+
+    /*
+    * View of an object's properties, in the order they are mapped.
+    */
+    template<typename TOptions>
+    class object_view {
+
+    public:
+
+        object_view() = default;
+
+        [[nodiscard]] size_t size() const {
+            return m_property_count;
+        }
+
+        [[nodiscard]] auto at(size_t index) const -> view_result_type<TOptions>;
+
+    private:
+
+        friend class view<TOptions>;
+
+        read_input_type m_root = {};
+        read_input_type m_properties = {};
+        size_t m_property_count = 0;
+
+    };
+
+    /*
+    * View of list elements. Elements of fixed size types, and of lists written with an element index, are located directly. 
+    * Other elements are skipped over.
+    */
+    template<typename TOptions>
+    class list_view {
+
+    public:
+
+        list_view() = default;
+
+        [[nodiscard]] size_t size() const {
+            return m_element_count;
+        }
+
+        [[nodiscard]] auto at(size_t index) const -> view_result_type<TOptions>;
+
+    private:
+
+        friend class view<TOptions>;
+
+        read_input_type m_root = {};
+        read_input_type m_elements = {};
+        read_input_type m_element_index = {};
+        size_t m_element_count = 0;
+        uint8_t m_element_data_type = 0;
+        bool m_element_is_nullable = false;
+
+    };
+
+    /*
+    * View of map elements, in serialized order.
+    * find(key) decodes keys only, so pass std::string_view to look up string keys without allocating.
+    */
+    template<typename TOptions>
+    class map_view {
+
+    public:
+
+        map_view() = default;
+
+        [[nodiscard]] size_t size() const {
+            return m_element_count;
+        }
+
+        [[nodiscard]] auto key(size_t index) const -> view_result_type<TOptions>;
+
+        [[nodiscard]] auto value(size_t index) const -> view_result_type<TOptions>;
+
+        template<typename TKey>
+        [[nodiscard]] auto find(const TKey& key) const -> view_result_type<TOptions>;
+
+    private:
+
+        friend class view<TOptions>;
+
+        [[nodiscard]] auto element(size_t index, bool mapped) const -> view_result_type<TOptions>;
+
+        read_input_type m_root = {};
+        read_input_type m_elements = {};
+        size_t m_element_count = 0;
+        uint8_t m_key_data_type = 0;
+        bool m_key_is_nullable = false;
+        uint8_t m_mapped_data_type = 0;
+        bool m_mapped_is_nullable = false;
+
+    };
+
+#if defined(BLOPP_HAS_MEMORY_MAPPING)
+
+    enum class mapped_file_advice : uint8_t {
+        normal,
+        sequential,
+        random,
+        will_need
+    };
+
+    /*
+    * Read-only memory mapping of a file, unmapped at destruction.
+    * Pages are faulted in by the OS when first accessed, so bytes never touched are never read from disk.
+    */
+    class mapped_file {
+
+    public:
+
+        using open_result_type = expected<mapped_file, read_error_code>;
+
+        mapped_file() = default;
+
+        ~mapped_file() {
+            unmap();
+        }
+
+        mapped_file(const mapped_file&) = delete;
+        mapped_file& operator = (const mapped_file&) = delete;
+
+        mapped_file(mapped_file&& other) noexcept :
+            m_data{ std::exchange(other.m_data, nullptr) },
+            m_size{ std::exchange(other.m_size, 0) }
+        {}
+
+        mapped_file& operator = (mapped_file&& other) noexcept {
+            if (this != &other) {
+                unmap();
+                m_data = std::exchange(other.m_data, nullptr);
+                m_size = std::exchange(other.m_size, 0);
+            }
+            return *this;
+        }
+
+        [[nodiscard]] static auto open(
+            const std::filesystem::path& path,
+            const mapped_file_advice advice = mapped_file_advice::sequential) -> open_result_type
+        {
+            const auto file_descriptor = ::open(path.c_str(), O_RDONLY);
+            if (file_descriptor == -1) {
+                return make_unexpected<mapped_file, read_error_code>(read_error_code::cannot_open_file);
+            }
+
+            struct stat file_stat = {};
+            if (::fstat(file_descriptor, &file_stat) == -1) {
+                ::close(file_descriptor);
+                return make_unexpected<mapped_file, read_error_code>(read_error_code::cannot_open_file);
+            }
+
+            // Only regular files are mapped, as the size of others, such as pipes, isn't known before reading them.
+            auto result = mapped_file{};
+            result.m_size = S_ISREG(file_stat.st_mode) ? static_cast<size_t>(file_stat.st_size) : 0;
+
+            if (result.m_size > 0) {
+                auto* data = ::mmap(nullptr, result.m_size, PROT_READ, MAP_PRIVATE, file_descriptor, 0);
+                if (data == MAP_FAILED) {
+                    ::close(file_descriptor);
+                    return make_unexpected<mapped_file, read_error_code>(read_error_code::cannot_open_file);
+                }
+                result.m_data = data;
+            }
+
+            ::close(file_descriptor);
+
+            result.advise(advice);
+            return result;
+        }
+
+        [[nodiscard]] inline read_input_type data() const {
+            return read_input_type{ static_cast<const uint8_t*>(m_data), m_size };
+        }
+
+        [[nodiscard]] inline size_t size() const {
+            return m_size;
+        }
+
+        inline bool advise(const mapped_file_advice advice) {
+            if (m_data == nullptr) {
+                return true;
+            }
+
+            return ::madvise(m_data, m_size, get_madvise_advice(advice)) == 0;
+        }
+
+    private:
+
+        [[nodiscard]] static int get_madvise_advice(const mapped_file_advice advice) {
+            switch (advice) {
+                case mapped_file_advice::normal: return MADV_NORMAL;
+                case mapped_file_advice::sequential: return MADV_SEQUENTIAL;
+                case mapped_file_advice::random: return MADV_RANDOM;
+                case mapped_file_advice::will_need: return MADV_WILLNEED;
+            }
+            return MADV_NORMAL;
+        }
+
+        inline void unmap() {
+            if (m_data != nullptr) {
+                ::munmap(m_data, m_size);
+                m_data = nullptr;
+                m_size = 0;
+            }
+        }
+
+        void* m_data = nullptr;
+        size_t m_size = 0;
+
+    };
+
+    /*
+    * Output sink writing straight into a memory mapped file.
+    * The mapping starts at initial_capacity bytes and doubles when full, while the file only grows by the blocks 
+    * the writes need, ahead by at most max_allocation_step bytes. The file is truncated to the written size by finish.
+    */
+    class mapped_file_output_sink {
+
+    public:
+
+        using open_result_type = expected<mapped_file_output_sink, write_error_code>;
+
+        static constexpr size_t page_size = 4096;
+        static constexpr size_t default_initial_capacity = page_size;
+        static constexpr size_t max_allocation_step = 1024 * 1024;
+
+        ~mapped_file_output_sink() {
+            finish();
+        }
+
+        mapped_file_output_sink(const mapped_file_output_sink&) = delete;
+        mapped_file_output_sink& operator = (const mapped_file_output_sink&) = delete;
+
+        mapped_file_output_sink(mapped_file_output_sink&& other) noexcept :
+            m_file_descriptor{ std::exchange(other.m_file_descriptor, -1) },
+            m_data{ std::exchange(other.m_data, nullptr) },
+            m_mapped_size{ std::exchange(other.m_mapped_size, 0) },
+            m_capacity{ std::exchange(other.m_capacity, 0) },
+            m_position{ std::exchange(other.m_position, 0) },
+            m_failed{ std::exchange(other.m_failed, false) }
+        {}
+
+        mapped_file_output_sink& operator = (mapped_file_output_sink&& other) noexcept {
+            if (this != &other) {
+                finish();
+                m_file_descriptor = std::exchange(other.m_file_descriptor, -1);
+                m_data = std::exchange(other.m_data, nullptr);
+                m_mapped_size = std::exchange(other.m_mapped_size, 0);
+                m_capacity = std::exchange(other.m_capacity, 0);
+                m_position = std::exchange(other.m_position, 0);
+                m_failed = std::exchange(other.m_failed, false);
+            }
+            return *this;
+        }
+
+        [[nodiscard]] static auto open(
+            const std::filesystem::path& path,
+            const size_t initial_capacity = default_initial_capacity) -> open_result_type
+        {
+            const auto file_descriptor = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+            if (file_descriptor == -1) {
+                return make_unexpected<mapped_file_output_sink, write_error_code>(write_error_code::cannot_open_file);
+            }
+
+            auto result = mapped_file_output_sink{ file_descriptor };
+            if (!result.map(round_up_to_page_size(std::max(initial_capacity, size_t{ 1 })))) {
+                return make_unexpected<mapped_file_output_sink, write_error_code>(write_error_code::cannot_open_file);
+            }
+
+            return result;
+        }
+
+        [[nodiscard]] inline size_t position() const {
+            return m_position;
+        }
+
+        inline void append(const uint8_t value) {
+            if (m_position < m_capacity || grow(1)) {
+                static_cast<uint8_t*>(m_data)[m_position] = value;
+            }
+            ++m_position;
+        }
+
+        inline void append(const uint8_t* data, const size_t size) {
+            if (m_capacity - std::min(m_position, m_capacity) >= size || grow(size)) {
+                std::memcpy(static_cast<uint8_t*>(m_data) + m_position, data, size);
+            }
+            m_position += size;
+        }
+
+        [[nodiscard]] inline size_t reserve(const size_t size) {
+            const auto position = m_position;
+            if (m_capacity - std::min(m_position, m_capacity) >= size || grow(size)) {
+                std::memset(static_cast<uint8_t*>(m_data) + m_position, 0, size);
+            }
+            m_position += size;
+            return position;
+        }
+
+        inline void patch(const size_t position, const uint8_t* data, const size_t size) {
+            if (!m_failed) {
+                std::memcpy(static_cast<uint8_t*>(m_data) + position, data, size);
+            }
+        }
+
+        [[nodiscard]] inline auto error() const -> std::optional<write_error_code> {
+            if (m_failed) {
+                return write_error_code::cannot_write_file;
+            }
+            return {};
+        }
+
+        // Unmaps and truncates the file to the written size. Called at destruction if not called before.
+        inline bool finish() {
+            return close(m_position);
+        }
+
+        // Unmaps and truncates the file to zero bytes.
+        inline bool discard() {
+            return close(0);
+        }
+
+    private:
+
+        explicit mapped_file_output_sink(const int file_descriptor) :
+            m_file_descriptor{ file_descriptor }
+        {}
+
+        [[nodiscard]] static size_t round_up_to_page_size(const size_t size) {
+            return (size + page_size - 1) / page_size * page_size;
+        }
+
+        [[nodiscard]] bool grow(const size_t size) {
+            if (m_failed) {
+                return false;
+            }
+
+            const auto required_capacity = round_up_to_page_size(m_position + size);
+
+            // The mapping doubles, so it is remapped a logarithmic number of times as the file grows.
+            if (required_capacity > m_mapped_size && !map(std::max(required_capacity, m_mapped_size * 2))) {
+                return false;
+            }
+
+            // Blocks are allocated a step ahead, doubling up to max_allocation_step, so small writes reserve little disk space.
+            const auto step_capacity = m_capacity + std::clamp(m_capacity, page_size, max_allocation_step);
+            const auto new_capacity = std::max(required_capacity, std::min(step_capacity, m_mapped_size));
+
+            if (!allocate(m_capacity, new_capacity)) {
+                m_failed = true;
+                return false;
+            }
+
+            m_capacity = new_capacity;
+            return true;
+        }
+
+        // Maps mapped_size bytes of the file, of which only the first m_capacity bytes are allocated and written.
+        [[nodiscard]] bool map(const size_t mapped_size) {
+            if (m_data != nullptr) {
+                ::munmap(m_data, m_mapped_size);
+                m_data = nullptr;
+                m_mapped_size = 0;
+            }
+
+            auto* data = ::mmap(nullptr, mapped_size, PROT_READ | PROT_WRITE, MAP_SHARED, m_file_descriptor, 0);
+            if (data == MAP_FAILED) {
+                m_failed = true;
+                return false;
+            }
+
+            m_data = data;
+            m_mapped_size = mapped_size;
+            return true;
+        }
+
+        // Grows the file with its blocks allocated, so a full disk fails here instead of raising SIGBUS when writing the mapping.
+        [[nodiscard]] bool allocate(const size_t old_capacity, const size_t new_capacity) {
+#if defined(__APPLE__)
+            auto store = fstore_t{ F_ALLOCATEALL, F_PEOFPOSMODE, 0, static_cast<off_t>(new_capacity - old_capacity), 0 };
+            if (::fcntl(m_file_descriptor, F_PREALLOCATE, &store) == -1) {
+                return false;
+            }
+
+            return ::ftruncate(m_file_descriptor, static_cast<off_t>(new_capacity)) == 0;
+#else
+            return ::posix_fallocate(
+                m_file_descriptor,
+                static_cast<off_t>(old_capacity),
+                static_cast<off_t>(new_capacity - old_capacity)) == 0;
+#endif
+        }
+
+        bool close(const size_t size) {
+            if (m_file_descriptor == -1) {
+                return !m_failed;
+            }
+
+            if (m_data != nullptr) {
+                ::munmap(m_data, m_mapped_size);
+                m_data = nullptr;
+                m_mapped_size = 0;
+                m_capacity = 0;
+            }
+
+            if (::ftruncate(m_file_descriptor, static_cast<off_t>(size)) == -1) {
+                m_failed = true;
+            }
+
+            ::close(m_file_descriptor);
+            m_file_descriptor = -1;
+            return !m_failed;
+        }
+
+        int m_file_descriptor = -1;
+        void* m_data = nullptr;
+        size_t m_mapped_size = 0;
+        size_t m_capacity = 0; // Allocated bytes of the file.
+        size_t m_position = 0;
+        bool m_failed = false;
+
+    };
+
+#endif
+
+    template<typename T>
+    struct object;
+
+    enum class context_direction : uint8_t {
+        read,
+        write
+    };
+
+}
+
+
+// Implementations.
+namespace blopp::impl {
+
+    template<typename T>
+    constexpr bool always_false = false;
+
+    enum class data_types : uint8_t {
+        unspecified = 0,
+        boolean = 1,
+        character = 2,
+        int8 = 3,
+        int16 = 4,
+        int32 = 5,
+        int64 = 6,
+        uint8 = 7,
+        uint16 = 8,
+        uint32 = 9,
+        uint64 = 10,
+        float32 = 11,
+        float64 = 12,
+        string = 13,
+        object = 14,
+        list = 15,
+        map = 16,
+        variant = 17
+    };
+
+    // Set in the element data type of lists followed by an element index.
+    static constexpr auto list_element_index_flag = uint8_t{ 0b01000000 };
+
+    enum class nullable_value_flags : uint8_t {
+        is_null = 0,
+        has_value = 1,
+        is_reference = 2,
+        has_value_and_is_reference = 3
+    };
+
+
+    template<data_types Vdata_type>
+    struct fundamental_traits_base {
+        static constexpr auto is_fundamental = true;
+        static constexpr auto data_type = Vdata_type;
+    };
+
+    template<typename T>
+    struct fundamental_traits {
+        static constexpr auto is_fundamental = false;
+    };
+
+    template<>
+    struct fundamental_traits<bool> : fundamental_traits_base< data_types::boolean> {};
+    template<>
+    struct fundamental_traits<int8_t> : fundamental_traits_base< data_types::int8> {};
+    template<>
+    struct fundamental_traits<int16_t> : fundamental_traits_base< data_types::int16> {};
+    template<>
+    struct fundamental_traits<int32_t> : fundamental_traits_base< data_types::int32> {};
+    template<>
+    struct fundamental_traits<int64_t> : fundamental_traits_base< data_types::int64> {};
+    template<>
+    struct fundamental_traits<uint8_t> : fundamental_traits_base< data_types::uint8> {};
+    template<>
+    struct fundamental_traits<uint16_t> : fundamental_traits_base< data_types::uint16> {};
+    template<>
+    struct fundamental_traits<uint32_t> : fundamental_traits_base< data_types::uint32> {};
+    template<>
+    struct fundamental_traits<uint64_t> : fundamental_traits_base< data_types::uint64> {};
+    template<>
+    struct fundamental_traits<char> : fundamental_traits_base< data_types::character> {};
+    template<>
+    struct fundamental_traits<char8_t> : fundamental_traits_base< data_types::character> {};
+    template<>
+    struct fundamental_traits<float> : fundamental_traits_base< data_types::float32> {};
+    template<>
+    struct fundamental_traits<double> : fundamental_traits_base< data_types::float64> {};
+
+
+    template<typename T, template<typename...> typename TRef>
+    struct is_specialization : std::false_type {};
+
+    template<template<typename...> typename TRef, typename... TArgs>
+    struct is_specialization<TRef<TArgs...>, TRef> : std::true_type {};
+
+    template<typename T, template<typename...> typename TRef>
+    static constexpr bool is_specialization_v = is_specialization<T, TRef>::value;
+
+    template<typename T>
+    struct is_std_array : std::false_type {};
+
+    template<typename T, size_t Vn>
+    struct is_std_array<std::array<T, Vn>> : std::true_type {};
+
+    template<typename T>
+    struct is_std_span : std::false_type {};
+
+    template<typename T, size_t Vextent>
+    struct is_std_span<std::span<T, Vextent>> : std::true_type {};
+
+    template<typename T>
+    static constexpr bool is_std_array_v = is_std_array<T>::value;
+
+    template<typename T>
+    static constexpr bool is_std_span_v = is_std_span<T>::value;
+
+    template<typename T>
+    struct is_std_const_span : std::false_type {};
+
+    template<typename T>
+    struct is_std_const_span<std::span<const T, std::dynamic_extent>> : std::true_type {};
+
+    template<typename T>
+    static constexpr bool is_std_const_span_v = is_std_const_span<T>::value;
+
+    template<typename T>
+    static constexpr bool is_std_vector_v = is_specialization_v<T, std::vector>;
+
+    template<typename T>
+    static constexpr bool is_std_list_v = is_specialization_v<T, std::list>;
+
+    template<typename T>
+    static constexpr bool is_std_string_v = is_specialization_v<T, std::basic_string>;
+
+    template<typename T>
+    static constexpr bool is_std_string_view_v = is_specialization_v<T, std::basic_string_view>;
+
+    template<typename T>
+    static constexpr bool is_std_unique_ptr_v = is_specialization_v<T, std::unique_ptr>;
+
+    template<typename T>
+    static constexpr bool is_std_shared_ptr_v = is_specialization_v<T, std::shared_ptr>;
+
+    template<typename T>
+    static constexpr bool is_std_optional_v = is_specialization_v<T, std::optional>;
+
+    template<typename T>
+    static constexpr bool is_std_variant_v = is_specialization_v<T, std::variant>;
+
+    template<typename T>
+    static constexpr bool is_std_map_v = 
+        is_specialization_v<T, std::map> ||
+        is_specialization_v<T, std::multimap>;
+
+    template<typename T>
+    static constexpr bool is_std_pmr_container_v = requires {
+        typename T::allocator_type;
+        typename T::value_type;
+        requires std::is_same_v<typename T::allocator_type, std::pmr::polymorphic_allocator<typename T::value_type>>;
+    };
+
+    template<typename TOptions>
+    static constexpr bool options_trusted_input_v = requires { requires TOptions::trusted_input == true; };
+
+    template<typename TOptions>
+    static constexpr bool options_validate_utf8_v = requires { requires TOptions::validate_utf8 == true; };
+
+    template<typename TOptions>
+    static constexpr bool options_list_element_index_v = requires { requires TOptions::list_element_index == true; };
+
+    template<typename TOptions>
+    static constexpr bool options_varint_integers_v = requires { requires TOptions::varint_integers == true; };
+
+    template<typename TOptions>
+    static constexpr size_t options_max_depth_v = [] {
+        if constexpr (requires { TOptions::max_depth; }) {
+            return static_cast<size_t>(TOptions::max_depth);
+        }
+        else {
+            return std::numeric_limits<size_t>::max();
+        }
+    }();
+
+    template<typename TOptions>
+    static constexpr size_t options_parallel_write_chunk_size_v = [] {
+        if constexpr (requires { TOptions::parallel_write_chunk_size; }) {
+            return static_cast<size_t>(TOptions::parallel_write_chunk_size);
+        }
+        else {
+            return size_t{ 0 };
+        }
+    }();
+
+    template<typename TOptions>
+    struct options_write_executor {
+        using type = default_executor;
+    };
+
+    template<typename TOptions> requires requires { typename TOptions::write_executor; }
+    struct options_write_executor<TOptions> {
+        using type = typename TOptions::write_executor;
+    };
+
+    template<typename TOptions>
+    using options_write_executor_t = typename options_write_executor<TOptions>::type;
+
+    template<typename TOptions>
+    static constexpr size_t options_parallel_read_chunk_size_v = [] {
+        if constexpr (requires { TOptions::parallel_read_chunk_size; }) {
+            return static_cast<size_t>(TOptions::parallel_read_chunk_size);
+        }
+        else {
+            return size_t{ 0 };
+        }
+    }();
+
+    template<typename TOptions>
+    struct options_read_executor {
+        using type = default_executor;
+    };
+
+    template<typename TOptions> requires requires { typename TOptions::read_executor; }
+    struct options_read_executor<TOptions> {
+        using type = typename TOptions::read_executor;
+    };
+
+    template<typename TOptions>
+    using options_read_executor_t = typename options_read_executor<TOptions>::type;
+
+    template<typename T>
+    struct format_value {
+        using type = T;
+        static constexpr auto is_varint = false;
+    };
+
+    template<typename T>
+    struct format_value<varint<T>> {
+        using type = T;
+        static constexpr auto is_varint = true;
+    };
+
+    // Type of the values of a binary format type, whether written as is or as varint.
+    template<typename T>
+    using format_value_t = typename format_value<T>::type;
+
+    template<typename T>
+    static constexpr bool is_varint_v = format_value<T>::is_varint;
+
+    // Smallest size of a value of a binary format type, in bytes.
+    template<typename T>
+    static constexpr size_t format_min_size_v = is_varint_v<T> ? size_t{ 1 } : sizeof(T);
+
+    template<typename TOptions>
+    static constexpr bool options_has_varint_v =
+        is_varint_v<typename TOptions::string_offset_type> ||
+        is_varint_v<typename TOptions::object_offset_type> ||
+        is_varint_v<typename TOptions::object_property_count_type> ||
+        is_varint_v<typename TOptions::list_offset_type> ||
+        is_varint_v<typename TOptions::list_element_count_type> ||
+        is_varint_v<typename TOptions::map_offset_type> ||
+        is_varint_v<typename TOptions::map_element_count_type> ||
+        is_varint_v<typename TOptions::variant_index_type>;
+
+    constexpr size_t max_varint_size = 10;
+
+    // Encodes value as unsigned LEB128 into output, of at least max_varint_size bytes, and returns the size written.
+    [[nodiscard]] inline size_t encode_varint(uint64_t value, uint8_t* output) {
+        size_t size = 0;
+        while (value >= 0b10000000) {
+            output[size++] = static_cast<uint8_t>(value | 0b10000000);
+            value >>= 7;
+        }
+        output[size++] = static_cast<uint8_t>(value);
+        return size;
+    }
+
+    // Set in the data type of integers written as varints, ZigZag encoded if signed.
+    static constexpr auto varint_value_flag = uint8_t{ 0b00100000 };
+
+    // Integers of more than one byte, and enums of them, which are written as varints if enabled.
+    template<typename T>
+    static constexpr bool is_varint_integer_v =
+        std::is_integral_v<T> == true &&
+        std::is_same_v<T, bool> == false &&
+        sizeof(T) > 1 &&
+        fundamental_traits<T>::is_fundamental == true;
+
+    template<typename T> requires std::is_enum_v<T>
+    static constexpr bool is_varint_integer_v<T> = is_varint_integer_v<std::underlying_type_t<T>>;
+
+    // Values whose data type is flagged if written as varint, including integers of nested nullables. 
+    // Values of shared pointers never are, at any depth, as references are read without the data type of the value referenced.
+    template<typename T>
+    static constexpr bool is_varint_value_v = is_varint_integer_v<T>;
+
+    template<typename T> requires is_std_unique_ptr_v<T>
+    static constexpr bool is_varint_value_v<T> = is_varint_value_v<typename T::element_type>;
+
+    template<typename T> requires is_std_optional_v<T>
+    static constexpr bool is_varint_value_v<T> = is_varint_value_v<typename T::value_type>;
+
+    template<typename T>
+    struct varint_integer {
+        using type = T;
+    };
+
+    template<typename T> requires std::is_enum_v<T>
+    struct varint_integer<T> {
+        using type = std::underlying_type_t<T>;
+    };
+
+    // Integer type of integers and enums written as varints.
+    template<typename T>
+    using varint_integer_t = typename varint_integer<T>::type;
+
+    template<std::integral T>
+    [[nodiscard]] constexpr auto encode_zigzag(const T value) -> std::make_unsigned_t<T> {
+        using unsigned_t = std::make_unsigned_t<T>;
+        if constexpr (std::is_signed_v<T> == true) {
+            return static_cast<unsigned_t>(
+                static_cast<unsigned_t>(static_cast<unsigned_t>(value) << 1) ^ static_cast<unsigned_t>(value >> (sizeof(T) * 8 - 1)));
+        }
+        else {
+            return value;
+        }
+    }
+
+    template<std::integral T>
+    [[nodiscard]] constexpr auto decode_zigzag(const std::make_unsigned_t<T> value) -> T {
+        using unsigned_t = std::make_unsigned_t<T>;
+        if constexpr (std::is_signed_v<T> == true) {
+            return static_cast<T>(static_cast<unsigned_t>(value >> 1) ^ static_cast<unsigned_t>(unsigned_t{ 0 } - (value & 1)));
+        }
+        else {
+            return value;
+        }
+    }
+
+    // Encodes values as ZigZag LEB128 varints into output, of at least count * max_varint_size bytes, and returns the size written.
+    // Blocks of values below 128 are written a byte each in loops of fixed length, which compilers vectorize, 
+    // and blocks of values of up to two or four bytes without branching on their size.
+    template<std::integral T>
+    [[nodiscard]] inline size_t encode_varint_values(const T* values, const size_t count, uint8_t* output) {
+        using unsigned_t = std::make_unsigned_t<T>;
+        constexpr auto block_size = size_t{ 16 };
+
+        size_t size = 0;
+        size_t i = 0;
+
+        for (; i + block_size <= count; i += block_size) {
+            unsigned_t encoded_values[block_size];
+            auto encoded_bits = unsigned_t{ 0 };
+            for (size_t j = 0; j < block_size; j++) {
+                encoded_values[j] = encode_zigzag(values[i + j]);
+                encoded_bits |= encoded_values[j];
+            }
+
+            if (encoded_bits < 0b10000000) {
+                for (size_t j = 0; j < block_size; j++) {
+                    output[size + j] = static_cast<uint8_t>(encoded_values[j]);
+                }
+                size += block_size;
+                continue;
+            }
+
+            if (encoded_bits < 0b100000000000000) {
+                for (size_t j = 0; j < block_size; j++) {
+                    const auto is_two_bytes = static_cast<size_t>(encoded_values[j] >= 0b10000000);
+                    output[size] = static_cast<uint8_t>(encoded_values[j] | (is_two_bytes << 7));
+                    output[size + 1] = static_cast<uint8_t>(encoded_values[j] >> 7);
+                    size += 1 + is_two_bytes;
+                }
+                continue;
+            }
+
+            if (encoded_bits < (uint64_t{ 1 } << 28)) {
+                for (size_t j = 0; j < block_size; j++) {
+                    const auto value = static_cast<uint32_t>(encoded_values[j]);
+                    const auto value_size = size_t{ 1 } +
+                        static_cast<size_t>(value >= (uint32_t{ 1 } << 7)) +
+                        static_cast<size_t>(value >= (uint32_t{ 1 } << 14)) +
+                        static_cast<size_t>(value >= (uint32_t{ 1 } << 21));
+
+                    // All four bytes are written, with continuation bits on all but the last byte of the value.
+                    const auto continuation_bits = uint32_t{ 0x808080 } >> ((4 - value_size) * 8);
+                    const auto bytes = continuation_bits |
+                        (value & 0x7F) | ((value << 1) & 0x7F00) | ((value << 2) & 0x7F0000) | ((value << 3) & 0x7F000000);
+
+                    if constexpr (std::endian::native == std::endian::little) {
+                        std::memcpy(output + size, &bytes, sizeof(bytes));
+                    }
+                    else {
+                        for (size_t k = 0; k < sizeof(bytes); k++) {
+                            output[size + k] = static_cast<uint8_t>(bytes >> (k * 8));
+                        }
+                    }
+                    size += value_size;
+                }
+                continue;
+            }
+
+            for (size_t j = 0; j < block_size; j++) {
+                size += encode_varint(encoded_values[j], output + size);
+            }
+        }
+
+        for (; i < count; i++) {
+            size += encode_varint(encode_zigzag(values[i]), output + size);
+        }
+
+        return size;
+    }
+
+    template<typename T>
+    static constexpr bool is_pmr_unique_ptr_v = false;
+
+    template<typename T>
+    static constexpr bool is_pmr_unique_ptr_v<std::unique_ptr<T, pmr_deleter<T>>> = true;
+
+    template<typename T>
+    static constexpr bool is_nullable_v =
+        is_std_unique_ptr_v<T> ||
+        is_std_shared_ptr_v<T> ||
+        is_std_optional_v<T>;
+
+    template<typename T>
+    struct value_size_trait {
+        static constexpr size_t size = sizeof(T);
+    };
+
+    template<typename T, size_t Vsize>
+    struct value_size_trait<std::array<T, Vsize>> {
+        static constexpr size_t size = sizeof(T) * Vsize;
+    };
+
+    template<typename T, size_t Vsize>
+    struct value_size_trait<T[Vsize]> {
+        static constexpr size_t size = sizeof(T) * Vsize;
+    };
+
+    struct dummy_read_write_context {
+        static constexpr auto direction = context_direction::write;
+        auto map(auto& ...) { return true; }
+        auto skip(size_t = 1) { return true; }
+
+        template<typename Tas, typename T>
+        auto map_as(T&) { }
+    };
+
+    template<typename T>
+    [[nodiscard]] constexpr auto object_is_mapped() -> bool {
+        return
+            std::is_class_v<T> == true &&
+            requires(T & value, dummy_read_write_context dummy) { { blopp::object<T>::map(dummy, value) }; };
+    }
+
+    struct dummy_format_read_write_context {
+        static constexpr auto direction = context_direction::write;
+        auto format(auto& ...) { return true; }
+    };
+
+    template<typename T>
+    [[nodiscard]] constexpr auto object_is_formatted() -> bool {
+        return
+            std::is_class_v<T> == true &&
+            requires(T & value, dummy_format_read_write_context dummy) { { blopp::object<T>::format(dummy, value) }; };
+    }
+
+    template<typename T>
+    void assert_no_input_views();
+
+    // Context instantiating map of objects checked by assert_no_input_views, never used at runtime.
+    struct input_views_check_context {
+        static constexpr auto direction = context_direction::read;
+
+        template<typename ... T>
+        auto map(T& ...) -> bool {
+            (assert_no_input_views<std::remove_cvref_t<T>>(), ...);
+            return true;
+        }
+
+        auto skip(size_t = 1) -> bool {
+            return true;
+        }
+
+        template<typename Tas, typename T>
+        auto map_as(T&) -> bool {
+            assert_no_input_views<std::remove_cvref_t<T>>();
+            return true;
+        }
+    };
+
+    template<typename T>
+    void check_object_input_views(input_views_check_context& context, T& value) {
+        object<T>::map(context, value);
+    }
+
+    // Fails to compile if T, or any value within it, is read as a view into the input, such as std::string_view.
+    template<typename T>
+    void assert_no_input_views() {
+        if constexpr (is_std_string_view_v<T> == true || is_std_const_span_v<T> == true) {
+            static_assert(always_false<T>, 
+                "Cannot read std::string_view or std::span<const T> from a file or stream, their input is released after reading.");
+        }
+        else if constexpr (is_std_unique_ptr_v<T> == true || is_std_shared_ptr_v<T> == true) {
+            assert_no_input_views<typename T::element_type>();
+        }
+        else if constexpr (
+            is_std_optional_v<T> == true ||
+            is_std_array_v<T> == true ||
+            is_std_vector_v<T> == true ||
+            is_std_list_v<T> == true)
+        {
+            assert_no_input_views<typename T::value_type>();
+        }
+        else if constexpr (std::is_array_v<T> == true) {
+            assert_no_input_views<std::remove_extent_t<T>>();
+        }
+        else if constexpr (is_std_map_v<T> == true) {
+            assert_no_input_views<typename T::key_type>();
+            assert_no_input_views<typename T::mapped_type>();
+        }
+        else if constexpr (is_std_variant_v<T> == true) {
+            [&]<size_t ... Vindex>(std::index_sequence<Vindex...>) {
+                (assert_no_input_views<std::variant_alternative_t<Vindex, T>>(), ...);
+            }(std::make_index_sequence<std::variant_size_v<T>>{});
+        }
+        else if constexpr (object_is_mapped<T>() == true) {
+            // Taking the address instantiates map of the object with the checking context.
+            [[maybe_unused]] constexpr auto check_object = &check_object_input_views<T>;
+        }
+    }
+
+    template<typename Tfrom, typename Tto>
+    constexpr auto conversion_overflows(const Tfrom from) -> bool {
+        if constexpr (std::is_signed_v<Tfrom> == false && std::is_signed_v<Tto> == false) {
+            return 
+                static_cast<uint64_t>(from) > static_cast<uint64_t>(std::numeric_limits<Tto>::max());
+        }
+        else if constexpr (std::is_signed_v<Tfrom> == true && std::is_signed_v<Tto> == true) {
+            if constexpr (std::is_floating_point_v< Tto> == true) {
+                return false;
+            }
+            else {
+                return
+                    static_cast<int64_t>(from) > static_cast<int64_t>(std::numeric_limits<Tto>::max()) ||
+                    static_cast<int64_t>(from) < static_cast<int64_t>(std::numeric_limits<Tto>::min());
+            }
+
+            
+        }
+        else if constexpr (std::is_signed_v<Tfrom> == true && std::is_signed_v<Tto> == false) {
+            return 
+                from < Tfrom{} ||
+                static_cast<uint64_t>(from) > static_cast<uint64_t>(std::numeric_limits<Tto>::max());
+        }
+        else if constexpr (std::is_signed_v<Tfrom> == false && std::is_signed_v<Tto> == true) {
+            if constexpr (std::is_floating_point_v< Tto> == true) {
+                return false;
+            }
+            else {
+                return 
+                    static_cast<uint64_t>(from) > static_cast<uint64_t>(std::numeric_limits<Tto>::max());
+            }
+        }
+        else {
+            static_assert(always_false<Tfrom>, "Missing conversion_overflows case.");
+        }
+    }
+
+    template<typename T>
+    [[nodiscard]] constexpr data_types get_data_type() {
+        using value_fundamental_traits = fundamental_traits<T>;
+        if constexpr (value_fundamental_traits::is_fundamental == true) {
+            return value_fundamental_traits::data_type;
+        }
+        else if constexpr (std::is_enum_v<T> == true) {
+            using underlying_t = std::underlying_type_t<T>;
+            using underlying_fundamental_traits = fundamental_traits<underlying_t>;
+            return underlying_fundamental_traits::data_type;
+        }
+        else if constexpr (
+            is_std_string_v<T> == true ||
+            is_std_string_view_v<T> == true)
+        {
+            return data_types::string;
+        }
+        else if constexpr (
+            is_std_unique_ptr_v<T> == true ||
+            is_std_shared_ptr_v<T> == true)
+        {
+            using element_t = typename T::element_type;
+            return get_data_type<element_t>();
+        }
+        else if constexpr (is_std_optional_v<T> == true) {
+            using element_t = typename T::value_type;
+            return get_data_type<element_t>();
+        }
+        else if constexpr (
+            is_std_array_v<T> == true ||
+            is_std_vector_v<T> == true ||
+            is_std_list_v<T> == true ||
+            std::is_array_v<T> == true)
+        {
+            return data_types::list;
+        }
+        else if constexpr (is_std_const_span_v<T> == true) {
+            static_assert(fundamental_traits<typename T::value_type>::is_fundamental == true,
+                "Only spans of fundamental types are supported by blopp.");
+            return data_types::list;
+        }
+        else if constexpr (is_std_map_v<T> == true) {
+            return data_types::map;
+        }
+        else if constexpr (is_std_variant_v<T> == true) {
+            return data_types::variant;
+        }
+        else if constexpr (std::is_class_v<T> == true && object_is_mapped<T>() == true) {
+            return data_types::object;
+        }
+        else if constexpr (std::is_class_v<T> == true && object_is_formatted<T>() == true) {
+            return data_types::unspecified;
+        }
+        else {
+            static_assert(always_false<T>, "Unmapped blopp data type.");
+        }
+    }
+
+    // Data type of T, flagged if its integers are written as varints.
+    template<typename T, bool Vvarint>
+    [[nodiscard]] constexpr data_types get_value_data_type() {
+        if constexpr (Vvarint == true && is_varint_value_v<T> == true) {
+            return static_cast<data_types>(static_cast<uint8_t>(get_data_type<T>()) | varint_value_flag);
+        }
+        else {
+            return get_data_type<T>();
+        }
+    }
+
+    // Returns true if values of data type may be written as varints.
+    [[nodiscard]] constexpr bool is_varint_data_type(const data_types data_type) {
+        switch (data_type) {
+            case data_types::int16:
+            case data_types::int32:
+            case data_types::int64:
+            case data_types::uint16:
+            case data_types::uint32:
+            case data_types::uint64: return true;
+            default: return false;
+        }
+    }
+
+    // Splits the varint flag off data type.
+    [[nodiscard]] constexpr auto split_varint_value_flag(const data_types data_type) -> std::pair<data_types, bool> {
+        const auto data_type_byte = static_cast<uint8_t>(data_type);
+        return {
+            static_cast<data_types>(data_type_byte & ~varint_value_flag),
+            static_cast<bool>(data_type_byte & varint_value_flag) };
+    }
+
+    template<typename TValue>
+    [[nodiscard]] inline bool nullable_has_value([[maybe_unused]] const TValue& value) {
+        if constexpr (
+            is_std_unique_ptr_v<TValue> == true ||
+            is_std_shared_ptr_v<TValue> == true)
+        {
+            return value != nullptr;
+        }
+        else if constexpr (is_std_optional_v<TValue> == true) {
+            return value.has_value();
+        }
+        else {
+            static_assert(always_false<TValue>, "Unmapped blopp nullable value.");
+        }
+    }
+
+    template<typename T>
+    inline void clear_nullable_value(T& value) {
+        value.reset();
+    }
+
+    template<typename TContainer>
+    inline void clear_container([[maybe_unused]] TContainer& container) {
+        using container_t = std::remove_cvref_t<decltype(container)>;
+        if constexpr (
+            is_std_vector_v<container_t> == true ||
+            is_std_list_v<container_t> == true ||
+            is_std_map_v<container_t> == true)
+        {
+            container.clear();
+        }
+    }
+    template<typename TContainer>
+    inline void resize_container([[maybe_unused]] TContainer& container, [[maybe_unused]] size_t size) {
+        using container_t = std::remove_cvref_t<decltype(container)>;
+        if constexpr (
+            is_std_vector_v<container_t> == true ||
+            is_std_list_v<container_t> == true)
+        {
+            container.resize(size);
+        }
+    }
+
+    template<typename TContainer>
+    inline void resize_add_container([[maybe_unused]] TContainer& container, [[maybe_unused]] size_t size) {
+        using container_t = std::remove_cvref_t<decltype(container)>;
+        if constexpr (is_std_vector_v<container_t> == true) {
+            container.resize(container.size() + size);
+        }
+    }
+
+
+    // Values of varints written after their blocks, in the order reserved, each with the plan index following its block.
+    using varint_plan_values = std::vector<std::pair<uint64_t, size_t>>;
+
+    /*
+    * Varints are sized by their values, so values written after their blocks are planned by a first pass over the value, 
+    * and written in front of their blocks by the next passes.
+    */
+    struct varint_plan {
+        varint_plan_values& values;
+        bool is_planning = false;
+        size_t next_index = 0;
+        bool is_mismatching = false; // Set if a pass writes other varints than planned.
+    };
+
+    template<typename T, typename TOutput>
+    class post_output_writer
+    {
+
+    public:
+
+        post_output_writer(TOutput& output, varint_plan*) :
+            m_output{ output },
+            m_position{ m_output.reserve(sizeof(T)) }
+        {}
+
+        post_output_writer(const post_output_writer&) = delete;
+        post_output_writer(post_output_writer&&) = delete;
+        post_output_writer& operator = (const post_output_writer&) = delete;
+        post_output_writer& operator = (post_output_writer&&) = delete;
+
+        void update(const T value) {
+            m_output.patch(m_position, reinterpret_cast<const uint8_t*>(&value), sizeof(T));
+        }
+
+        // Skips the block following the value, if outside the window of a block skipping output.
+        [[nodiscard]] bool skip_block() {
+            return m_output.skip_block();
+        }
+
+    private:
+
+        TOutput& m_output;
+        size_t m_position;
+
+    };
+
+    template<typename TOutput>
+    class write_context_base {
+
+    protected:
+
+        explicit write_context_base(TOutput& output) :
+            m_output{ output }
+        {}
+
+        template<bool Vis_nullable>
+        inline void write_data_type(data_types data_type) {
+            auto value = static_cast<uint8_t>(data_type);
+            if constexpr (Vis_nullable == true) {
+                value = static_cast<uint8_t>(value | 0b10000000);
+            }
+            m_output.append(value);
+        }
+
+        template<typename TValue>
+        inline void write_value(const TValue& value) {
+            const auto* value_ptr = reinterpret_cast<const uint8_t*>(&value);
+            m_output.append(value_ptr, sizeof(value));
+        }
+
+        // Writes an offset, count or index as a value of binary format type T.
+        template<typename T>
+        inline void write_format_value(const uint64_t value) {
+            if constexpr (is_varint_v<T> == true) {
+                uint8_t buffer[max_varint_size];
+                m_output.append(buffer, encode_varint(value, buffer));
+            }
+            else {
+                write_value(static_cast<T>(value));
+            }
+        }
+
+        template<typename TContainer>
+        inline void write_contiguous_container(const TContainer& container) {
+            using element_t = typename TContainer::value_type;
+            const auto container_ptr = reinterpret_cast<const uint8_t*>(container.data());
+            const auto container_byte_count = sizeof(element_t) * container.size();
+            m_output.append(container_ptr, container_byte_count);
+        }
+
+        // Writes integer or enum as ZigZag LEB128 varint.
+        template<typename TValue>
+        inline void write_varint_value(const TValue value) {
+            uint8_t buffer[max_varint_size];
+            m_output.append(buffer, encode_varint(encode_zigzag(static_cast<varint_integer_t<TValue>>(value)), buffer));
+        }
+
+        // Writes integers or enums of container as ZigZag LEB128 varints, encoded in batches.
+        template<typename TContainer>
+        inline void write_varint_container(const TContainer& container) {
+            using element_t = typename TContainer::value_type;
+            using integer_t = varint_integer_t<element_t>;
+
+            constexpr auto batch_size = size_t{ 256 };
+            uint8_t buffer[batch_size * max_varint_size];
+
+            if constexpr (std::contiguous_iterator<typename TContainer::iterator> == true) {
+                const auto* values = reinterpret_cast<const integer_t*>(container.data());
+                for (size_t i = 0; i < container.size(); i += batch_size) {
+                    const auto count = std::min(batch_size, container.size() - i);
+                    m_output.append(buffer, encode_varint_values(values + i, count, buffer));
+                }
+            }
+            else {
+                auto size = size_t{ 0 };
+                for (const auto value : container) {
+                    size += encode_varint(encode_zigzag(static_cast<integer_t>(value)), buffer + size);
+                    if (size > (batch_size - 1) * max_varint_size) {
+                        m_output.append(buffer, size);
+                        size = 0;
+                    }
+                }
+                m_output.append(buffer, size);
+            }
+        }
+
+        TOutput& m_output;
+
+    };
+
+    template<typename TOptions, typename TOutput>
+    class write_format_context : private write_context_base<TOutput> {
+
+    private:
+
+        using base = write_context_base<TOutput>;
+        using base::write_value;
+        using base::write_contiguous_container;
+
+        using options = TOptions;
+        using options_format_size_type = typename options::format_size_type;
+        static constexpr auto max_format_size = static_cast<size_t>(std::numeric_limits<options_format_size_type>::max());
+
+    public:      
+
+        static constexpr auto direction = context_direction::write;
+        
+        explicit write_format_context(
+            TOutput& output
+        ) :
+            base{ output }
+        {}
+
+        write_format_context(const write_format_context&) = delete;
+        write_format_context(write_format_context&&) = delete;
+        write_format_context& operator = (const write_format_context&) = delete;
         write_format_context& operator = (write_format_context&&) = delete;
 
         template<typename ... T>
-        auto format(T& ... value) -> bool
-        {
-            static_assert(sizeof...(value) > 0, 
-                "Cannot pass 0 parameters to format function of blopp context.");
+        auto format(T& ... value) -> bool
+        {
+            static_assert(sizeof...(value) > 0, 
+                "Cannot pass 0 parameters to format function of blopp context.");
+
+            constexpr auto total_variadic_size = get_total_variadic_size<T...>();
+
+            static_assert(max_format_size >= total_variadic_size,
+                "Total size of variadics passed to blopp format exceeds max format size");
+
+            if (m_error.has_value()) {
+                return false;
+            }
+
+            if (total_format_size + total_variadic_size > max_format_size) {
+                m_error = write_error_code::format_size_overflow;
+                return false;
+            }
+
+            (format_impl(value), ...);
+
+            total_format_size += total_variadic_size;
+
+            return true;
+        }
+
+        [[nodiscard]] inline auto error() const {
+            return m_error;
+        }
+ 
+    private:
+
+        template<typename ... T>
+        [[nodiscard]] inline static constexpr size_t get_total_variadic_size()
+        {
+            return (value_size_trait<std::remove_cvref_t<T>>::size + ...);
+        }
+
+        [[nodiscard]] inline auto write_array(auto& value) {
+            using value_t = std::remove_cvref_t<decltype(value)>;
+            using element_t = typename value_t::value_type;
+            using element_fundamental_traits = fundamental_traits<element_t>;
+
+            static_assert(
+                element_fundamental_traits::is_fundamental == true ||
+                std::is_enum_v<element_t> == true,
+                "Only fundamentals and enums are supported for blopp formatting of arrays.");
+
+            write_contiguous_container(value);
+        }
+
+        [[nodiscard]] inline auto format_impl(auto& value) {
+            using value_t = std::remove_cvref_t<decltype(value)>;
+            using value_fundamental_traits = fundamental_traits<value_t>;
+
+            if constexpr (
+                value_fundamental_traits::is_fundamental == true ||
+                std::is_enum_v<value_t> == true)
+            {
+                write_value(value);
+            }
+            else if constexpr (is_std_array_v<value_t> == true) {
+                write_array(value);
+            }
+            else if constexpr (std::is_array_v<value_t> == true) {
+                auto array_span = std::span(value);
+                write_array(array_span);
+            }
+            else {
+                static_assert(always_false<value_t>, "Unmapped blopp format data type.");
+            }
+        };
+
+        std::optional<write_error_code> m_error = {};
+        size_t total_format_size = 0;
+
+    };
+
+    template<typename TOptions>
+    static constexpr auto options_reference_policy_v = [] {
+        if constexpr (requires { TOptions::reference_policy; }) {
+            return TOptions::reference_policy;
+        }
+        else {
+            return reference_policy::ordered_map;
+        }
+    }();
+
+    // Maps positions of values read, or addresses of values written, to their references. 
+    // Keys are only inserted once, later inserts of the same key are ignored.
+    template<typename TValue, reference_policy Vpolicy>
+    class reference_table;
+
+    template<typename TValue>
+    class reference_table<TValue, reference_policy::ordered_map> {
+
+    public:
+
+        [[nodiscard]] inline const TValue* find(const uint64_t key) const {
+            auto it = m_map.find(key);
+            return it != m_map.end() ? &it->second : nullptr;
+        }
+
+        inline void insert(const uint64_t key, TValue value) {
+            m_map.emplace(key, std::move(value));
+        }
+
+    private:
+
+        std::map<uint64_t, TValue> m_map;
+
+    };
+
+    template<typename TValue>
+    class reference_table<TValue, reference_policy::hash_map> {
+
+    public:
+
+        [[nodiscard]] inline const TValue* find(const uint64_t key) const {
+            if (m_slots.empty()) {
+                return nullptr;
+            }
+
+            for (auto index = get_slot_index(key); ; index = (index + 1) & (m_slots.size() - 1)) {
+                const auto& slot = m_slots[index];
+                if (slot.key == key) {
+                    return &slot.value;
+                }
+                if (slot.key == empty_key) {
+                    return nullptr;
+                }
+            }
+        }
+
+        inline void insert(const uint64_t key, TValue value) {
+            // Keeps the load factor below 3/4.
+            if ((m_size + 1) * 4 > m_slots.size() * 3) {
+                grow();
+            }
+
+            for (auto index = get_slot_index(key); ; index = (index + 1) & (m_slots.size() - 1)) {
+                auto& slot = m_slots[index];
+                if (slot.key == key) {
+                    return;
+                }
+                if (slot.key == empty_key) {
+                    slot.key = key;
+                    slot.value = std::move(value);
+                    ++m_size;
+                    return;
+                }
+            }
+        }
+
+    private:
+
+        static constexpr auto empty_key = std::numeric_limits<uint64_t>::max();
+        static constexpr auto min_slot_count = size_t{ 16 };
+
+        struct slot {
+            uint64_t key = empty_key;
+            TValue value = {};
+        };
+
+        [[nodiscard]] inline size_t get_slot_index(uint64_t key) const {
+            // Mixes the bits of the key, as addresses and positions have mostly equal low bits.
+            key ^= key >> 33;
+            key *= uint64_t{ 0xFF51AFD7ED558CCD };
+            key ^= key >> 33;
+            return static_cast<size_t>(key) & (m_slots.size() - 1);
+        }
+
+        inline void grow() {
+            auto old_slots = std::move(m_slots);
+            m_slots = std::vector<slot>(std::max(min_slot_count, old_slots.size() * 2));
+            m_size = 0;
+
+            for (auto& old_slot : old_slots) {
+                if (old_slot.key != empty_key) {
+                    insert(old_slot.key, std::move(old_slot.value));
+                }
+            }
+        }
+
+        std::vector<slot> m_slots;
+        size_t m_size = 0;
+
+    };
+
+    template<typename TValue>
+    class reference_table<TValue, reference_policy::flat_vector> {
+
+    public:
+
+        [[nodiscard]] inline const TValue* find(const uint64_t key) const {
+            auto it = lower_bound(key);
+            return (it != m_entries.end() && it->first == key) ? &it->second : nullptr;
+        }
+
+        inline void insert(const uint64_t key, TValue value) {
+            if (m_entries.empty() || m_entries.back().first < key) {
+                m_entries.emplace_back(key, std::move(value));
+                return;
+            }
+
+            auto it = lower_bound(key);
+            if (it == m_entries.end() || it->first != key) {
+                m_entries.emplace(it, key, std::move(value));
+            }
+        }
+
+    private:
+
+        using entry = std::pair<uint64_t, TValue>;
+
+        [[nodiscard]] inline auto lower_bound(const uint64_t key) const {
+            return std::lower_bound(m_entries.begin(), m_entries.end(), key, [](const entry& lhs, const uint64_t rhs) {
+                return lhs.first < rhs;
+            });
+        }
+
+        std::vector<entry> m_entries;
+
+    };
+
+    template<typename TValue>
+    class reference_table<TValue, reference_policy::none> {
+
+    public:
+
+        [[nodiscard]] inline const TValue* find(const uint64_t) const {
+            return nullptr;
+        }
+
+        inline void insert(const uint64_t, TValue) {
+        }
+
+    };
+
+    /*
+    * Reference map of reference_policy::none, writing every shared pointer as a value of its own. 
+    * A cycle of shared pointers would be written endlessly, so the shared values being written are tracked to fail on cycles.
+    */
+    class unreferenced_write_map : public reference_table<uint64_t, reference_policy::none> {
+
+    public:
+
+        [[nodiscard]] inline bool is_writing(const uint64_t key) const {
+            return std::find(m_writing_keys.begin(), m_writing_keys.end(), key) != m_writing_keys.end();
+        }
+
+        inline void begin_write(const uint64_t key) {
+            m_writing_keys.push_back(key);
+        }
+
+        inline void end_write() {
+            m_writing_keys.pop_back();
+        }
+
+    private:
+
+        std::vector<uint64_t> m_writing_keys; // Keys of the shared values being written, outermost first.
+
+    };
+
+    // Positions of values written, by address. Addresses aren't ordered by position, so flat_vector writes via a hash map.
+    template<typename TOptions>
+    using write_reference_map = std::conditional_t<
+        options_reference_policy_v<TOptions> == reference_policy::none,
+        unreferenced_write_map,
+        reference_table<
+            uint64_t,
+            options_reference_policy_v<TOptions> == reference_policy::flat_vector ?
+                reference_policy::hash_map :
+                options_reference_policy_v<TOptions>>>;
+
+    [[nodiscard]] inline uint64_t get_reference_key(const void* pointer) {
+        return static_cast<uint64_t>(reinterpret_cast<uintptr_t>(pointer));
+    }
+
+    // Output sinks of blopp::encoder, skipping whole blocks and elements not visible in the current output window.
+    template<typename T>
+    concept block_skipping_output_sink = output_sink<T> && requires(T& sink) {
+        { sink.skip_block() } -> std::same_as<bool>;
+        { sink.find_reference(uint64_t{}) } -> std::same_as<const uint64_t*>;
+        { sink.is_after_window() } -> std::same_as<bool>;
+        { sink.sequence() } -> std::same_as<size_t>;
+    };
+
+    // Records the value of every reservation, the position of every shared value and elements to resume at, 
+    // without keeping any output.
+    template<typename TPlan>
+    class write_plan_output_sink {
+
+    public:
+
+        // Elements are planned at intervals, bounding the elements written before the window of each list or map.
+        static constexpr size_t element_interval = 64;
+
+        explicit write_plan_output_sink(TPlan& plan) :
+            m_plan{ plan }
+        {}
+
+        size_t position() const {
+            return m_position;
+        }
+
+        void append(const uint8_t) {
+            ++m_position;
+        }
+
+        void append(const uint8_t*, const size_t size) {
+            m_position += size;
+        }
+
+        size_t reserve(const size_t size) {
+            m_plan.reservations.emplace_back();
+            m_reservation_positions.push_back(m_position);
+
+            const auto position = m_position;
+            m_position += size;
+            return position;
+        }
+
+        void patch(const size_t position, const uint8_t* data, const size_t size) {
+            const auto it = std::lower_bound(m_reservation_positions.begin(), m_reservation_positions.end(), position);
+            const auto index = static_cast<size_t>(it - m_reservation_positions.begin());
+
+            auto& reservation = m_plan.reservations[index];
+            reservation.value = 0;
+            std::memcpy(&reservation.value, data, size);
+            reservation.end_index = m_plan.reservations.size();
+        }
+
+        std::optional<write_error_code> error() const {
+            return {};
+        }
+
+        bool skip_block() {
+            return false;
+        }
+
+        void add_reference(const uint64_t key, const uint64_t position) {
+            m_plan.references.emplace_back(key, position);
+        }
+
+        // References are found in the reference map while planning.
+        const uint64_t* find_reference(const uint64_t) const {
+            return nullptr;
+        }
+
+        bool is_after_window() const {
+            return false;
+        }
+
+        size_t sequence() const {
+            return m_plan.reservations.size();
+        }
+
+        // Plans the element at the current position. Elements of indexed lists are all planned, as their offsets are written from the plan.
+        template<typename TIterator>
+        void add_element(const size_t sequence, const size_t index, const size_t varint_index, const TIterator& iterator, const bool is_indexed) {
+            if (index % element_interval != 0 && is_indexed == false) {
+                return;
+            }
+
+            auto& element = m_plan.elements.emplace_back();
+            element.sequence = sequence;
+            element.index = index;
+            element.position = m_position;
+            element.reservation_index = m_plan.reservations.size();
+            element.varint_index = varint_index;
+
+            if constexpr (std::random_access_iterator<TIterator> == false) {
+                element.iterator = iterator;
+            }
+        }
+
+        template<typename TOffset>
+        void append_element_offsets(const size_t, const size_t, const size_t element_count) {
+            m_position += element_count * sizeof(TOffset);
+        }
+
+        // Orders references and elements for the lookups of write_window_output_sink.
+        void complete() {
+            std::sort(m_plan.references.begin(), m_plan.references.end());
+            std::stable_sort(m_plan.elements.begin(), m_plan.elements.end(), [](const auto& lhs, const auto& rhs) {
+                return lhs.sequence < rhs.sequence;
+            });
+        }
+
+    private:
+
+        TPlan& m_plan;
+        std::vector<size_t> m_reservation_positions = {};
+        size_t m_position = 0;
+
+    };
+
+    // Writes the bytes within a window of the output, with reservations and references written in their planned form.
+    template<typename TPlan>
+    class write_window_output_sink {
+
+    public:
+
+        write_window_output_sink(const TPlan& plan, std::span<uint8_t> window, const size_t window_position) :
+            m_plan{ plan },
+            m_window{ window },
+            m_window_position{ window_position }
+        {}
+
+        size_t position() const {
+            return m_position;
+        }
+
+        void append(const uint8_t value) {
+            append(&value, 1);
+        }
+
+        void append(const uint8_t* data, const size_t size) {
+            const auto begin = std::max(m_position, m_window_position);
+            const auto end = std::min(m_position + size, m_window_position + m_window.size());
+
+            if (begin < end) {
+                std::memcpy(m_window.data() + (begin - m_window_position), data + (begin - m_position), end - begin);
+            }
+
+            m_position += size;
+        }
+
+        size_t reserve(const size_t size) {
+            const auto& reservation = m_plan.reservations[m_reservation_index++];
+
+            const auto position = m_position;
+            append(reinterpret_cast<const uint8_t*>(&reservation.value), size);
+            return position;
+        }
+
+        void patch(const size_t, const uint8_t*, const size_t) {
+        }
+
+        std::optional<write_error_code> error() const {
+            return {};
+        }
+
+        // Skips the block of the last reservation, if it's entirely outside of the window.
+        bool skip_block() {
+            const auto& reservation = m_plan.reservations[m_reservation_index - 1];
+            const auto block_end_position = m_position + static_cast<size_t>(reservation.value);
+
+            if (!is_after_window() && block_end_position > m_window_position) {
+                return false;
+            }
+
+            m_position = block_end_position;
+            m_reservation_index = reservation.end_index;
+            return true;
+        }
+
+        void add_reference(const uint64_t, const uint64_t) {
+        }
+
+        // Finds the planned position of a shared value, as its definition may be in a block skipped by this window.
+        const uint64_t* find_reference(const uint64_t key) const {
+            const auto it = std::lower_bound(m_plan.references.begin(), m_plan.references.end(), key, [](const auto& lhs, const uint64_t rhs) {
+                return lhs.first < rhs;
+            });
+            return (it != m_plan.references.end() && it->first == key) ? &it->second : nullptr;
+        }
+
+        bool is_after_window() const {
+            return m_position >= m_window_position + m_window.size();
+        }
+
+        size_t sequence() const {
+            return m_reservation_index;
+        }
+
+        template<typename TIterator>
+        void add_element(const size_t, const size_t, const size_t, const TIterator&, const bool) {
+        }
+
+        // Finds the last planned element of sequence starting at or before the window.
+        auto find_element(const size_t sequence) const -> const typename decltype(TPlan::elements)::value_type* {
+            const auto [first, last] = find_elements(sequence);
+            const auto it = std::upper_bound(first, last, m_window_position, [](const size_t lhs, const auto& rhs) {
+                return lhs < rhs.position;
+            });
+            return it == first ? nullptr : &*std::prev(it);
+        }
+
+        // Continues writing at a planned element.
+        void resume(const typename decltype(TPlan::elements)::value_type& element) {
+            m_position = element.position;
+            m_reservation_index = element.reservation_index;
+        }
+
+        // Writes the element offsets of an indexed list, within the window, from the planned positions of its elements.
+        template<typename TOffset>
+        void append_element_offsets(const size_t sequence, const size_t elements_position, const size_t element_count) {
+            const auto offsets_position = m_position;
+            const auto window_end = m_window_position + m_window.size();
+            const auto [first, last] = find_elements(sequence);
+
+            auto index = offsets_position >= m_window_position ? size_t{ 0 } : (m_window_position - offsets_position) / sizeof(TOffset);
+            for (; index < element_count && index < static_cast<size_t>(last - first); ++index) {
+                m_position = offsets_position + (index * sizeof(TOffset));
+                if (m_position >= window_end) {
+                    break;
+                }
+
+                const auto offset = static_cast<TOffset>(first[index].position - elements_position);
+                append(reinterpret_cast<const uint8_t*>(&offset), sizeof(offset));
+            }
+
+            m_position = offsets_position + (element_count * sizeof(TOffset));
+        }
+
+    private:
+
+        auto find_elements(const size_t sequence) const {
+            return std::equal_range(m_plan.elements.begin(), m_plan.elements.end(), sequence, [](const auto& lhs, const auto& rhs) {
+                if constexpr (std::is_same_v<std::remove_cvref_t<decltype(lhs)>, size_t> == true) {
+                    return lhs < rhs.sequence;
+                }
+                else {
+                    return lhs.sequence < rhs;
+                }
+            });
+        }
+
+        const TPlan& m_plan;
+        std::span<uint8_t> m_window;
+        size_t m_window_position;
+        size_t m_reservation_index = 0;
+        size_t m_position = 0;
+
+    };
+
+    template<typename T, typename TOutput>
+    class post_output_writer<varint<T>, TOutput>
+    {
+
+    public:
+
+        post_output_writer(TOutput& output, varint_plan* plan) :
+            m_output{ output },
+            m_plan{ *plan }
+        {
+            if (m_plan.is_planning) {
+                m_index = m_plan.values.size();
+                m_plan.values.emplace_back();
+                return;
+            }
+
+            m_index = m_plan.next_index++;
+
+            // Block skipping outputs skip blocks by the planned values of their reservations.
+            if constexpr (block_skipping_output_sink<TOutput> == true) {
+                m_position = m_output.reserve(0);
+            }
+
+            if (m_index >= m_plan.values.size()) {
+                m_plan.is_mismatching = true;
+            }
+
+            uint8_t buffer[max_varint_size];
+            m_output.append(buffer, encode_varint(m_plan.is_mismatching ? uint64_t{ 0 } : m_plan.values[m_index].first, buffer));
+        }
+
+        post_output_writer(const post_output_writer&) = delete;
+        post_output_writer(post_output_writer&&) = delete;
+        post_output_writer& operator = (const post_output_writer&) = delete;
+        post_output_writer& operator = (post_output_writer&&) = delete;
+
+        // Appends the varint while planning, to size the blocks it's part of, as written by the next passes.
+        void update(const T value) {
+            if (m_plan.is_planning) {
+                m_plan.values[m_index] = { static_cast<uint64_t>(value), m_plan.values.size() };
+
+                uint8_t buffer[max_varint_size];
+                m_output.append(buffer, encode_varint(value, buffer));
+            }
+            else if constexpr (block_skipping_output_sink<TOutput> == true) {
+                // Windows stop writing blocks at their end, so only the planned index is checked.
+                if (m_index >= m_plan.values.size()) {
+                    m_plan.is_mismatching = true;
+                    return;
+                }
+
+                const auto planned_value = static_cast<uint64_t>(value);
+                m_output.patch(m_position, reinterpret_cast<const uint8_t*>(&planned_value), sizeof(planned_value));
+            }
+            else if (m_index >= m_plan.values.size() || m_plan.values[m_index].first != static_cast<uint64_t>(value)) {
+                m_plan.is_mismatching = true;
+            }
+        }
+
+        [[nodiscard]] bool skip_block() {
+            if (m_index >= m_plan.values.size() || !m_output.skip_block()) {
+                return false;
+            }
+
+            m_plan.next_index = m_plan.values[m_index].second;
+            return true;
+        }
+
+    private:
+
+        TOutput& m_output;
+        varint_plan& m_plan;
+        size_t m_index = 0;
+        size_t m_position = 0;
+
+    };
+
+    // References written by a chunk of elements, written apart from the rest of its list or map.
+    struct write_chunk_references {
+        std::vector<std::pair<uint64_t, uint64_t>> values = {}; // Address and position in chunk, of values written.
+        std::vector<size_t> relocations = {}; // Positions in chunk, of references to values written by the chunk.
+    };
+
+    template<typename TOptions, typename TOutput>
+    class write_context : private write_context_base<TOutput> {
+
+    private:
+
+        using base = write_context_base<TOutput>;
+        using base::m_output;
+        using base::write_value;
+        using base::write_contiguous_container;
+
+        using options = TOptions;
+        using options_object_property_count_type = typename options::object_property_count_type;
+        constexpr static auto max_object_property_count = std::numeric_limits<format_value_t<options_object_property_count_type>>::max();
+
+    public:
+
+        static constexpr auto direction = context_direction::write;
+
+        explicit write_context(
+            TOutput& output,
+            write_reference_map<TOptions>& reference_map,
+            varint_plan* plan = nullptr
+        ) :
+            base{ output },
+            m_reference_map{ reference_map },
+            m_varint_plan{ plan }
+        {}
+
+        write_context(const write_context&) = delete;
+        write_context(write_context&&) = delete;
+        write_context& operator = (const write_context&) = delete;
+        write_context& operator = (write_context&&) = delete;
+
+        template<typename ... T>
+        auto map(T& ... value) -> bool {
+            return map_values<options_varint_integers>(value...);
+        }
+
+        // Maps value as Tas. Integers mapped as blopp::varint<T> are converted to T and written as varint, 
+        // other values are mapped as is, with integers of their lists and maps written as varints.
+        template<typename Tas, typename T>
+        auto map_as(T& value) -> bool {
+            using from_t = std::remove_cvref_t<T>;
+            using to_t = std::remove_cvref_t<Tas>;
+ 
+            static_assert(is_varint_v<to_t> || std::is_integral_v<Tas> || std::is_floating_point_v<Tas>,
+                "Can only cast integral and floating point types.");
+
+            if constexpr (is_varint_v<to_t> == true) {
+                using integer_t = format_value_t<to_t>;
+
+                if constexpr (std::is_integral_v<from_t> == true) {
+                    if (conversion_overflows<from_t, integer_t>(value)) {
+                        m_error = write_error_code::conversion_overflow;
+                        return false;
+                    }
+
+                    const auto casted_value = static_cast<integer_t>(value);
+                    return map_values<true>(casted_value);
+                }
+                else {
+                    return map_values<true>(value);
+                }
+            }
+            else if constexpr (std::is_same_v<from_t, to_t> == true) {
+                return map(value);
+            }
+            else if constexpr (
+                (std::is_integral_v<from_t> == true && std::is_integral_v<to_t> == true) ||
+                (std::is_floating_point_v<from_t> == true && std::is_integral_v<to_t> == true))
+            {
+                if (conversion_overflows<from_t, to_t>(value)) {
+                    m_error = write_error_code::conversion_overflow;
+                    return false;
+                }
+
+                const auto casted_value = static_cast<to_t>(value);
+                return map(casted_value);
+            }
+            else if constexpr (
+                (std::is_floating_point_v<from_t> == true && std::is_floating_point_v<to_t> == true) ||
+                (std::is_integral_v<from_t> == true && std::is_floating_point_v<to_t> == true))
+            {
+                const auto casted_value = static_cast<to_t>(value);
+                return map(casted_value);
+            }
+            else {
+                static_assert(always_false<Tas>, "Mising map_as case.");
+            }
+        }
+
+        template<typename T = void>
+        auto skip(size_t = 1) -> bool {
+            static_assert(always_false<T>, "Cannot write blopp projections, skipped properties have no value to write.");
+            return false;
+        }
+
+        [[nodiscard]] inline auto error() const {
+            return m_error;
+        }
+
+    private:
+
+        template<typename, typename>
+        friend class write_context;
+
+        using options_string_offset_type = typename options::string_offset_type;
+        using options_string_char_size_type = typename options::string_char_size_type;
+        using options_object_offset_type = typename options::object_offset_type;
+        using options_list_offset_type = typename options::list_offset_type;
+        using options_list_element_count_type = typename options::list_element_count_type;
+        using options_map_offset_type = typename options::map_offset_type;
+        using options_map_element_count_type = typename options::map_element_count_type;
+        using options_variant_index_type = typename options::variant_index_type;
+        using options_format_size_type = typename options::format_size_type;
+
+        constexpr static auto max_string_offset = std::numeric_limits<format_value_t<options_string_offset_type>>::max();
+        constexpr static auto max_object_offset = std::numeric_limits<format_value_t<options_object_offset_type>>::max();
+        constexpr static auto max_list_offset = std::numeric_limits<format_value_t<options_list_offset_type>>::max();
+        constexpr static auto max_list_element_count = std::numeric_limits<format_value_t<options_list_element_count_type>>::max();
+        constexpr static auto max_map_offset = std::numeric_limits<format_value_t<options_map_offset_type>>::max();
+        constexpr static auto max_map_element_count = std::numeric_limits<format_value_t<options_map_element_count_type>>::max();
+
+        // Offsets of the element index of lists are of fixed size, to be located by element index.
+        using options_list_element_offset_type = format_value_t<options_list_offset_type>;
+
+        static_assert(is_varint_v<options_string_char_size_type> == false && is_varint_v<options_format_size_type> == false,
+            "string_char_size_type and format_size_type of blopp binary format types cannot be varints.");
+
+        constexpr static auto options_list_element_index = options_list_element_index_v<TOptions>;
+        constexpr static auto options_varint_integers = options_varint_integers_v<TOptions>;
+        constexpr static auto options_parallel_write_chunk_size = options_parallel_write_chunk_size_v<TOptions>;
+        constexpr static auto options_max_depth = options_max_depth_v<TOptions>;
+        using options_write_executor = options_write_executor_t<TOptions>;
+
+        static_assert(task_executor<options_write_executor>, "Write executor of blopp options doesn't satisfy blopp::task_executor.");
+
+        using chunk_write_context = write_context<TOptions, vector_output_sink<>>;
+
+        // Elements of a list or map written into a buffer of their own, while writing in parallel.
+        struct write_chunk {
+            size_t first_element_index = 0;
+            size_t element_count = 0;
+            write_output_type output = {};
+            std::vector<size_t> element_positions = {};
+            write_chunk_references references = {};
+            std::optional<write_error_code> error = {};
+        };
+
+        template<typename TValue>
+        [[nodiscard]] inline bool write_nullable_value_flags(const TValue& value) {
+            using value_t = std::remove_cvref_t<decltype(value)>;
+
+            const auto has_value = nullable_has_value(value);
+
+            if constexpr (is_std_shared_ptr_v<value_t> == true) {
+                if (!has_value) {
+                    m_output.append(static_cast<uint8_t>(nullable_value_flags::is_null));
+                    return false;
+                }
+
+                const auto key = get_reference_key(value.get());
+
+                // Shared values are written where planned, as their definitions may be in blocks skipped by the output.
+                if constexpr (block_skipping_output_sink<TOutput> == true && options_reference_policy_v<TOptions> != reference_policy::none) {
+                    if (const auto* position = m_output.find_reference(key); position != nullptr) {
+                        if (*position == m_output.position() + sizeof(uint8_t)) {
+                            m_output.append(static_cast<uint8_t>(nullable_value_flags::has_value));
+                            return true;
+                        }
+
+                        m_output.append(static_cast<uint8_t>(nullable_value_flags::has_value_and_is_reference));
+                        write_value(*position);
+                        return false;
+                    }
+                }
+
+                if (const auto* position = m_reference_map.find(key); position != nullptr) {
+                    m_output.append(static_cast<uint8_t>(nullable_value_flags::has_value_and_is_reference));
+                    if (m_chunk_references != nullptr) {
+                        m_chunk_references->relocations.push_back(m_output.position());
+                    }
+                    write_value(*position);
+                    return false;
+                }
+
+                if (m_parent_reference_map != nullptr) {
+                    if (const auto* position = m_parent_reference_map->find(key); position != nullptr) {
+                        m_output.append(static_cast<uint8_t>(nullable_value_flags::has_value_and_is_reference));
+                        write_value(*position);
+                        return false;
+                    }
+                }
+
+                m_output.append(static_cast<uint8_t>(nullable_value_flags::has_value));
+                return true;
+            }
+            else {
+                static_assert(static_cast<uint8_t>(false) == static_cast<uint8_t>(nullable_value_flags::is_null),
+                    "Blopp failed to cast boolean to correct nullable_value_flags. false != is_null");
+
+                static_assert(static_cast<uint8_t>(true) == static_cast<uint8_t>(nullable_value_flags::has_value),
+                    "Blopp failed to cast boolean to correct nullable_value_flags. true != has_value");
+
+                m_output.append(static_cast<uint8_t>(has_value));
+                return has_value;
+            }
+        }
+
+        template<bool Vvarint, typename ... T>
+        auto map_values(T& ... value) -> bool {
+            static_assert(sizeof...(value) > 0, "Cannot pass 0 parameters to map function of blopp context.");
+
+            if constexpr (sizeof...(value) == 1) {
+                if (m_error.has_value()) {
+                    return false;
+                }
+
+                ++m_property_count;
+                ((m_error = map_impl<false, Vvarint>(value)), ...);
+            }
+            else {
+                (void)((!m_error.has_value() && (++m_property_count, m_error = map_impl<false, Vvarint>(value), 1)) && ...);
+            }
+
+            if (m_property_count > max_object_property_count) {
+                m_error = write_error_code::object_property_count_overflow;
+            }
+
+            return !m_error.has_value();
+        }
+
+        template<bool Vvarint>
+        [[nodiscard]] inline auto write_fundamental(const auto& value) -> std::optional<write_error_code> {
+            if constexpr (Vvarint == true && is_varint_integer_v<std::remove_cvref_t<decltype(value)>> == true) {
+                this->write_varint_value(value);
+            }
+            else {
+                write_value(value);
+            }
+            return {};
+        }
+
+        template<bool Vvarint>
+        [[nodiscard]] inline auto write_enum(const auto& value) -> std::optional<write_error_code> {
+            using underlying_t = std::underlying_type_t<std::remove_cvref_t<decltype(value)>>;
+            if constexpr (Vvarint == true && is_varint_integer_v<underlying_t> == true) {
+                this->write_varint_value(value);
+            }
+            else {
+                write_value(static_cast<underlying_t>(value));
+            }
+            return {};
+        }
+
+        [[nodiscard]] inline auto write_string(const auto& value) -> std::optional<write_error_code> {
+            using value_t = std::remove_cvref_t<decltype(value)>;
+            using char_t = typename value_t::value_type;
+
+            constexpr auto char_size = static_cast<options_string_char_size_type>(sizeof(char_t));
+            constexpr auto max_string_size = (max_string_offset - sizeof(options_string_char_size_type)) / sizeof(char_t);
+
+            if (value.size() > max_string_size) {
+                return write_error_code::string_offset_overflow;
+            }
+
+            const auto string_offset = (value.size() * sizeof(char_t)) + sizeof(options_string_char_size_type);
+
+            this->template write_format_value<options_string_offset_type>(string_offset);
+            write_value(char_size);
+            write_contiguous_container(value);
+            return {};
+        }
+
+        template<bool Vvarint>
+        [[nodiscard]] inline auto write_shared_ptr(const auto& value) -> std::optional<write_error_code> {
+            using element_t = typename std::remove_cvref_t<decltype(value)>::element_type;
+
+            const auto key = get_reference_key(value.get());
+            const auto position = static_cast<uint64_t>(m_output.position());
+
+            m_reference_map.insert(key, position);
+            if (m_chunk_references != nullptr) {
+                m_chunk_references->values.emplace_back(key, position);
+            }
+
+            if constexpr (block_skipping_output_sink<TOutput> == true && options_reference_policy_v<TOptions> != reference_policy::none) {
+                m_output.add_reference(key, position);
+            }
+
+            // Chunks of a parallel write also check the shared values being written around their container.
+            if constexpr (options_reference_policy_v<TOptions> == reference_policy::none) {
+                if (m_reference_map.is_writing(key) || (m_parent_reference_map != nullptr && m_parent_reference_map->is_writing(key))) {
+                    return write_error_code::cyclic_shared_ptr;
+                }
+
+                m_reference_map.begin_write(key);
+                const auto error = map_impl<true, Vvarint && is_varint_value_v<element_t> == false>(*value);
+                m_reference_map.end_write();
+                return error;
+            }
+            else {
+                // Integers of shared pointers, also of nullables held by them, are never written as varints, see is_varint_value_v.
+                return map_impl<true, Vvarint && is_varint_value_v<element_t> == false>(*value);
+            }
+        }
+
+        [[nodiscard]] inline auto write_object(const auto& value) -> std::optional<write_error_code> {
+            using value_t = std::remove_cvref_t<decltype(value)>;
+       
+            auto block_offset_writer = post_output_writer<options_object_offset_type, TOutput>{ m_output, m_varint_plan };        
+            const auto block_start_position = m_output.position();
+
+            if constexpr (block_skipping_output_sink<TOutput> == true) {
+                if (block_offset_writer.skip_block()) {
+                    return {};
+                }
+            }
+
+            auto property_count_writer = post_output_writer<options_object_property_count_type, TOutput>{ m_output, m_varint_plan };      
+ 
+            auto object_write_context = write_context{ m_output, m_reference_map, m_varint_plan };
+            object_write_context.m_depth = m_depth;
+            object_write_context.m_parent_reference_map = m_parent_reference_map;
+            object_write_context.m_chunk_references = m_chunk_references;
+
+            using object_map_result_t = decltype(object<value_t>::map(object_write_context, value));
+
+            if constexpr (std::is_same_v<object_map_result_t, void> == true) {
+                object<value_t>::map(object_write_context, value);
+            }
+            else if constexpr (std::is_same_v<object_map_result_t, bool> == true) {
+                if (!object<value_t>::map(object_write_context, value)) {
+                    return write_error_code::user_defined_failure;
+                };
+            }
+            else {
+                static_assert(always_false<value_t>, "Only void and bool return type of blopp::object<T>::map is supported.");
+            }
+
+            if (object_write_context.m_error) {
+                return object_write_context.m_error.value();
+            }
+ 
+            // Updated before the block offset is taken, as the property count is part of the block.
+            const auto property_count = object_write_context.m_property_count;
+            property_count_writer.update(static_cast<format_value_t<options_object_property_count_type>>(property_count));
+
+            const auto block_offset = m_output.position() - block_start_position;
+            if (block_offset > max_object_offset) {
+                return write_error_code::object_offset_overflow;
+            }
+
+            block_offset_writer.update(static_cast<format_value_t<options_object_offset_type>>(block_offset));
+
+            return {};
+        }
+
+        template<bool Vvarint>
+        [[nodiscard]] inline auto write_list(const auto& value) -> std::optional<write_error_code> {
+            using value_t = std::remove_cvref_t<decltype(value)>;
+            using element_t = typename value_t::value_type;
+            using element_fundamental_traits = fundamental_traits<element_t>;
+
+            const auto element_count = value.size();
+            if (element_count > max_list_element_count) {
+                return write_error_code::list_element_count_overflow;
+            }
+
+            auto block_offset_writer = post_output_writer<options_list_offset_type, TOutput>{ m_output, m_varint_plan };
+            const auto block_start_position = m_output.position();
+
+            if constexpr (block_skipping_output_sink<TOutput> == true) {
+                if (block_offset_writer.skip_block()) {
+                    return {};
+                }
+            }
+
+            // Elements of fixed size are located without an index.
+            constexpr auto element_has_index = 
+                options_list_element_index == true &&
+                element_fundamental_traits::is_fundamental == false &&
+                std::is_enum_v<element_t> == false;
+
+            constexpr auto element_is_nullable = is_nullable_v<element_t>;
+            if constexpr (element_has_index == true) {
+                const auto element_data_type = static_cast<uint8_t>(static_cast<uint8_t>(get_value_data_type<element_t, Vvarint>()) | list_element_index_flag);
+                this->template write_data_type<element_is_nullable>(static_cast<data_types>(element_data_type));
+            }
+            else {
+                this->template write_data_type<element_is_nullable>(get_value_data_type<element_t, Vvarint>());
+            }
+
+            this->template write_format_value<options_list_element_count_type>(element_count);
+
+            // Varints and elements without contiguous storage are written per element by block skipping outputs,
+            // to resume at the planned element before the window.
+            constexpr auto element_is_varint = Vvarint == true && is_varint_integer_v<element_t> == true;
+            constexpr auto element_is_resumed = 
+                block_skipping_output_sink<TOutput> == true && 
+                (element_is_varint == true || std::contiguous_iterator<typename value_t::iterator> == false);
+
+            if constexpr (element_is_varint == true && element_is_resumed == true) {
+                auto error = write_elements(value, [](auto& context, const auto& element_value) -> std::optional<write_error_code> {
+                    context.write_varint_value(element_value);
+                    return {};
+                });
+
+                if (error.has_value()) {
+                    return error;
+                }
+            }
+            else if constexpr (element_is_varint == true) {
+                this->write_varint_container(value);
+            }
+            else if constexpr (element_fundamental_traits::is_fundamental == true) {
+                if constexpr (std::contiguous_iterator<typename value_t::iterator> == true)
+                {
+                    write_contiguous_container(value);
+                }
+                else if constexpr (element_is_resumed == true) {
+                    auto error = write_elements(value, [](auto& context, const auto& element_value) -> std::optional<write_error_code> {
+                        context.write_value(static_cast<const element_t>(element_value));
+                        return {};
+                    });
+
+                    if (error.has_value()) {
+                        return error;
+                    }
+                }
+                else {
+                    for (const auto element_value : value) {
+                        write_value(static_cast<const element_t>(element_value));
+                    }
+                }
+            }
+            else {
+                const auto elements_position = m_output.position();
+                [[maybe_unused]] const auto elements_sequence = get_elements_sequence();
+
+                auto element_positions = std::vector<size_t>{};
+                if constexpr (element_has_index == true && block_skipping_output_sink<TOutput> == false) {
+                    element_positions.reserve(element_count);
+                }
+
+                auto error = write_elements(value, [](auto& context, const auto& element_value) {
+                    return context.template map_impl<true, Vvarint>(element_value);
+                }, element_has_index ? &element_positions : nullptr);
+
+                if (error.has_value()) {
+                    return error;
+                }
+
+                // Block skipping outputs write offsets from the planned elements, as they don't write every element.
+                if constexpr (element_has_index == true && block_skipping_output_sink<TOutput> == true) {
+                    m_output.template append_element_offsets<options_list_element_offset_type>(elements_sequence, elements_position, element_count);
+                }
+
+                for (const auto element_position : element_positions) {
+                    write_value(static_cast<options_list_element_offset_type>(element_position - elements_position));
+                }
+            }
+
+            const auto block_offset = m_output.position() - block_start_position;
+            if (block_offset > max_list_offset) {
+                return write_error_code::list_offset_overflow;
+            }
+
+            block_offset_writer.update(static_cast<format_value_t<options_list_offset_type>>(block_offset));
+
+            return {};
+        }
+
+        template<bool Vvarint>
+        [[nodiscard]] inline auto write_map(const auto& value) -> std::optional<write_error_code> {
+            using value_t = std::remove_cvref_t<decltype(value)>;
+            using key_t = typename value_t::key_type;
+            using mapped_t = typename value_t::mapped_type;
+
+            const auto element_count = value.size();
+            if (element_count > max_map_element_count) {
+                return write_error_code::map_element_count_overflow;
+            }
+
+            auto block_offset_writer = post_output_writer<options_map_offset_type, TOutput>{ m_output, m_varint_plan };
+            const auto block_start_position = m_output.position();
+
+            if constexpr (block_skipping_output_sink<TOutput> == true) {
+                if (block_offset_writer.skip_block()) {
+                    return {};
+                }
+            }
+
+            constexpr auto key_is_nullable = is_nullable_v<key_t>;
+            this->template write_data_type<key_is_nullable>(get_value_data_type<key_t, Vvarint>());
+
+            constexpr auto mapped_is_nullable = is_nullable_v<mapped_t>;
+            this->template write_data_type<mapped_is_nullable>(get_value_data_type<mapped_t, Vvarint>());
+
+            this->template write_format_value<options_map_element_count_type>(element_count);
+
+            auto error = write_elements(value, [](auto& context, const auto& element_value) {
+                if (auto key_error = context.template map_impl<true, Vvarint>(element_value.first); key_error.has_value()) {
+                    return key_error;
+                }
+                return context.template map_impl<true, Vvarint>(element_value.second);
+            });
+            if (error.has_value()) {
+                return error;
+            }
+
+            const auto block_offset = m_output.position() - block_start_position;
+            if (block_offset > max_map_offset) {
+                return write_error_code::map_offset_overflow;
+            }
+
+            block_offset_writer.update(static_cast<format_value_t<options_map_offset_type>>(block_offset));
+
+            return {};
+        }
+
+        // Elements of block skipping outputs are planned by the reservation index at their start, unique to each list or map.
+        [[nodiscard]] inline size_t get_elements_sequence() const {
+            if constexpr (block_skipping_output_sink<TOutput> == true) {
+                return m_output.sequence();
+            }
+            else {
+                return 0;
+            }
+        }
+
+        // Writes elements of a list or map, in parallel chunks if enabled by parallel_write_chunk_size of the options.
+        // Output positions of the elements are added to element_positions, if not null.
+        template<typename TElementWriter>
+        [[nodiscard]] inline auto write_elements(
+            const auto& value,
+            const TElementWriter& write_element,
+            std::vector<size_t>* element_positions = nullptr) -> std::optional<write_error_code>
+        {
+            if constexpr (block_skipping_output_sink<TOutput> == true) {
+                return write_elements_in_window(value, write_element, element_positions != nullptr);
+            }
+
+            // Varints are written in the order planned, so containers with varint offsets are written serially.
+            if constexpr (
+                options_parallel_write_chunk_size > 0 &&
+                block_skipping_output_sink<TOutput> == false &&
+                options_has_varint_v<TOptions> == false)
+            {
+                // Containers nested in chunks are written serially, as the chunks are already written in parallel.
+                if (m_chunk_references == nullptr && value.size() >= options_parallel_write_chunk_size * 2) {
+                    return write_elements_in_parallel(value, write_element, element_positions);
+                }
+            }
+
+            for (const auto& element_value : value) {
+                if (element_positions != nullptr) {
+                    element_positions->push_back(m_output.position());
+                }
+                if (auto error = write_element(*this, element_value); error.has_value()) {
+                    return error;
+                }
+            }
+
+            return {};
+        }
+
+        // Writes elements of a list or map to a block skipping output, resuming at the last planned element before the window,
+        // and stopping after the window. Elements of indexed lists are all planned, to write their offsets from the plan.
+        template<typename TElementWriter>
+        [[nodiscard]] inline auto write_elements_in_window(
+            const auto& value,
+            const TElementWriter& write_element,
+            const bool is_indexed) -> std::optional<write_error_code>
+        {
+            using value_iterator_t = decltype(std::begin(value));
+
+            const auto sequence = m_output.sequence();
+            auto it = std::begin(value);
+            auto index = size_t{ 0 };
+
+            if constexpr (requires { m_output.find_element(sequence); }) {
+                if (const auto* element = m_output.find_element(sequence); element != nullptr) {
+                    m_output.resume(*element);
+                    m_varint_plan->next_index = element->varint_index;
+                    index = element->index;
+
+                    if constexpr (std::random_access_iterator<value_iterator_t> == true) {
+                        it += static_cast<std::iter_difference_t<value_iterator_t>>(index);
+                    }
+                    else {
+                        it = std::any_cast<value_iterator_t>(element->iterator);
+                    }
+                }
+            }
+
+            for (const auto end = std::end(value); it != end && !m_output.is_after_window(); ++it, ++index) {
+                m_output.add_element(sequence, index, m_varint_plan->next_index, it, is_indexed);
+
+                if (auto error = write_element(*this, *it); error.has_value()) {
+                    return error;
+                }
+            }
+
+            return {};
+        }
+
+        template<typename TElementWriter>
+        [[nodiscard]] inline auto write_elements_in_parallel(
+            const auto& value,
+            const TElementWriter& write_element,
+            std::vector<size_t>* element_positions) -> std::optional<write_error_code>
+        {
+            using value_iterator_t = decltype(std::begin(value));
+
+            const auto element_count = static_cast<size_t>(value.size());
+            const auto chunk_count = (element_count + options_parallel_write_chunk_size - 1) / options_parallel_write_chunk_size;
+
+            auto chunks = std::vector<write_chunk>(chunk_count);
+            for (size_t i = 0; i < chunk_count; ++i) {
+                chunks[i].first_element_index = i * options_parallel_write_chunk_size;
+                chunks[i].element_count = std::min(options_parallel_write_chunk_size, element_count - chunks[i].first_element_index);
+            }
+
+            // Chunks of containers without random access start where the previous chunk ends.
+            auto chunk_begins = std::vector<value_iterator_t>{};
+            if constexpr (std::random_access_iterator<value_iterator_t> == false) {
+                chunk_begins.reserve(chunk_count);
+                auto it = std::begin(value);
+                for (const auto& chunk : chunks) {
+                    chunk_begins.push_back(it);
+                    std::advance(it, chunk.element_count);
+                }
+            }
+
+            auto get_chunk_begin = [&](const size_t chunk_index) {
+                if constexpr (std::random_access_iterator<value_iterator_t> == true) {
+                    return std::begin(value) + chunks[chunk_index].first_element_index;
+                }
+                else {
+                    return chunk_begins[chunk_index];
+                }
+            };
+
+            // The reference map is only read while chunks are written. References to values of the chunk itself 
+            // are written relative to the chunk, and relocated when the chunk is appended to the output.
+            options_write_executor::run(chunk_count, [&](const size_t chunk_index) {
+                auto& chunk = chunks[chunk_index];
+                auto chunk_sink = vector_output_sink<>{ chunk.output };
+                auto chunk_reference_map = write_reference_map<TOptions>{};
+                auto chunk_context = chunk_write_context{ chunk_sink, chunk_reference_map };
+                chunk_context.m_depth = m_depth;
+                chunk_context.m_parent_reference_map = &m_reference_map;
+                chunk_context.m_chunk_references = &chunk.references;
+
+                auto it = get_chunk_begin(chunk_index);
+                for (size_t i = 0; i < chunk.element_count; ++i, ++it) {
+                    if (element_positions != nullptr) {
+                        chunk.element_positions.push_back(chunk_sink.position());
+                    }
+                    if (chunk.error = write_element(chunk_context, *it); chunk.error.has_value()) {
+                        return;
+                    }
+                }
+            });
+
+            for (size_t chunk_index = 0; chunk_index < chunk_count; ++chunk_index) {
+                auto& chunk = chunks[chunk_index];
+
+                // Values already written by previous chunks must be written as references, as by serial writes, 
+                // so chunks sharing values with previous chunks are written again, serially.
+                const auto shares_values = std::any_of(chunk.references.values.begin(), chunk.references.values.end(), 
+                    [&](const auto& reference) { return m_reference_map.find(reference.first) != nullptr; });
+
+                if (shares_values) {
+                    auto it = get_chunk_begin(chunk_index);
+                    for (size_t i = 0; i < chunk.element_count; ++i, ++it) {
+                        if (element_positions != nullptr) {
+                            element_positions->push_back(m_output.position());
+                        }
+                        if (auto error = write_element(*this, *it); error.has_value()) {
+                            return error;
+                        }
+                    }
+                    continue;
+                }
+
+                if (chunk.error.has_value()) {
+                    return chunk.error;
+                }
+
+                const auto chunk_position = static_cast<uint64_t>(m_output.position());
+
+                for (const auto relocation : chunk.references.relocations) {
+                    auto position = uint64_t{};
+                    std::memcpy(&position, chunk.output.data() + relocation, sizeof(position));
+                    position += chunk_position;
+                    std::memcpy(chunk.output.data() + relocation, &position, sizeof(position));
+                }
+
+                m_output.append(chunk.output.data(), chunk.output.size());
+
+                if (element_positions != nullptr) {
+                    for (const auto element_position : chunk.element_positions) {
+                        element_positions->push_back(chunk_position + element_position);
+                    }
+                }
+
+                for (const auto& [key, position] : chunk.references.values) {
+                    m_reference_map.insert(key, chunk_position + position);
+                }
+            }
+
+            return {};
+        }
+
+        template<bool Vvarint>
+        [[nodiscard]] inline auto write_variant(const auto& value) -> std::optional<write_error_code> {
+            const auto index = value.index();    
+            this->template write_format_value<options_variant_index_type>(index);
+
+            return std::visit([&](const auto& variant_value) {
+                return map_impl<false, Vvarint>(variant_value);
+            }, value);
+        }
+
+        [[nodiscard]] inline auto write_formatted(const auto& value) -> std::optional<write_error_code> {
+            using value_t = std::remove_cvref_t<decltype(value)>;
+
+            auto block_size_writer = post_output_writer<options_format_size_type, TOutput>{ m_output, m_varint_plan };            
+            const auto block_start_position = m_output.position();
+
+            if constexpr (block_skipping_output_sink<TOutput> == true) {
+                if (block_size_writer.skip_block()) {
+                    return {};
+                }
+            }
+
+            auto format_write_context = write_format_context<TOptions, TOutput>{ m_output };
+
+            using object_format_result_t = decltype(object<value_t>::format(format_write_context, value));
+
+            if constexpr (std::is_same_v<object_format_result_t, void> == true) {
+                object<value_t>::format(format_write_context, value);
+
+                if (auto format_error = format_write_context.error(); format_error.has_value()) {
+                    return format_error.value();
+                }
+            }
+            else if constexpr (std::is_same_v<object_format_result_t, bool> == true) {
+                const auto format_result = object<value_t>::format(format_write_context, value);
+                
+                if (auto format_error = format_write_context.error(); format_error.has_value()) {
+                    return format_error.value();
+                }
+                if (!format_result) {
+                    return write_error_code::user_defined_failure;
+                }
+            }
+            else {
+                static_assert(always_false<value_t>, "Only void and bool return type of blopp::object<T>::format is supported.");
+            }
+
+            const auto block_size = static_cast<options_format_size_type>(m_output.position() - block_start_position);
+            block_size_writer.update(block_size);
+
+            return {};
+        }
+
+        // Writes value, with its integers as varints if Vvarint is set.
+        template<bool Vskip_data_type, bool Vvarint = options_varint_integers>
+        [[nodiscard]] inline auto map_impl(auto& value) -> std::optional<write_error_code> {
+            using value_t = std::remove_cvref_t<decltype(value)>;
+            using value_fundamental_traits = fundamental_traits<value_t>;
+
+            constexpr auto value_is_nullable = is_nullable_v<value_t>;
+
+            if constexpr (Vskip_data_type == false) {
+                this->template write_data_type<value_is_nullable>(get_value_data_type<value_t, Vvarint>());
+            }
+
+            if constexpr (value_is_nullable == true) {
+                if (!write_nullable_value_flags(value)) {
+                    return {};
+                }
+            }
+
+            if constexpr (
+                value_fundamental_traits::is_fundamental == true ||
+                std::is_enum_v<value_t> == true ||
+                is_std_string_v<value_t> == true ||
+                is_std_string_view_v<value_t> == true ||
+                options_max_depth == std::numeric_limits<size_t>::max())
+            {
+                return write_payload<Vvarint>(value);
+            }
+            else {
+                // Nested values are limited to the max_depth of options, to fail instead of overflowing the stack.
+                if (m_depth == options_max_depth) {
+                    return write_error_code::max_depth_exceeded;
+                }
+
+                ++m_depth;
+                const auto error = write_payload<Vvarint>(value);
+                --m_depth;
+                return error;
+            }
+        }
+
+        template<bool Vvarint>
+        [[nodiscard]] inline auto write_payload(auto& value) -> std::optional<write_error_code> {
+            using value_t = std::remove_cvref_t<decltype(value)>;
+            using value_fundamental_traits = fundamental_traits<value_t>;
+
+            if constexpr (value_fundamental_traits::is_fundamental == true) {
+                return write_fundamental<Vvarint>(value);
+            }
+            else if constexpr (std::is_enum_v<value_t> == true) {
+                return write_enum<Vvarint>(value);
+            }
+            else if constexpr (
+                is_std_string_v<value_t> == true ||
+                is_std_string_view_v<value_t> == true)
+            {
+                return write_string(value);
+            }
+            else if constexpr (
+                is_std_unique_ptr_v<value_t> == true ||
+                is_std_optional_v<value_t> == true)
+            {
+                return map_impl<true, Vvarint>(*value);
+            }
+            else if constexpr (is_std_shared_ptr_v<value_t> == true) {
+                return write_shared_ptr<Vvarint>(value);
+            }
+            else if constexpr (
+                is_std_array_v<value_t> == true ||
+                is_std_vector_v<value_t> == true ||
+                is_std_list_v<value_t> == true ||
+                is_std_const_span_v<value_t> == true)
+            {
+                return write_list<Vvarint>(value);
+            }
+            else if constexpr (std::is_array_v<value_t> == true) {
+                return write_list<Vvarint>(std::span(value));
+            }
+            else if constexpr (is_std_map_v<value_t> == true) {
+                return write_map<Vvarint>(value);
+            }
+            else if constexpr (is_std_variant_v<value_t> == true) {
+                return write_variant<Vvarint>(value);
+            }
+            else if constexpr (object_is_mapped<value_t>() == true) {
+                return write_object(value);
+            }
+            else if constexpr (object_is_formatted<value_t>() == true) {
+                return write_formatted(value);
+            }
+            else {
+                static_assert(always_false<value_t>, "Unmapped blopp data type.");
+            }
+        }
+
+        std::optional<write_error_code> m_error = {};
+        size_t m_property_count = 0;
+        size_t m_depth = 0;
+        write_reference_map<TOptions>& m_reference_map;
+        const write_reference_map<TOptions>* m_parent_reference_map = nullptr;
+        write_chunk_references* m_chunk_references = nullptr;
+        varint_plan* m_varint_plan;
+
+    };
+
+    // Writes value in a single pass, writing varints as planned, or planning them if plan is planning.
+    template<typename TOptions, typename T, typename TOutputSink>
+    [[nodiscard]] auto write_pass(const T& value, TOutputSink& output_sink, varint_plan& plan) -> std::optional<write_error_code> {
+        write_reference_map<TOptions> reference_map = {};
+
+        auto context = write_context<TOptions, TOutputSink>{
+            output_sink,
+            reference_map,
+            &plan
+        };
+
+        context.map(value);
+
+        if (auto error = context.error(); error) {
+            return error;
+        }
+
+        // Values written differently than planned, e.g. by a non-deterministic format, would be written with wrong varints.
+        if (plan.is_mismatching) {
+            return write_error_code::mismatching_varint_plan;
+        }
+
+        return output_sink.error();
+    }
+
+    // Writes value by a single pass, with varints planned by plan_varints.
+    template<typename TOptions, typename T, typename TOutputSink>
+    [[nodiscard]] auto write_planned(const T& value, TOutputSink& output_sink, varint_plan_values& plan_values) -> std::optional<write_error_code> {
+        auto plan = varint_plan{ plan_values };
+        return write_pass<TOptions>(value, output_sink, plan);
+    }
+
+    // Plans varints of value written after their blocks, and returns the size of value.
+    template<typename TOptions, typename T>
+    [[nodiscard]] auto plan_varints(const T& value, varint_plan_values& plan_values) -> expected<size_t, write_error_code> {
+        auto output_sink = counting_output_sink{};
+        auto plan = varint_plan{ plan_values, true };
+
+        if (auto error = write_pass<TOptions>(value, output_sink, plan); error) {
+            return make_unexpected<size_t, write_error_code>(error.value());
+        }
+
+        return output_sink.position();
+    }
+
+    // Input made of several segments, read as if they were one contiguous span.
+    class segmented_input {
+
+    public:
+
+        segmented_input() = default;
+
+        explicit segmented_input(std::span<const read_input_type> segments) :
+            m_segments{ segments }
+        {
+            for (const auto& segment : segments) {
+                m_size += segment.size();
+            }
+            advance(0);
+        }
+
+        [[nodiscard]] size_t size() const {
+            return m_size;
+        }
+
+        [[nodiscard]] bool empty() const {
+            return m_size == 0;
+        }
+
+        // Position from the start of the first segment.
+        [[nodiscard]] size_t position() const {
+            return m_position;
+        }
+
+        [[nodiscard]] segmented_input subspan(const size_t offset) const {
+            auto result = *this;
+            result.advance(offset);
+            return result;
+        }
+
+        [[nodiscard]] segmented_input subspan(const size_t offset, const size_t count) const {
+            auto result = subspan(offset);
+            result.m_size = count;
+            return result;
+        }
+
+        [[nodiscard]] uint8_t front() const {
+            return m_segments.front()[m_offset];
+        }
+
+        // Returns pointer to the next count bytes if they are within the same segment, otherwise nullptr.
+        [[nodiscard]] const uint8_t* contiguous_data(const size_t count) const {
+            if (m_segments.empty() || m_segments.front().size() - m_offset < count) {
+                return nullptr;
+            }
+            return m_segments.front().data() + m_offset;
+        }
+
+        // Calls function with each contiguous piece of the next count bytes.
+        template<typename TFunction>
+        void visit(size_t count, TFunction&& function) const {
+            auto segments = m_segments;
+            auto offset = m_offset;
+
+            while (count > 0) {
+                const auto& segment = segments.front();
+                const auto piece_size = std::min(count, segment.size() - offset);
+
+                function(segment.data() + offset, piece_size);
+
+                count -= piece_size;
+                segments = segments.subspan(1);
+                offset = 0;
+            }
+        }
+
+    private:
+
+        void advance(const size_t count) {
+            m_size -= count;
+            m_position += count;
+            m_offset += count;
+
+            while (!m_segments.empty() && m_offset >= m_segments.front().size()) {
+                m_offset -= m_segments.front().size();
+                m_segments = m_segments.subspan(1);
+            }
+        }
+
+        std::span<const read_input_type> m_segments = {};
+        size_t m_offset = 0;
+        size_t m_size = 0;
+        size_t m_position = 0;
+
+    };
+
+    // Returns true if all bytes are 0 or 1, the only valid values of bool.
+    [[nodiscard]] inline bool has_only_bool_values(const uint8_t* data, const size_t size) {
+        size_t i = 0;
+
+#if defined(BLOPP_HAS_AVX2)
+        const auto avx2_mask = _mm256_set1_epi8(static_cast<char>(0xFE));
+        for (; i + 32 <= size; i += 32) {
+            const auto block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+            if (!_mm256_testz_si256(block, avx2_mask)) {
+                return false;
+            }
+        }
+#endif
+
+#if defined(BLOPP_HAS_SSE2)
+        const auto sse2_mask = _mm_set1_epi8(static_cast<char>(0xFE));
+        const auto sse2_zero = _mm_setzero_si128();
+        for (; i + 16 <= size; i += 16) {
+            const auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+            const auto is_zero = _mm_cmpeq_epi8(_mm_and_si128(block, sse2_mask), sse2_zero);
+            if (_mm_movemask_epi8(is_zero) != 0xFFFF) {
+                return false;
+            }
+        }
+#endif
+
+        for (; i + 8 <= size; i += 8) {
+            auto word = uint64_t{};
+            std::memcpy(&word, data + i, sizeof(word));
+            if ((word & uint64_t{ 0xFEFEFEFEFEFEFEFE }) != 0) {
+                return false;
+            }
+        }
+
+        for (; i < size; i++) {
+            if (data[i] > 1) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+#if defined(BLOPP_HAS_SSSE3)
+
+    // Shuffle of 8 bytes of varints, of up to lane size bytes each, into lanes of 16 bytes, looked up by the continuation bits of the bytes.
+    struct varint_shuffle {
+        uint8_t indices[16] = {};
+        uint8_t count = 0; // Count of varints entirely within the 8 bytes and the lanes, up to the first varint longer than a lane.
+        uint8_t size = 0; // Size of the varints shuffled.
+    };
+
+    template<size_t Vlane_size>
+    [[nodiscard]] constexpr auto make_varint_shuffle_table() {
+        auto table = std::array<varint_shuffle, 256>{};
+
+        for (size_t mask = 0; mask < table.size(); mask++) {
+            auto& shuffle = table[mask];
+            for (auto& index : shuffle.indices) {
+                index = 0x80; // Zeroes the byte.
+            }
+
+            size_t position = 0;
+            size_t count = 0;
+            while (position < 8 && count < 16 / Vlane_size) {
+                auto varint_size = size_t{ 1 };
+                while (position + varint_size <= 8 && ((mask >> (position + varint_size - 1)) & 1) != 0) {
+                    ++varint_size;
+                }
+
+                if (position + varint_size > 8 || varint_size > Vlane_size) {
+                    break;
+                }
+
+                for (size_t i = 0; i < varint_size; i++) {
+                    shuffle.indices[count * Vlane_size + i] = static_cast<uint8_t>(position + i);
+                }
+
+                position += varint_size;
+                ++count;
+            }
+
+            shuffle.count = static_cast<uint8_t>(count);
+            shuffle.size = static_cast<uint8_t>(position);
+        }
+
+        return table;
+    }
+
+    static constexpr auto varint_shuffle_16_table = make_varint_shuffle_table<2>();
+    static constexpr auto varint_shuffle_32_table = make_varint_shuffle_table<4>();
+
+#endif
+
+    // Decodes count ZigZag LEB128 varints of data into values, returning the size read in read_size. 
+    // Blocks of values below 128, a byte each, are found at once and decoded in loops of fixed length, which compilers vectorize.
+    // With SSSE3, varints of up to two bytes are shuffled into 16 bit lanes, up to 8 at once, and varints of up to four bytes
+    // into 32 bit lanes, up to 4 at once, by tables of continuation bits. Varints of five bytes or more are decoded one by one.
+    template<std::integral T, bool Vchecked>
+    [[nodiscard]] inline auto decode_varint_values(
+        const uint8_t* data,
+        const size_t size,
+        T* values,
+        const size_t count,
+        size_t& read_size) -> std::optional<read_error_code>
+    {
+        using unsigned_t = std::make_unsigned_t<T>;
+        constexpr auto value_bit_count = sizeof(T) * 8;
+
+        size_t position = 0;
+        size_t i = 0;
+
+        // Set past the 8 bytes of a varint longer than the lanes, which are decoded by the scalar decoder only, 
+        // instead of failing the blocks of the next varints too.
+        size_t scalar_end_position = 0;
+
+        while (i < count) {
+            if (position >= scalar_end_position) {
+#if defined(BLOPP_HAS_AVX2)
+                if (i + 32 <= count && position + 32 <= size) {
+                    const auto block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + position));
+                    if (_mm256_movemask_epi8(block) == 0) {
+                        for (size_t j = 0; j < 32; j++) {
+                            values[i + j] = decode_zigzag<T>(static_cast<unsigned_t>(data[position + j]));
+                        }
+                        i += 32;
+                        position += 32;
+                        continue;
+                    }
+                }
+#endif
+#if defined(BLOPP_HAS_SSE2)
+                if (i + 16 <= count && position + 16 <= size) {
+                    const auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + position));
+                    if (_mm_movemask_epi8(block) == 0) {
+                        for (size_t j = 0; j < 16; j++) {
+                            values[i + j] = decode_zigzag<T>(static_cast<unsigned_t>(data[position + j]));
+                        }
+                        i += 16;
+                        position += 16;
+                        continue;
+                    }
+                }
+#endif
+#if defined(BLOPP_HAS_SSSE3)
+                if (i + 8 <= count && position + 8 <= size) {
+                    const auto bytes = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(data + position));
+                    const auto mask = static_cast<size_t>(_mm_movemask_epi8(bytes));
+                    const auto& narrow_shuffle = varint_shuffle_16_table[mask];
+
+                    // 32 bit lanes when they take more varints than 16 bit lanes, as when the first varint is longer than two bytes.
+                    if constexpr (sizeof(T) >= 4) {
+                        const auto& wide_shuffle = varint_shuffle_32_table[mask];
+
+                        if (wide_shuffle.count > narrow_shuffle.count) {
+                            const auto indices = _mm_loadu_si128(reinterpret_cast<const __m128i*>(wide_shuffle.indices));
+                            const auto shuffled = _mm_and_si128(_mm_shuffle_epi8(bytes, indices), _mm_set1_epi32(0x7F7F7F7F));
+
+                            // Pairs of 7 bits joined into 14 bits per 16 bit half, and then the halves into 28 bits.
+                            const auto pairs = _mm_or_si128(
+                                _mm_and_si128(shuffled, _mm_set1_epi32(0x007F007F)),
+                                _mm_srli_epi32(_mm_and_si128(shuffled, _mm_set1_epi32(0x7F007F00)), 1));
+                            const auto joined = _mm_or_si128(
+                                _mm_and_si128(pairs, _mm_set1_epi32(0x00003FFF)),
+                                _mm_srli_epi32(_mm_and_si128(pairs, _mm_set1_epi32(0x3FFF0000)), 2));
+
+                            uint32_t lanes[4];
+                            _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), joined);
+
+                            // Lanes past the count are overwritten by the values following.
+                            for (size_t j = 0; j < 4; j++) {
+                                values[i + j] = decode_zigzag<T>(static_cast<unsigned_t>(lanes[j]));
+                            }
+
+                            i += wide_shuffle.count;
+                            position += wide_shuffle.size;
+                            continue;
+                        }
+                    }
+
+                    if (sizeof(T) >= 2 && narrow_shuffle.count != 0) {
+                        const auto indices = _mm_loadu_si128(reinterpret_cast<const __m128i*>(narrow_shuffle.indices));
+                        const auto shuffled = _mm_and_si128(_mm_shuffle_epi8(bytes, indices), _mm_set1_epi16(0x7F7F));
+
+                        // Low 7 bits of each lane's first byte, followed by the 7 bits of its second byte.
+                        const auto low_bytes = _mm_and_si128(shuffled, _mm_set1_epi16(0x00FF));
+                        const auto high_bytes = _mm_srli_epi16(_mm_andnot_si128(_mm_set1_epi16(0x00FF), shuffled), 1);
+
+                        uint16_t lanes[8];
+                        _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), _mm_or_si128(low_bytes, high_bytes));
+
+                        // Lanes past the count are overwritten by the values following.
+                        for (size_t j = 0; j < 8; j++) {
+                            values[i + j] = decode_zigzag<T>(static_cast<unsigned_t>(lanes[j]));
+                        }
+
+                        i += narrow_shuffle.count;
+                        position += narrow_shuffle.size;
+                        continue;
+                    }
+
+                    scalar_end_position = position + 8;
+                }
+#endif
+                if (i + 8 <= count && position + 8 <= size) {
+                    auto word = uint64_t{};
+                    std::memcpy(&word, data + position, sizeof(word));
+                    if ((word & uint64_t{ 0x8080808080808080 }) == 0) {
+                        for (size_t j = 0; j < 8; j++) {
+                            values[i + j] = decode_zigzag<T>(static_cast<unsigned_t>(data[position + j]));
+                        }
+                        i += 8;
+                        position += 8;
+                        continue;
+                    }
+                }
+            }
+
+            auto result = uint64_t{ 0 };
+            for (size_t shift = 0; ; shift += 7) {
+                if (position == size) {
+                    return read_error_code::insufficient_data;
+                }
+
+                const auto byte = data[position++];
+                const auto bits = static_cast<uint64_t>(byte & 0b01111111);
+                if constexpr (Vchecked == true) {
+                    if (shift + 7 > value_bit_count && (bits >> (value_bit_count - shift)) != 0) {
+                        return read_error_code::bad_varint;
+                    }
+                }
+
+                result |= bits << shift;
+
+                if ((byte & 0b10000000) == 0) {
+                    break;
+                }
+
+                if constexpr (Vchecked == true) {
+                    if (shift + 7 >= value_bit_count) {
+                        return read_error_code::bad_varint;
+                    }
+                }
+            }
+
+            values[i++] = decode_zigzag<T>(static_cast<unsigned_t>(result));
+        }
+
+        read_size = position;
+        return {};
+    }
+
+    // Returns true if data is well-formed UTF-8, without overlong encodings, surrogates or code points above U+10FFFF.
+    [[nodiscard]] inline bool is_valid_utf8(const uint8_t* data, const size_t size) {
+        size_t i = 0;
+
+        while (i < size) {
+            // Skip blocks of ASCII characters at once.
+#if defined(BLOPP_HAS_AVX2)
+            if (i + 32 <= size) {
+                const auto block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+                if (_mm256_movemask_epi8(block) == 0) {
+                    i += 32;
+                    continue;
+                }
+            }
+#endif
+#if defined(BLOPP_HAS_SSE2)
+            if (i + 16 <= size) {
+                const auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+                if (_mm_movemask_epi8(block) == 0) {
+                    i += 16;
+                    continue;
+                }
+            }
+#endif
+            if (i + 8 <= size) {
+                auto word = uint64_t{};
+                std::memcpy(&word, data + i, sizeof(word));
+                if ((word & uint64_t{ 0x8080808080808080 }) == 0) {
+                    i += 8;
+                    continue;
+                }
+            }
+
+            const auto lead = data[i];
+            if (lead < 0x80) {
+                ++i;
+                continue;
+            }
+
+            auto length = size_t{ 0 };
+            auto min_continuation = uint8_t{ 0x80 };
+            auto max_continuation = uint8_t{ 0xBF };
+
+            if (lead >= 0xC2 && lead <= 0xDF) {
+                length = 2;
+            }
+            else if (lead >= 0xE0 && lead <= 0xEF) {
+                length = 3;
+                if (lead == 0xE0) {
+                    min_continuation = 0xA0;
+                }
+                else if (lead == 0xED) {
+                    max_continuation = 0x9F;
+                }
+            }
+            else if (lead >= 0xF0 && lead <= 0xF4) {
+                length = 4;
+                if (lead == 0xF0) {
+                    min_continuation = 0x90;
+                }
+                else if (lead == 0xF4) {
+                    max_continuation = 0x8F;
+                }
+            }
+            else {
+                return false;
+            }
+
+            if (size - i < length) {
+                return false;
+            }
+
+            if (data[i + 1] < min_continuation || data[i + 1] > max_continuation) {
+                return false;
+            }
+
+            for (size_t j = 2; j < length; j++) {
+                if ((data[i + j] & 0xC0) != 0x80) {
+                    return false;
+                }
+            }
+
+            i += length;
+        }
+
+        return true;
+    }
+
+    template<typename TInput, bool Vchecked = true>
+    class read_context_base {
+
+    protected:
+
+        static constexpr auto input_is_contiguous = std::is_same_v<TInput, read_input_type>;
+
+        explicit read_context_base(TInput& input) :
+            m_input{ input }
+        {}
+
+        [[nodiscard]] inline bool has_bytes_left(const size_t count)
+        {
+            if constexpr (Vchecked == false) {
+                return true;
+            }
+
+            return m_input.size() >= count;
+        }
+
+        template<typename T>
+        [[nodiscard]] inline bool has_bytes_left(const size_t count)
+        {
+            if constexpr (Vchecked == false) {
+                return true;
+            }
+
+            constexpr auto max_count = std::numeric_limits<size_t>::max() / sizeof(T);
+
+            if (count > max_count) {
+                return false;
+            }
+
+            return m_input.size() >= (count * sizeof(T));
+        }
+
+        [[nodiscard]] inline uint8_t peek_byte() const {
+            if constexpr (input_is_contiguous == true) {
+                return *m_input.data();
+            }
+            else {
+                return m_input.front();
+            }
+        }
+
+        // Copies the next size bytes, piece by piece for segmented input, without consuming them.
+        inline void copy_input(void* destination, const size_t size) const {
+            if constexpr (input_is_contiguous == true) {
+                std::memcpy(destination, m_input.data(), size);
+            }
+            else {
+                auto* destination_ptr = static_cast<uint8_t*>(destination);
+                m_input.visit(size, [&](const uint8_t* data, const size_t piece_size) {
+                    std::memcpy(destination_ptr, data, piece_size);
+                    destination_ptr += piece_size;
+                });
+            }
+        }
+
+        [[nodiscard]] inline data_types read_data_type() {
+            auto next_byte_without_flag = static_cast<uint8_t>(peek_byte() & 0b01111111);
+            m_input = m_input.subspan(sizeof(uint8_t));
+            return static_cast<data_types>(next_byte_without_flag);
+        }
+
+        [[nodiscard]] inline uint8_t read_nullable_value_flags() {
+            auto value = static_cast<uint8_t>(peek_byte() & 0b00000011);
+            m_input = m_input.subspan(sizeof(uint8_t));
+            return value;
+        }
+
+        [[nodiscard]] inline std::pair<data_types, bool> read_data_type_with_nullable_flag() {
+            auto next_byte = peek_byte();
+            auto next_byte_without_flag = static_cast<uint8_t>(next_byte & 0b01111111);
+            auto flag = static_cast<bool>(next_byte & 0b10000000);
+            m_input = m_input.subspan(sizeof(uint8_t));
+            return { static_cast<data_types>(next_byte_without_flag), flag };
+        }
+
+        // Reads element data type of a list, with the nullable flag and the flag of an element index following the elements.
+        [[nodiscard]] inline std::tuple<data_types, bool, bool> read_list_element_data_type() {
+            const auto has_element_index = static_cast<bool>(peek_byte() & list_element_index_flag);
+            const auto [data_type, nullable_flag] = read_data_type_with_nullable_flag();
+            const auto data_type_without_flag = static_cast<uint8_t>(static_cast<uint8_t>(data_type) & ~list_element_index_flag);
+            return { static_cast<data_types>(data_type_without_flag), nullable_flag, has_element_index };
+        }
+
+        template<typename T>
+        inline void read_value(T& value) {
+            if constexpr (sizeof(T) == 1) {
+                value = static_cast<T>(peek_byte());
+            }
+            else {
+                copy_input(&value, sizeof(T));
+            }
+            m_input = m_input.subspan(sizeof(T));
+        }
+
+        template<typename T>
+        [[nodiscard]] inline T read_value() {
+            auto value = T{};
+            read_value(value);
+            return value;
+        }
+
+        // Reads an offset, count or index of binary format type T. Values of fixed size must be checked to be left by the caller.
+        template<typename T>
+        [[nodiscard]] inline auto read_format_value(size_t& value) -> std::optional<read_error_code> {
+            if constexpr (is_varint_v<T> == true) {
+                return read_varint<format_value_t<T>>(value);
+            }
+            else {
+                value = static_cast<size_t>(read_value<T>());
+                return {};
+            }
+        }
+
+        // Reads an unsigned LEB128 varint, holding a value of up to T.
+        template<typename T, typename TValue>
+        [[nodiscard]] inline auto read_varint(TValue& value) -> std::optional<read_error_code> {
+            constexpr auto value_bit_count = sizeof(T) * 8;
+
+            auto result = uint64_t{ 0 };
+            for (size_t shift = 0; ; shift += 7) {
+                if (!has_bytes_left(sizeof(uint8_t))) {
+                    return read_error_code::insufficient_data;
+                }
+
+                const auto byte = peek_byte();
+                m_input = m_input.subspan(sizeof(uint8_t));
+
+                const auto bits = static_cast<uint64_t>(byte & 0b01111111);
+                if constexpr (Vchecked == true) {
+                    if (shift + 7 > value_bit_count && (bits >> (value_bit_count - shift)) != 0) {
+                        return read_error_code::bad_varint;
+                    }
+                }
+
+                result |= bits << shift;
+
+                if ((byte & 0b10000000) == 0) {
+                    break;
+                }
+
+                if constexpr (Vchecked == true) {
+                    if (shift + 7 >= value_bit_count) {
+                        return read_error_code::bad_varint;
+                    }
+                }
+            }
+
+            value = static_cast<TValue>(result);
+            return {};
+        }
+
+        // Reads integer or enum written as ZigZag LEB128 varint.
+        template<typename T>
+        [[nodiscard]] inline auto read_varint_value(T& value) -> std::optional<read_error_code> {
+            using integer_t = varint_integer_t<T>;
+            using unsigned_t = std::make_unsigned_t<integer_t>;
+
+            auto encoded_value = unsigned_t{ 0 };
+            if (auto error = read_varint<unsigned_t>(encoded_value); error.has_value()) {
+                return error;
+            }
+
+            value = static_cast<T>(decode_zigzag<integer_t>(encoded_value));
+            return {};
+        }
+
+        // Reads count integers or enums written as ZigZag LEB128 varints, within the next size bytes.
+        template<typename TContainer>
+        [[nodiscard]] inline auto read_varint_container(TContainer& container, const size_t count, const size_t size) -> std::optional<read_error_code> {
+            using container_t = std::remove_cvref_t<decltype(container)>;
+            using element_t = typename container_t::value_type;
+            using integer_t = varint_integer_t<element_t>;
+
+            if (count == 0) {
+                return {};
+            }
+
+            if constexpr (
+                input_is_contiguous == true &&
+                std::contiguous_iterator<typename TContainer::iterator> == true)
+            {
+                auto* values = static_cast<integer_t*>(nullptr);
+                if constexpr (
+                    is_std_array_v<container_t> == true ||
+                    is_std_span_v<container_t> == true)
+                {
+                    values = reinterpret_cast<integer_t*>(container.data());
+                }
+                else {
+                    const size_t old_container_size = container.size();
+                    container.resize(old_container_size + count);
+                    values = reinterpret_cast<integer_t*>(container.data() + old_container_size);
+                }
+
+                auto read_size = size_t{ 0 };
+                if (auto error = decode_varint_values<integer_t, Vchecked>(m_input.data(), size, values, count, read_size); error.has_value()) {
+                    return error;
+                }
+
+                m_input = m_input.subspan(read_size);
+            }
+            else if constexpr (
+                is_std_array_v<container_t> == true ||
+                is_std_span_v<container_t> == true)
+            {
+                for (size_t i = 0; i < count; ++i) {
+                    if (auto error = read_varint_value(container[i]); error.has_value()) {
+                        return error;
+                    }
+                }
+            }
+            else {
+                for (size_t i = 0; i < count; ++i) {
+                    auto value = element_t{};
+                    if (auto error = read_varint_value(value); error.has_value()) {
+                        return error;
+                    }
+                    container.push_back(value);
+                }
+            }
+
+            return {};
+        }
+
+        template<typename TContainer>
+        [[nodiscard]] inline auto read_bool_container(TContainer& container, const size_t count) -> std::optional<read_error_code> {
+            using container_t = std::remove_cvref_t<decltype(container)>;
+            using element_t = typename container_t::value_type;
+
+            static_assert(std::is_same_v<element_t, bool>, "Wrong element type for blopp::read_bool_container");
+
+            static_assert(sizeof(bool) == 1, "Blopp requires bool to be stored in one byte.");
+
+            const auto old_container_size = container.size();
+            if constexpr (is_std_vector_v< container_t> == true) {
+                resize_add_container(container, count);
+            }
+
+            // Pieces are validated as a whole before being copied, bytewise only for bit packed std::vector<bool>.
+            auto read_piece = [&](const uint8_t* src_element_ptr, const size_t piece_size, const size_t first_index) -> bool {
+                if constexpr (Vchecked == true) {
+                    if (!has_only_bool_values(src_element_ptr, piece_size)) {
+                        return false;
+                    }
+                }
+
+                if constexpr (
+                    is_std_array_v<container_t> == true ||
+                    is_std_span_v<container_t> == true)
+                {
+                    std::memcpy(container.data() + first_index, src_element_ptr, piece_size);
+                }
+                else if constexpr (is_std_vector_v<container_t> == true) {
+                    for (size_t i = 0; i < piece_size; i++) {
+                        container[old_container_size + first_index + i] = src_element_ptr[i] != 0;
+                    }
+                }
+                else {
+                    for (size_t i = 0; i < piece_size; i++) {
+                        container.push_back(src_element_ptr[i] != 0);
+                    }
+                }
+                return true;
+            };
+
+            if constexpr (input_is_contiguous == true) {
+                if (!read_piece(m_input.data(), count, 0)) {
+                    return read_error_code::bad_boolean_value;
+                }
+            }
+            else {
+                auto is_valid = true;
+                auto first_index = size_t{ 0 };
+                m_input.visit(count, [&](const uint8_t* data, const size_t piece_size) {
+                    is_valid = is_valid && read_piece(data, piece_size, first_index);
+                    first_index += piece_size;
+                });
+
+                if (!is_valid) {
+                    return read_error_code::bad_boolean_value;
+                }
+            }
+
+            return {};
+        }
+
+        [[nodiscard]] inline bool has_valid_bool_values(const size_t count) const {
+            auto is_valid = true;
+            auto validate_piece = [&](const uint8_t* data, const size_t piece_size) {
+                is_valid = is_valid && has_only_bool_values(data, piece_size);
+            };
+
+            if constexpr (input_is_contiguous == true) {
+                validate_piece(m_input.data(), count);
+            }
+            else {
+                m_input.visit(count, validate_piece);
+            }
+
+            return is_valid;
+        }
+
+        template<typename TContainer>
+        [[nodiscard]] inline auto read_container(TContainer& container, const size_t count) -> std::optional<read_error_code> {
+            using container_t = std::remove_cvref_t<decltype(container)>;
+            using element_t = typename container_t::value_type;
+
+            if (count == 0) {
+                return {};
+            }
+
+            if constexpr (std::is_same_v<element_t, bool> == true) {
+                if (auto error = read_bool_container(container, count); error.has_value()) {
+                    return error;
+                }
+            }
+            else if constexpr (
+                is_std_array_v<container_t> == true ||
+                is_std_span_v<container_t> == true)
+            {
+                auto* dest_element_ptr = container.data();
+                copy_input(dest_element_ptr, count * sizeof(element_t));
+            }
+            else if constexpr (std::contiguous_iterator<typename TContainer::iterator> == true) {
+                const size_t old_container_size = container.size();
+                container.resize(old_container_size + count);
+                auto* dest_element_ptr = container.data() + old_container_size;
+                copy_input(dest_element_ptr, count * sizeof(element_t));
+            }
+            else {
+                for (size_t i = 0; i < count; ++i) {
+                    container.push_back(read_value<element_t>());
+                }
+                return {};
+            }
+
+            m_input = m_input.subspan(count * sizeof(element_t));
+            return {};
+        }
+
+        template<typename T>
+        [[nodiscard]] inline auto read_view(std::span<const T>& view, const size_t count) -> std::optional<read_error_code> {
+            static_assert(std::endian::native == std::endian::little,
+                "Blopp views into the input buffer are only supported on little-endian platforms.");
+
+            if (count == 0) {
+                view = {};
+                return {};
+            }
+
+            const uint8_t* data_ptr = nullptr;
+            if constexpr (input_is_contiguous == true) {
+                data_ptr = m_input.data();
+            }
+            else {
+                data_ptr = m_input.contiguous_data(count * sizeof(T));
+                if (data_ptr == nullptr) {
+                    return read_error_code::fragmented_data;
+                }
+            }
+
+            if (reinterpret_cast<uintptr_t>(data_ptr) % alignof(T) != 0) {
+                return read_error_code::misaligned_data;
+            }
+
+            if constexpr (std::is_same_v<T, bool> == true) {
+                if (!has_only_bool_values(data_ptr, count)) {
+                    return read_error_code::bad_boolean_value;
+                }
+            }
+
+            view = std::span<const T>{ reinterpret_cast<const T*>(data_ptr), count };
+            m_input = m_input.subspan(count * sizeof(T));
+            return {};
+        }
+        
+        TInput& m_input;
+
+    };
+
+
+    template<typename TOptions, typename TInput = read_input_type, bool Vchecked = true>
+    class read_format_context: private read_context_base<TInput, Vchecked> {
+
+    private:
+
+        using base = read_context_base<TInput, Vchecked>;
+        using base::m_input;
+        using base::has_bytes_left;
+        using base::read_value;
+        using base::read_container;
+
+        using options = TOptions;
+        using options_format_size_type = typename options::format_size_type;
+        static constexpr auto max_format_size = static_cast<size_t>(std::numeric_limits<options_format_size_type>::max());
+
+    public:   
+
+        static constexpr auto direction = context_direction::write;    
+
+        explicit read_format_context(
+            TInput& input
+        ) :
+            base{ input }
+        {}
+
+        read_format_context(const read_format_context&) = delete;
+        read_format_context(read_format_context&&) = delete;
+        read_format_context& operator = (const read_format_context&) = delete;
+        read_format_context& operator = (read_format_context&&) = delete;
+
+        template<typename ... T>
+        auto format(T& ... value) -> bool {
+            static_assert(sizeof...(value) > 0,
+                "Cannot pass 0 parameters to format function of blopp context.");
+
+            constexpr auto total_variadic_size = get_total_variadic_size<T...>();
+
+            static_assert(max_format_size >= total_variadic_size,
+                "Total size of variadics passed to blopp format exceeds max format size");
+
+            (void)( ( !m_error.has_value() && format_impl(value) ) && ...);
+
+            return !m_error.has_value();
+        }
+
+        [[nodiscard]] inline auto error() const {
+            return m_error;
+        }
+
+    private:
+
+        template<typename ... T>
+        [[nodiscard]] inline static constexpr size_t get_total_variadic_size()
+        {
+            return (value_size_trait<std::remove_cvref_t<T>>::size + ...);
+        }
+
+        [[nodiscard]] inline auto read_fundamental(auto& value) -> bool {
+            using value_t = std::remove_cvref_t<decltype(value)>;
+
+            if (!has_bytes_left(sizeof(value_t)))
+            {
+                m_error = read_error_code::insufficient_data;
+                return false;
+            }
+
+            read_value(value);
+            return true;
+        }
+
+        [[nodiscard]] inline auto read_array(auto& value) -> bool {
+            using value_t = std::remove_cvref_t<decltype(value)>;
+            using element_t = typename value_t::value_type;
+            using element_fundamental_traits = fundamental_traits<element_t>;
+
+            static_assert(
+                element_fundamental_traits::is_fundamental == true ||
+                std::is_enum_v<element_t> == true,
+                "Only fundamentals and enums are supported for blopp formatting of arrays.");
+
+            if (!this->template has_bytes_left<element_t>(value.size()))
+            {
+                m_error = read_error_code::insufficient_data;
+                return false;
+            }
+
+            if (m_error = read_container(value, value.size());  m_error.has_value()) {
+                return false;
+            }
+
+            return true;
+        }
+
+        [[nodiscard]] inline auto format_impl(auto& value) -> bool {
+            using value_t = std::remove_cvref_t<decltype(value)>;
+            using value_fundamental_traits = fundamental_traits<value_t>;     
+
+            if constexpr (
+                value_fundamental_traits::is_fundamental == true ||
+                std::is_enum_v<value_t> == true)
+            {
+                return read_fundamental(value);
+            }
+            else if constexpr (is_std_array_v<value_t> == true) {
+                return read_array(value);
+            }
+            else if constexpr (std::is_array_v<value_t> == true) {
+                auto array_span = std::span(value);
+                return read_array(array_span);
+            }
+            else {
+                static_assert(always_false<value_t>, "Unmapped blopp format data type.");
+            }
+        }
+
+        std::optional<read_error_code> m_error;
+
+    };
+
+    // Steps over serialized values by their block offsets, without decoding them.
+    template<typename TOptions, typename TInput = read_input_type>
+    class view_reader : private read_context_base<TInput> {
+
+    private:
+
+        using base = read_context_base<TInput>;
+        using base::m_input;
+        using base::has_bytes_left;
+        using base::read_value;
+        using base::read_data_type_with_nullable_flag;
+        using base::read_list_element_data_type;
+        using base::read_nullable_value_flags;
+
+    public:
+
+        explicit view_reader(TInput& input) :
+            base{ input }
+        {}
+
+        view_reader(const view_reader&) = delete;
+        view_reader(view_reader&&) = delete;
+        view_reader& operator = (const view_reader&) = delete;
+        view_reader& operator = (view_reader&&) = delete;
+
+        // Reads an offset, count or index of binary format type T.
+        template<typename T>
+        [[nodiscard]] inline auto read_format_value(size_t& value) -> std::optional<read_error_code> {
+            if (!has_bytes_left(format_min_size_v<T>)) {
+                return read_error_code::insufficient_data;
+            }
+
+            return base::template read_format_value<T>(value);
+        }
+
+        [[nodiscard]] inline auto read_data_type(data_types& data_type, bool& is_nullable) -> std::optional<read_error_code> {
+            if (!has_bytes_left(sizeof(data_types))) {
+                return read_error_code::insufficient_data;
+            }
+
+            const auto [next_data_type, nullable_flag] = read_data_type_with_nullable_flag();
+            data_type = next_data_type;
+            is_nullable = nullable_flag;
+            return {};
+        }
+
+        // Moves to the referenced value if the nullable value is a shared_ptr reference.
+        [[nodiscard]] inline auto read_nullable_value(
+            const TInput root,
+            const data_types data_type,
+            const bool is_nullable,
+            bool& has_value) -> std::optional<read_error_code>
+        {
+            has_value = true;
+            if (is_nullable == false) {
+                return {};
+            }
+
+            if (!has_bytes_left(sizeof(uint8_t))) {
+                return read_error_code::insufficient_data;
+            }
+
+            const auto nullable_value_flags = read_nullable_value_flags();
+
+            has_value = nullable_value_flags & static_cast<uint8_t>(nullable_value_flags::has_value);
+            if (!has_value) {
+                return {};
+            }
+
+            if (nullable_value_flags & static_cast<uint8_t>(nullable_value_flags::is_reference)) {
+                if (!has_bytes_left(sizeof(uint64_t))) {
+                    return read_error_code::insufficient_data;
+                }
+
+                const auto position = this->template read_value<uint64_t>();
+                if (position >= root.size()) {
+                    return read_error_code::bad_reference_position;
+                }
+
+                if (auto error = validate_reference_position(root, static_cast<size_t>(position), data_type); error.has_value()) {
+                    return error;
+                }
+
+                m_input = root.subspan(static_cast<size_t>(position));
+            }
+
+            return {};
+        }
+
+        // Checks that position is the payload of a shared_ptr of data_type, within the value at the start of root, 
+        // before a reference to a value not yet read is followed. Only the blocks containing position are walked.
+        [[nodiscard]] static auto validate_reference_position(
+            const TInput root,
+            const size_t position,
+            const data_types reference_data_type) -> std::optional<read_error_code>
+        {
+            auto input = root;
+            auto reader = view_reader{ input };
+
+            const auto get_position = [&]() -> size_t {
+                if constexpr (base::input_is_contiguous == true) {
+                    return static_cast<size_t>(input.data() - root.data());
+                }
+                else {
+                    return input.position() - root.position();
+                }
+            };
+
+            // Moves input to the value of values containing position, returning false if there's none.
+            const auto find_value = [&](const size_t value_count, const auto& skip_value) {
+                for (size_t i = 0; i < value_count; i++) {
+                    const auto value_input = input;
+                    if (skip_value(i).has_value()) {
+                        return false;
+                    }
+                    if (position < get_position()) {
+                        input = value_input;
+                        return true;
+                    }
+                }
+                return false;
+            };
+
+            auto data_type = data_types::unspecified;
+            auto is_nullable = false;
+            if (reader.read_data_type(data_type, is_nullable).has_value()) {
+                return read_error_code::bad_reference_position;
+            }
+
+            while (true) {
+                if (is_nullable == true) {
+                    if (!reader.has_bytes_left(sizeof(uint8_t))) {
+                        return read_error_code::bad_reference_position;
+                    }
+
+                    const auto nullable_value_flags = reader.read_nullable_value_flags();
+                    if (!(nullable_value_flags & static_cast<uint8_t>(nullable_value_flags::has_value)) ||
+                        (nullable_value_flags & static_cast<uint8_t>(nullable_value_flags::is_reference)))
+                    {
+                        return read_error_code::bad_reference_position;
+                    }
+
+                    if (get_position() == position) {
+                        return split_varint_value_flag(data_type).first == split_varint_value_flag(reference_data_type).first ?
+                            std::nullopt :
+                            std::optional{ read_error_code::bad_reference_type };
+                    }
+                }
+
+                if (get_position() >= position) {
+                    return read_error_code::bad_reference_position;
+                }
+
+                switch (data_type) {
+                    case data_types::variant: {
+                        auto index = size_t{ 0 };
+                        if (reader.template read_format_value<options_variant_index_type>(index).has_value() ||
+                            reader.read_data_type(data_type, is_nullable).has_value())
+                        {
+                            return read_error_code::bad_reference_position;
+                        }
+                    } break;
+                    case data_types::object: {
+                        auto property_count = size_t{ 0 };
+                        auto properties = TInput{};
+                        if (reader.read_object(property_count, properties).has_value()) {
+                            return read_error_code::bad_reference_position;
+                        }
+
+                        input = properties;
+                        if (!find_value(property_count, [&](size_t) { return reader.skip_property(); }) ||
+                            reader.read_data_type(data_type, is_nullable).has_value())
+                        {
+                            return read_error_code::bad_reference_position;
+                        }
+                    } break;
+                    case data_types::list: {
+                        auto element_data_type = data_types::unspecified;
+                        auto element_is_nullable = false;
+                        auto element_count = size_t{ 0 };
+                        auto elements = TInput{};
+                        auto element_index = TInput{};
+                        if (reader.read_list(element_data_type, element_is_nullable, element_count, elements, element_index).has_value()) {
+                            return read_error_code::bad_reference_position;
+                        }
+
+                        input = elements;
+                        if (!find_value(element_count, [&](size_t) { return reader.skip_value(element_data_type, element_is_nullable); })) {
+                            return read_error_code::bad_reference_position;
+                        }
+
+                        data_type = element_data_type;
+                        is_nullable = element_is_nullable;
+                    } break;
+                    case data_types::map: {
+                        auto key_data_type = data_types::unspecified;
+                        auto key_is_nullable = false;
+                        auto mapped_data_type = data_types::unspecified;
+                        auto mapped_is_nullable = false;
+                        auto element_count = size_t{ 0 };
+                        auto elements = TInput{};
+                        if (reader.read_map(key_data_type, key_is_nullable, mapped_data_type, mapped_is_nullable, element_count, elements).has_value()) {
+                            return read_error_code::bad_reference_position;
+                        }
+
+                        // Keys and mapped values alternate, keys at even indices.
+                        auto value_index = size_t{ 0 };
+                        input = elements;
+                        if (!find_value(element_count * 2, [&](const size_t index) {
+                            value_index = index;
+                            return index % 2 == 0 ?
+                                reader.skip_value(key_data_type, key_is_nullable) :
+                                reader.skip_value(mapped_data_type, mapped_is_nullable);
+                        })) {
+                            return read_error_code::bad_reference_position;
+                        }
+
+                        data_type = value_index % 2 == 0 ? key_data_type : mapped_data_type;
+                        is_nullable = value_index % 2 == 0 ? key_is_nullable : mapped_is_nullable;
+                    } break;
+                    default:
+                        return read_error_code::bad_reference_position;
+                }
+            }
+        }
+
+        [[nodiscard]] inline auto skip_property() -> std::optional<read_error_code> {
+            auto data_type = data_types::unspecified;
+            auto is_nullable = false;
+
+            if (auto error = read_data_type(data_type, is_nullable); error.has_value()) {
+                return error;
+            }
+
+            return skip_value(data_type, is_nullable);
+        }
+
+        // Skips value following its data type. Nested variants are skipped iteratively, regardless of input depth.
+        [[nodiscard]] inline auto skip_value(data_types data_type, bool is_nullable) -> std::optional<read_error_code> {
+            while (true) {
+                if (is_nullable == true) {
+                    if (!has_bytes_left(sizeof(uint8_t))) {
+                        return read_error_code::insufficient_data;
+                    }
+
+                    const auto nullable_value_flags = read_nullable_value_flags();
+
+                    if (!(nullable_value_flags & static_cast<uint8_t>(nullable_value_flags::has_value))) {
+                        return {};
+                    }
+
+                    if (nullable_value_flags & static_cast<uint8_t>(nullable_value_flags::is_reference)) {
+                        return skip_bytes(sizeof(uint64_t));
+                    }
+                }
+
+                if (data_type != data_types::variant) {
+                    return skip_payload(data_type);
+                }
+
+                auto index = size_t{ 0 };
+                if (auto error = read_format_value<options_variant_index_type>(index); error.has_value()) {
+                    return error;
+                }
+
+                if (auto error = read_data_type(data_type, is_nullable); error.has_value()) {
+                    return error;
+                }
+            }
+        }
+
+        [[nodiscard]] inline auto read_object(size_t& property_count, TInput& properties) -> std::optional<read_error_code> {
+            if (!has_bytes_left(format_min_size_v<options_object_offset_type> + format_min_size_v<options_object_property_count_type>)) {
+                return read_error_code::insufficient_data;
+            }
+
+            auto block_offset = size_t{ 0 };
+            if (auto error = read_format_value<options_object_offset_type>(block_offset); error.has_value()) {
+                return error;
+            }
+
+            if (block_offset < min_object_offset) {
+                return read_error_code::bad_object_offset;
+            }
+
+            if (!has_bytes_left(block_offset)) {
+                return read_error_code::insufficient_data;
+            }
+
+            const auto block_input_size = m_input.size();
+
+            if (auto error = read_format_value<options_object_property_count_type>(property_count); error.has_value()) {
+                return error;
+            }
+
+            const auto header_size = block_input_size - m_input.size();
+            if (header_size > block_offset) {
+                return read_error_code::bad_object_offset;
+            }
+
+            properties = m_input.subspan(0, block_offset - header_size);
+            return {};
+        }
+
+        [[nodiscard]] inline auto read_list(
+            data_types& element_data_type,
+            bool& element_is_nullable,
+            size_t& element_count,
+            TInput& elements,
+            TInput& element_index) -> std::optional<read_error_code>
+        {
+            if (!has_bytes_left(format_min_size_v<options_list_offset_type> + min_list_offset)) {
+                return read_error_code::insufficient_data;
+            }
+
+            auto block_offset = size_t{ 0 };
+            if (auto error = read_format_value<options_list_offset_type>(block_offset); error.has_value()) {
+                return error;
+            }
+
+            if (block_offset < min_list_offset) {
+                return read_error_code::bad_list_offset;
+            }
+
+            if (!has_bytes_left(block_offset)) {
+                return read_error_code::insufficient_data;
+            }
+
+            const auto block_input_size = m_input.size();
+
+            const auto [data_type, nullable_flag, has_element_index] = read_list_element_data_type();
+            element_data_type = data_type;
+            element_is_nullable = nullable_flag;
+
+            if (auto error = read_format_value<options_list_element_count_type>(element_count); error.has_value()) {
+                return error;
+            }
+
+            const auto header_size = block_input_size - m_input.size();
+            if (header_size > block_offset) {
+                return read_error_code::bad_list_offset;
+            }
+
+            elements = m_input.subspan(0, block_offset - header_size);
+            element_index = {};
+
+            if (has_element_index) {
+                if (element_count > elements.size() / sizeof(options_list_element_offset_type)) {
+                    return read_error_code::bad_list_element_index;
+                }
+
+                const auto element_index_size = element_count * sizeof(options_list_element_offset_type);
+                element_index = elements.subspan(elements.size() - element_index_size);
+                elements = elements.subspan(0, elements.size() - element_index_size);
+            }
+
+            return {};
+        }
+
+        // Reads the next offset of a list element index, from the start of the list elements.
+        [[nodiscard]] inline auto read_list_element_offset(size_t& offset) -> std::optional<read_error_code> {
+            if (!has_bytes_left(sizeof(options_list_element_offset_type))) {
+                return read_error_code::insufficient_data;
+            }
+
+            offset = static_cast<size_t>(this->template read_value<options_list_element_offset_type>());
+            return {};
+        }
+
+        [[nodiscard]] inline auto read_map(
+            data_types& key_data_type,
+            bool& key_is_nullable,
+            data_types& mapped_data_type,
+            bool& mapped_is_nullable,
+            size_t& element_count,
+            TInput& elements) -> std::optional<read_error_code>
+        {
+            if (!has_bytes_left(format_min_size_v<options_map_offset_type> + min_map_offset)) {
+                return read_error_code::insufficient_data;
+            }
+
+            auto block_offset = size_t{ 0 };
+            if (auto error = read_format_value<options_map_offset_type>(block_offset); error.has_value()) {
+                return error;
+            }
+
+            if (block_offset < min_map_offset) {
+                return read_error_code::bad_map_offset;
+            }
+
+            if (!has_bytes_left(block_offset)) {
+                return read_error_code::insufficient_data;
+            }
+
+            const auto block_input_size = m_input.size();
+
+            const auto [key_type, key_nullable_flag] = read_data_type_with_nullable_flag();
+            key_data_type = key_type;
+            key_is_nullable = key_nullable_flag;
+
+            const auto [mapped_type, mapped_nullable_flag] = read_data_type_with_nullable_flag();
+            mapped_data_type = mapped_type;
+            mapped_is_nullable = mapped_nullable_flag;
+
+            if (auto error = read_format_value<options_map_element_count_type>(element_count); error.has_value()) {
+                return error;
+            }
+
+            const auto header_size = block_input_size - m_input.size();
+            if (header_size > block_offset) {
+                return read_error_code::bad_map_offset;
+            }
+
+            elements = m_input.subspan(0, block_offset - header_size);
+            return {};
+        }
+
+        [[nodiscard]] inline static constexpr size_t get_fundamental_size(const data_types data_type) {
+            switch (data_type) {
+                case data_types::boolean:
+                case data_types::character:
+                case data_types::int8:
+                case data_types::uint8: return 1;
+                case data_types::int16:
+                case data_types::uint16: return 2;
+                case data_types::int32:
+                case data_types::uint32:
+                case data_types::float32: return 4;
+                case data_types::int64:
+                case data_types::uint64:
+                case data_types::float64: return 8;
+                default: return 0;
+            }
+        }
+
+    private:
+
+        using options = TOptions;
+        using options_object_property_count_type = typename options::object_property_count_type;
+        using options_string_offset_type = typename options::string_offset_type;
+        using options_string_char_size_type = typename options::string_char_size_type;
+        using options_object_offset_type = typename options::object_offset_type;
+        using options_list_offset_type = typename options::list_offset_type;
+        using options_list_element_count_type = typename options::list_element_count_type;
+        using options_map_offset_type = typename options::map_offset_type;
+        using options_map_element_count_type = typename options::map_element_count_type;
+        using options_variant_index_type = typename options::variant_index_type;
+        using options_format_size_type = typename options::format_size_type;
+        using options_list_element_offset_type = format_value_t<options_list_offset_type>;
+
+        constexpr static auto min_string_offset = sizeof(options_string_char_size_type);
+        constexpr static auto min_object_offset = format_min_size_v<options_object_property_count_type>;
+        constexpr static auto min_list_offset = sizeof(data_types) + format_min_size_v<options_list_element_count_type>;
+        constexpr static auto min_map_offset = sizeof(data_types) + sizeof(data_types) + format_min_size_v<options_map_element_count_type>;
+
+        [[nodiscard]] inline auto skip_bytes(const size_t byte_count) -> std::optional<read_error_code> {
+            if (!has_bytes_left(byte_count)) {
+                return read_error_code::insufficient_data;
+            }
+
+            m_input = m_input.subspan(byte_count);
+            return {};
+        }
+
+        template<typename TOffset>
+        [[nodiscard]] inline auto skip_block(const size_t min_offset, const read_error_code bad_offset_error) -> std::optional<read_error_code> {
+            auto block_offset = size_t{ 0 };
+            if (auto error = read_format_value<TOffset>(block_offset); error.has_value()) {
+                return error;
+            }
+
+            if (block_offset < min_offset) {
+                return bad_offset_error;
+            }
+
+            return skip_bytes(block_offset);
+        }
+
+        [[nodiscard]] inline auto skip_payload(const data_types data_type) -> std::optional<read_error_code> {
+            switch (data_type) {
+                case data_types::string:
+                    return skip_block<options_string_offset_type>(min_string_offset, read_error_code::bad_string_offset);
+                case data_types::object:
+                    return skip_block<options_object_offset_type>(min_object_offset, read_error_code::bad_object_offset);
+                case data_types::list:
+                    return skip_block<options_list_offset_type>(min_list_offset, read_error_code::bad_list_offset);
+                case data_types::map:
+                    return skip_block<options_map_offset_type>(min_map_offset, read_error_code::bad_map_offset);
+                case data_types::unspecified:
+                    return skip_block<options_format_size_type>(0, read_error_code::insufficient_data);
+                default:
+                    break;
+            }
+
+            if (const auto [value_data_type, is_varint] = split_varint_value_flag(data_type); is_varint) {
+                if (!is_varint_data_type(value_data_type)) {
+                    return read_error_code::bad_data_type;
+                }
+
+                auto value = uint64_t{ 0 };
+                return base::template read_varint<uint64_t>(value);
+            }
+
+            const auto fundamental_size = get_fundamental_size(data_type);
+            if (fundamental_size == 0) {
+                return read_error_code::bad_data_type;
+            }
+
+            return skip_bytes(fundamental_size);
+        }
+
+    };
+
+    struct read_reference {
+        std::shared_ptr<void> pointer = {};
+        std::type_index type_index = typeid(void);
+    };
+
+    // Reference to a value read by another chunk of a list or map read in parallel, assigned once all chunks are read.
+    struct deferred_read_reference {
+        void* target = nullptr;
+        uint64_t position = 0;
+        std::type_index type_index = typeid(void);
+        void (*assign)(void* target, const std::shared_ptr<void>& pointer) = nullptr;
+        // Reads the referenced value when defined before the reference but skipped, as by a projection.
+        std::optional<read_error_code> (*read_skipped)(void* context, void* target, uint64_t position) = nullptr;
+    };
+
+    // Map entries read apart from their map, as their keys may reference values of other chunks and can't change once inserted.
+    struct deferred_map_insert {
+        void* map = nullptr;
+        std::shared_ptr<void> nodes = {}; // Vector of nodes of the map, in the order read.
+        void (*insert)(void* map, void* nodes) = nullptr;
+    };
+
+    // References read by a chunk of elements, read apart from the rest of its list or map.
+    struct read_chunk_references {
+        std::vector<std::pair<uint64_t, read_reference>> values = {}; // Position and reference, of values read.
+        std::vector<deferred_read_reference> deferred = {}; // References to values read by other chunks.
+        std::vector<deferred_map_insert> deferred_inserts = {}; // Map entries inserted once deferred references are assigned.
+    };
+
+    // Values that may hold shared pointers, and so references deferred by chunks of parallel reads.
+    template<typename T>
+    static constexpr bool may_hold_shared_ptr_v = 
+        fundamental_traits<T>::is_fundamental == false &&
+        std::is_enum_v<T> == false &&
+        is_std_string_v<T> == false &&
+        is_std_string_view_v<T> == false;
+
+    template<typename T> requires is_std_unique_ptr_v<T>
+    static constexpr bool may_hold_shared_ptr_v<T> = may_hold_shared_ptr_v<typename T::element_type>;
+
+    template<typename T> requires is_std_optional_v<T>
+    static constexpr bool may_hold_shared_ptr_v<T> = may_hold_shared_ptr_v<typename T::value_type>;
+
+    template<typename TOptions>
+    using read_reference_map = reference_table<read_reference, options_reference_policy_v<TOptions>>;
+
+    // Reads values of the input. Verifying contexts validate the input without keeping any of the values read,
+    // and contexts of options with trusted_input skip bounds and type checks.
+    template<typename TOptions, typename TInput = read_input_type, bool Vverify = false>
+    class read_context : private read_context_base<TInput, Vverify || !options_trusted_input_v<TOptions>> {
+
+    private:
+
+        using base = read_context_base<TInput, Vverify || !options_trusted_input_v<TOptions>>;
+        using base::input_is_contiguous;
+        using base::m_input;
+        using base::has_bytes_left;
+        using base::read_value;
+        using base::read_data_type_with_nullable_flag;
+        using base::read_list_element_data_type;
+        using base::read_nullable_value_flags;
+        using base::read_container;
+        using base::read_varint_container;
+        using base::read_varint_value;
+        using base::read_view;
+        using base::has_valid_bool_values;
+
+        static constexpr auto checks_input = Vverify || !options_trusted_input_v<TOptions>;
+
+    public:
+
+        static constexpr auto direction = context_direction::read;
+
+        explicit read_context(
+            TInput& input,
+            TInput original_input,
+            size_t max_property_count,
+            read_reference_map<TOptions>& reference_map,
+            bool resolve_missing_references = false,
+            std::pmr::memory_resource* memory_resource = nullptr
+        ) :
+            base{ input },
+            m_property_count{ 0 },
+            m_max_property_count{ max_property_count },
+            m_original_input{ original_input },
+            m_reference_map{ reference_map },
+            m_resolve_missing_references{ resolve_missing_references },
+            m_memory_resource{ memory_resource }
+        {} 
+
+        read_context(const read_context&) = delete;
+        read_context(read_context&&) = delete;
+        read_context& operator = (const read_context&) = delete;
+        read_context& operator = (read_context&&) = delete;
+
+        template<typename ... T>
+        auto map(T& ... value) -> bool {
+            static_assert(sizeof...(value) > 0, "Cannot pass 0 parameters to map function of blopp context.");
+            
+            if constexpr (sizeof...(value) == 1) {
+                if (m_error.has_value()) {
+                    return false;
+                }
 
-            constexpr auto total_variadic_size = get_total_variadic_size<T...>();
+                ++m_property_count;
+                if (m_property_count > m_max_property_count) {
+                    m_error = read_error_code::mismatching_object_property_count;
+                }
+                else {
+                    ((m_error = map_impl<false>(value)), ...);
+                }
+            }
+            else {             
+                (void)((!m_error.has_value() && (++m_property_count <= m_max_property_count) && (m_error = map_impl<false>(value), 1) ) && ...);
 
-            static_assert(max_format_size >= total_variadic_size,
-                "Total size of variadics passed to blopp format exceeds max format size");
+                if (!m_error.has_value() && m_property_count > m_max_property_count) {
+                    m_error = read_error_code::mismatching_object_property_count;
+                }
+            }
 
-            if (m_error.has_value()) {
-                return false;
+            return !m_error.has_value();
+        }
+
+        template<typename Tas, typename T>
+        auto map_as(T& value) -> bool {
+            using from_t = std::remove_cvref_t<Tas>;
+            using to_t = std::remove_cvref_t<T>;
+
+            static_assert(is_varint_v<from_t> || std::is_integral_v<Tas> || std::is_floating_point_v<Tas>,
+                "Can only cast integral and floating point types.");
+
+            // Varints are told apart by their data type, and read as any other value.
+            if constexpr (is_varint_v<from_t> == true) {
+                if constexpr (std::is_integral_v<to_t> == true) {
+                    return map_as<format_value_t<from_t>>(value);
+                }
+                else {
+                    return map(value);
+                }
+            }
+            else if constexpr (std::is_same_v<to_t, from_t> == true) {
+                return map(value);
             }
+            else if constexpr (
+                (std::is_integral_v<to_t> == true && std::is_integral_v<from_t> == true) ||
+                (std::is_floating_point_v<to_t> == true && std::is_integral_v<from_t> == true))
+            {
+                auto from_value = from_t{};
+                if (!map(from_value)) {
+                    return false;
+                }
 
-            if (total_format_size + total_variadic_size > max_format_size) {
-                m_error = write_error_code::format_size_overflow;
-                return false;
+                if (conversion_overflows<from_t, to_t>(from_value)) {
+                    m_error = read_error_code::conversion_overflow;
+                    return false;
+                }
+
+                value = static_cast<to_t>(from_value);
+                return true;
             }
+            else if constexpr (
+                (std::is_floating_point_v<to_t> == true && std::is_floating_point_v<from_t> == true) ||
+                (std::is_integral_v<to_t> == true && std::is_floating_point_v<from_t> == true))
+            {
+                auto from_value = from_t{};
+                if (!map(from_value)) {
+                    return false;
+                }
 
-            (format_impl(value), ...);
+                value = static_cast<to_t>(from_value);
+                return true;
+            }
+            else {
+                static_assert(always_false<Tas>, "Mising map_as case.");
+            }
+        }
 
-            total_format_size += total_variadic_size;
+        // Skips the next properties by their block offsets, without decoding them.
+        auto skip(const size_t count = 1) -> bool {
+            for (size_t i = 0; i < count && !m_error.has_value(); ++i) {
+                ++m_property_count;
+                if (m_property_count > m_max_property_count) {
+                    m_error = read_error_code::mismatching_object_property_count;
+                    break;
+                }
 
-            return true;
+                auto reader = view_reader<TOptions, TInput>{ m_input };
+                m_error = reader.skip_property();
+            }
+
+            return !m_error.has_value();
+        }
+
+        // Reads value without its data type, which has already been read by the caller.
+        template<typename T>
+        auto map_payload(T& value, const bool is_varint = false) -> bool {
+            m_error = map_impl<true>(value, is_varint);
+            return !m_error.has_value();
         }
 
         [[nodiscard]] inline auto error() const {
             return m_error;
         }
- 
-    private:
 
-        template<typename ... T>
-        [[nodiscard]] inline static constexpr size_t get_total_variadic_size()
-        {
-            return (value_size_trait<std::remove_cvref_t<T>>::size + ...);
+    private:
+
+        using options = TOptions;
+        using options_object_property_count_type = typename options::object_property_count_type;
+        using options_string_offset_type = typename options::string_offset_type;
+        using options_string_char_size_type = typename options::string_char_size_type;
+        using options_object_offset_type = typename options::object_offset_type;
+        using options_list_offset_type = typename options::list_offset_type;
+        using options_list_element_count_type = typename options::list_element_count_type;
+        using options_map_offset_type = typename options::map_offset_type;
+        using options_map_element_count_type = typename options::map_element_count_type;
+        using options_variant_index_type = typename options::variant_index_type;
+        using options_format_size_type = typename options::format_size_type;
+        using options_list_element_offset_type = format_value_t<options_list_offset_type>;
+
+        static_assert(is_varint_v<options_string_char_size_type> == false && is_varint_v<options_format_size_type> == false,
+            "string_char_size_type and format_size_type of blopp binary format types cannot be varints.");
+
+        constexpr static auto min_string_offset = sizeof(options_string_char_size_type);
+        constexpr static auto min_object_offset = format_min_size_v<options_object_property_count_type>;
+        constexpr static auto min_list_offset = sizeof(data_types) + format_min_size_v<options_list_element_count_type>;
+        constexpr static auto min_map_offset = sizeof(data_types) + sizeof(data_types) + format_min_size_v<options_map_element_count_type>;
+
+        static constexpr auto options_allow_object_excess_bytes = options::allow_object_excess_bytes;
+        static constexpr auto options_allow_more_object_members = options::allow_more_object_members;
+        static constexpr auto options_max_depth = options_max_depth_v<TOptions>;
+        static constexpr auto options_parallel_read_chunk_size = options_parallel_read_chunk_size_v<TOptions>;
+        using options_read_executor = options_read_executor_t<TOptions>;
+
+        static_assert(task_executor<options_read_executor>, "Read executor of blopp options doesn't satisfy blopp::task_executor.");
+
+        inline void skip_input_bytes(const size_t byte_count) {
+            m_input = m_input.subspan(byte_count);
+        }
+
+        [[nodiscard]] inline size_t get_input_position() const {
+            if constexpr (input_is_contiguous == true) {
+                return static_cast<size_t>(m_input.data() - m_original_input.data());
+            }
+            else {
+                return m_input.position() - m_original_input.position();
+            }
+        }
+
+        template<typename T>
+        inline auto read_fundamental_value(T& value) -> std::optional<read_error_code> {
+            using value_t = std::remove_cvref_t<T>;
+
+            if (!has_bytes_left(sizeof(value_t))) {
+                return read_error_code::insufficient_data;
+            }
+
+            if constexpr (std::is_same_v<value_t, bool> == true) {
+                auto raw_boolean_value = this->template read_value<uint8_t>();
+                if constexpr (checks_input == true) {
+                    if (raw_boolean_value > 1) {
+                        return read_error_code::bad_boolean_value;
+                    }
+                }
+                value = static_cast<bool>(raw_boolean_value);
+            }
+            else {
+                read_value(value);
+            }
+            
+            return {};
+        }
+
+        [[nodiscard]] inline auto get_memory_resource() const -> std::pmr::memory_resource* {
+            return m_memory_resource != nullptr ? m_memory_resource : std::pmr::get_default_resource();
+        }
+
+        template<typename T>
+        [[nodiscard]] inline auto make_shared_value() -> std::shared_ptr<T> {
+            if (m_memory_resource != nullptr) {
+                return std::allocate_shared<T>(std::pmr::polymorphic_allocator<T>{ m_memory_resource });
+            }
+            return std::make_shared<T>();
+        }
+
+        // Recreates std::pmr strings and containers using another memory resource than the one passed to read.
+        inline void use_memory_resource([[maybe_unused]] auto& value) {
+            using value_t = std::remove_cvref_t<decltype(value)>;
+            if constexpr (is_std_pmr_container_v<value_t> == true) {
+                if (m_memory_resource != nullptr && value.get_allocator().resource() != m_memory_resource) {
+                    std::destroy_at(&value);
+                    std::construct_at(&value, typename value_t::allocator_type{ m_memory_resource });
+                }
+            }
+        }
+
+        [[nodiscard]] inline auto read_fundamental(auto& value, [[maybe_unused]] const bool is_varint) -> std::optional<read_error_code> {
+            if constexpr (is_varint_integer_v<std::remove_cvref_t<decltype(value)>> == true) {
+                if (is_varint) {
+                    return read_varint_value(value);
+                }
+            }
+            return read_fundamental_value(value);
+        }
+
+        [[nodiscard]] inline auto read_enum(auto& value, [[maybe_unused]] const bool is_varint) -> std::optional<read_error_code> {
+            using value_t = std::underlying_type_t<std::remove_cvref_t<decltype(value)>>;
+            if constexpr (is_varint_integer_v<value_t> == true) {
+                if (is_varint) {
+                    return read_varint_value(value);
+                }
+            }
+            return read_fundamental_value(reinterpret_cast<value_t&>(value));
+        }
+
+        [[nodiscard]] inline auto read_string(auto& value) -> std::optional<read_error_code> {
+            using value_t = std::remove_cvref_t<decltype(value)>;
+            using char_t = typename value_t::value_type;
+            
+            if (!has_bytes_left(format_min_size_v<options_string_offset_type> + sizeof(options_string_char_size_type))) {
+                return read_error_code::insufficient_data;
+            }
+
+            auto block_offset = size_t{ 0 };
+            if (auto error = this->template read_format_value<options_string_offset_type>(block_offset); error.has_value()) {
+                return error;
+            }
+
+            if constexpr (checks_input == true) {
+                if (block_offset < min_string_offset) {
+                    return read_error_code::bad_string_offset;
+                }
+            }
+
+            if (!has_bytes_left(block_offset)) {
+                return read_error_code::insufficient_data;
+            }
+
+            const auto char_size = this->template read_value<options_string_char_size_type>();
+            if constexpr (checks_input == true) {
+                if (char_size != sizeof(char_t)) {
+                    return read_error_code::mismatching_string_char_size;
+                }
+            }
+
+            const auto string_size = (block_offset - 1) / sizeof(char_t);
+
+            if constexpr (Vverify == true && is_std_string_v<value_t> == true) {
+                if constexpr (validates_utf8<char_t>() == true) {
+                    static_assert(input_is_contiguous == true, "Blopp can only verify contiguous input.");
+                    if (!is_valid_utf8(m_input.data(), string_size)) {
+                        return read_error_code::bad_utf8_string;
+                    }
+                }
+
+                skip_input_bytes(string_size * sizeof(char_t));
+            }
+            else if constexpr (is_std_string_view_v<value_t> == true) {
+                auto string_view = std::span<const char_t>{};
+                if (auto error = read_view(string_view, string_size); error.has_value()) {
+                    return error;
+                }
+
+                value = value_t{ string_view.data(), string_view.size() };
+            }
+            else {
+                use_memory_resource(value);
+                value.clear();
+
+                if (auto error = read_container(value, string_size); error.has_value()) {
+                    return error;
+                }
+            }
+
+            if constexpr (Vverify == false && validates_utf8<char_t>() == true) {
+                if (!is_valid_utf8(reinterpret_cast<const uint8_t*>(value.data()), value.size())) {
+                    return read_error_code::bad_utf8_string;
+                }
+            }
+
+            return {};
+        }
+
+        template<typename TChar>
+        [[nodiscard]] static constexpr bool validates_utf8() {
+            return checks_input == true && options_validate_utf8_v<TOptions> == true && std::is_same_v<TChar, char8_t> == true;
         }
 
-        [[nodiscard]] inline auto write_array(auto& value) {
+        [[nodiscard]] inline auto read_unique_ptr(auto& value, const bool is_varint) -> std::optional<read_error_code> {
             using value_t = std::remove_cvref_t<decltype(value)>;
-            using element_t = typename value_t::value_type;
-            using element_fundamental_traits = fundamental_traits<element_t>;
+            using element_t = typename value_t::element_type;
 
-            static_assert(
-                element_fundamental_traits::is_fundamental == true ||
-                std::is_enum_v<element_t> == true,
-                "Only fundamentals and enums are supported for blopp formatting of arrays.");
+            if (!has_bytes_left(sizeof(data_types))) {
+                return read_error_code::insufficient_data;
+            }
 
-            write_contiguous_container(value);
+            if constexpr (Vverify == true) {
+                auto element_value = element_t{};
+                return map_impl<true>(element_value, is_varint);
+            }
+
+            if (value == nullptr) {
+                if constexpr (is_pmr_unique_ptr_v<value_t> == true) {
+                    auto* memory_resource = get_memory_resource();
+                    value = value_t{
+                        std::pmr::polymorphic_allocator<>{ memory_resource }.template new_object<element_t>(),
+                        pmr_deleter<element_t>{ memory_resource } };
+                }
+                else {
+                    value = std::make_unique<element_t>();
+                }
+            }
+            return map_impl<true>(*value, is_varint);
         }
 
-        [[nodiscard]] inline auto format_impl(auto& value) {
+        [[nodiscard]] inline auto read_shared_ptr(auto& value) -> std::optional<read_error_code> {
             using value_t = std::remove_cvref_t<decltype(value)>;
-            using value_fundamental_traits = fundamental_traits<value_t>;
+            using element_t = typename value_t::element_type;
 
-            if constexpr (
-                value_fundamental_traits::is_fundamental == true ||
-                std::is_enum_v<value_t> == true)
-            {
-                write_value(value);
-            }
-            else if constexpr (is_std_array_v<value_t> == true) {
-                write_array(value);
-            }
-            else if constexpr (std::is_array_v<value_t> == true) {
-                auto array_span = std::span(value);
-                write_array(array_span);
-            }
-            else {
-                static_assert(always_false<value_t>, "Unmapped blopp format data type.");
+            if (!has_bytes_left(sizeof(uint8_t))) {
+                return read_error_code::insufficient_data;
             }
-        };
 
-        std::optional<write_error_code> m_error = {};
-        size_t total_format_size = 0;
+            const auto nullable_value_flags = read_nullable_value_flags();
 
-    };
+            if (!(nullable_value_flags & static_cast<uint8_t>(nullable_value_flags::has_value))) {
+                clear_nullable_value(value);
+                return std::nullopt;
+            }
 
-    struct write_reference {
-        uint64_t position;
-        std::type_index type_index;
-    };
+            if (nullable_value_flags & static_cast<uint8_t>(nullable_value_flags::is_reference)) {
+                if (!has_bytes_left(sizeof(uint64_t))) {
+                    return read_error_code::insufficient_data;
+                }
+                const auto position = this->template read_value<uint64_t>();
 
-    using write_reference_map = std::map<const void*, write_reference>;
+                const auto* reference = m_reference_map.find(position);
+                if (reference == nullptr && m_parent_reference_map != nullptr) {
+                    reference = m_parent_reference_map->find(position);
+                }
 
-    template<typename TOptions>
-    class write_context : private write_context_base {
+                if (reference == nullptr) {
+                    if constexpr (Vverify == false) {
+                        if (m_chunk_references != nullptr && position < m_original_input.size()) {
+                            defer_shared_ptr_reference(value, position);
+                            return std::nullopt;
+                        }
+                    }
 
-    private:
+                    // Values defined before this reference are missing from the reference map when skipped by a projection,
+                    // and are read from their position instead. Reference maps of policy none never hold any values.
+                    const auto is_skipped_reference =
+                        options_reference_policy_v<TOptions> != reference_policy::none && position < get_input_position();
+                    if ((m_resolve_missing_references == false && is_skipped_reference == false) ||
+                        position >= m_original_input.size())
+                    {
+                        return read_error_code::bad_reference_position;
+                    }
 
-        using options = TOptions;
-        using options_object_property_count_type = typename options::object_property_count_type;
-        constexpr static auto max_object_property_count = std::numeric_limits<options_object_property_count_type>::max();
+                    return read_referenced_shared_ptr(value, static_cast<size_t>(position));
+                }
 
-    public:
+                if (reference->type_index != std::type_index(typeid(element_t))) {
+                    return read_error_code::bad_reference_type;
+                }
 
-        static constexpr auto direction = context_direction::write;
+                if constexpr (Vverify == false) {
+                    value = std::static_pointer_cast<element_t>(reference->pointer);
+                }
+                return std::nullopt;
+            }
 
-        explicit write_context(
-            write_output_type& output,
-            write_reference_map& reference_map
-        ) :
-            write_context_base{ output },
-            m_reference_map{ reference_map }
-        {}
+            const auto position = static_cast<uint64_t>(get_input_position());
 
-        write_context(const write_context&) = delete;
-        write_context(write_context&&) = delete;
-        write_context& operator = (const write_context&) = delete;
-        write_context& operator = (write_context&&) = delete;
+            if constexpr (Vverify == true) {
+                m_reference_map.insert(position, read_reference{
+                    .pointer = nullptr,
+                    .type_index = std::type_index(typeid(element_t))
+                });
 
-        template<typename ... T>
-        auto map(T& ... value) -> bool {
-            static_assert(sizeof...(value) > 0, "Cannot pass 0 parameters to map function of blopp context.");
+                auto element_value = element_t{};
+                return map_impl<true>(element_value);
+            }
 
-            if constexpr (sizeof...(value) == 1) {
-                if (m_error.has_value()) {
-                    return false;
-                }
+            value = make_shared_value<element_t>();
 
-                ++m_property_count;
-                ((m_error = map_impl<false>(value)), ...);
-            }
-            else {
-                (void)((!m_error.has_value() && (++m_property_count, m_error = map_impl<false>(value), 1)) && ...);
-            }
+            m_reference_map.insert(position, read_reference{
+                .pointer = value,
+                .type_index = std::type_index(typeid(element_t))
+            });
 
-            if (m_property_count > max_object_property_count) {
-                m_error = write_error_code::object_property_count_overflow;
+            if (m_chunk_references != nullptr) {
+                m_chunk_references->values.emplace_back(position, read_reference{
+                    .pointer = value,
+                    .type_index = std::type_index(typeid(element_t))
+                });
             }
 
-            return !m_error.has_value();
+            return map_impl<true>(*value);
         }
 
-        template<typename Tas, typename T>
-        auto map_as(T& value) -> bool {
-            using from_t = std::remove_cvref_t<T>;
-            using to_t = std::remove_cvref_t<Tas>;
- 
-            static_assert(std::is_integral_v<Tas> || std::is_floating_point_v<Tas>,
-                "Can only cast integral and floating point types.");
+        // References to values of other chunks are assigned after all chunks are read, as they may not be read yet.
+        inline void defer_shared_ptr_reference(auto& value, const uint64_t position) {
+            using value_t = std::remove_cvref_t<decltype(value)>;
+            using element_t = typename value_t::element_type;
 
-            if constexpr (std::is_same_v<from_t, to_t> == true) {
-                return map(value);
-            }
-            else if constexpr (
-                (std::is_integral_v<from_t> == true && std::is_integral_v<to_t> == true) ||
-                (std::is_floating_point_v<from_t> == true && std::is_integral_v<to_t> == true))
-            {
-                if (conversion_overflows<from_t, to_t>(value)) {
-                    m_error = write_error_code::conversion_overflow;
-                    return false;
+            auto& deferred = m_chunk_references->deferred.emplace_back(deferred_read_reference{
+                .target = &value,
+                .position = position,
+                .type_index = std::type_index(typeid(element_t)),
+                .assign = [](void* target, const std::shared_ptr<void>& pointer) {
+                    *static_cast<value_t*>(target) = std::static_pointer_cast<element_t>(pointer);
                 }
+            });
 
-                const auto casted_value = static_cast<to_t>(value);
-                return map(casted_value);
-            }
-            else if constexpr (
-                (std::is_floating_point_v<from_t> == true && std::is_floating_point_v<to_t> == true) ||
-                (std::is_integral_v<from_t> == true && std::is_floating_point_v<to_t> == true))
-            {
-                const auto casted_value = static_cast<to_t>(value);
-                return map(casted_value);
-            }
-            else {
-                static_assert(always_false<Tas>, "Mising map_as case.");
+            if (options_reference_policy_v<TOptions> != reference_policy::none && position < get_input_position()) {
+                deferred.read_skipped = [](void* context, void* target, const uint64_t position) {
+                    return static_cast<read_context*>(context)->read_referenced_shared_ptr(
+                        *static_cast<value_t*>(target), static_cast<size_t>(position));
+                };
             }
         }
 
-        [[nodiscard]] inline auto error() const {
-            return m_error;
-        }
-
-    private:
-
-        using options_string_offset_type = typename options::string_offset_type;
-        using options_string_char_size_type = typename options::string_char_size_type;
-        using options_object_offset_type = typename options::object_offset_type;
-        using options_list_offset_type = typename options::list_offset_type;
-        using options_list_element_count_type = typename options::list_element_count_type;
-        using options_map_offset_type = typename options::map_offset_type;
-        using options_map_element_count_type = typename options::map_element_count_type;
-        using options_variant_index_type = typename options::variant_index_type;
-        using options_format_size_type = typename options::format_size_type;
+        // Reads a value referenced from outside of the data being read, as done by views decoding a single leaf.
+        [[nodiscard]] inline auto read_referenced_shared_ptr(auto& value, const size_t position) -> std::optional<read_error_code> {
+            using value_t = std::remove_cvref_t<decltype(value)>;
+            using element_t = typename value_t::element_type;
 
-        constexpr static auto max_string_offset = std::numeric_limits<options_string_offset_type>::max();
-        constexpr static auto max_object_offset = std::numeric_limits<options_object_offset_type>::max();
-        constexpr static auto max_list_offset = std::numeric_limits<options_list_offset_type>::max();
-        constexpr static auto max_list_element_count = std::numeric_limits<options_list_element_count_type>::max();
-        constexpr static auto max_map_offset = std::numeric_limits<options_map_offset_type>::max();
-        constexpr static auto max_map_element_count = std::numeric_limits<options_map_element_count_type>::max();
+            if (auto error = view_reader<TOptions, TInput>::validate_reference_position(m_original_input, position, get_data_type<element_t>()); 
+                error.has_value())
+            {
+                return error;
+            }
 
-        template<typename TValue>
-        [[nodiscard]] inline bool write_nullable_value_flags(const TValue& value) {
-            using value_t = std::remove_cvref_t<decltype(value)>;
+            value = make_shared_value<element_t>();
 
-            const auto has_value = nullable_has_value(value);
+            m_reference_map.insert(static_cast<uint64_t>(position), read_reference{
+                .pointer = value,
+                .type_index = std::type_index(typeid(element_t))
+            });
 
-            if constexpr (is_std_shared_ptr_v<value_t> == true) {
-                if (!has_value) {
-                    m_output.push_back(static_cast<uint8_t>(nullable_value_flags::is_null));
-                    return false;
-                }
+            auto reference_input = m_original_input.subspan(position);
+            auto reference_read_context = read_context{
+                reference_input, m_original_input, 1, m_reference_map, true, m_memory_resource };
+            reference_read_context.m_depth = m_depth;
 
-                auto it = m_reference_map.find(value.get());
-                if (it != m_reference_map.end()) {
-                    m_output.push_back(static_cast<uint8_t>(nullable_value_flags::has_value_and_is_reference));
-                    write_value(it->second.position);
-                    return false;
-                }
+            return reference_read_context.template map_impl<true>(*value);
+        }
 
-                m_output.push_back(static_cast<uint8_t>(nullable_value_flags::has_value));
-                return true;
+        [[nodiscard]] inline auto read_optional(auto& value, const bool is_varint) -> std::optional<read_error_code> {
+            if (!has_bytes_left(sizeof(data_types))) {
+                return read_error_code::insufficient_data;
             }
-            else {
-                static_assert(static_cast<uint8_t>(false) == static_cast<uint8_t>(nullable_value_flags::is_null),
-                    "Blopp failed to cast boolean to correct nullable_value_flags. false != is_null");
 
-                static_assert(static_cast<uint8_t>(true) == static_cast<uint8_t>(nullable_value_flags::has_value),
-                    "Blopp failed to cast boolean to correct nullable_value_flags. true != has_value");
+            if constexpr (Vverify == true) {
+                auto element_value = typename std::remove_cvref_t<decltype(value)>::value_type{};
+                return map_impl<true>(element_value, is_varint);
+            }
 
-                m_output.push_back(static_cast<uint8_t>(has_value));
-                return has_value;
+            if (!value.has_value()) {
+                value.emplace();
             }
+            return map_impl<true>(*value, is_varint);
         }
 
-        [[nodiscard]] inline auto write_fundamental(const auto& value) -> std::optional<write_error_code> {
-            write_value(value);
-            return {};
+        template<size_t Vindex, typename ... Ts>
+        [[nodiscard]] static auto read_variant_value(read_context& context, std::variant<Ts...>& value) -> std::optional<read_error_code>
+        {
+            if (value.index() != Vindex) {
+                value.template emplace<Vindex>();
+            }
+            return context.template map_impl<false>(std::get<Vindex>(value));
         }
 
-        [[nodiscard]] inline auto write_enum(const auto& value) -> std::optional<write_error_code> {
-            using underlying_t = std::underlying_type_t<std::remove_cvref_t<decltype(value)>>;
-            write_value(static_cast<underlying_t>(value));
-            return {};
-        }
+        template<typename ... Ts>
+        [[nodiscard]] inline auto read_variant(std::variant<Ts...>& value) -> std::optional<read_error_code> {
+            using read_variant_value_function = std::optional<read_error_code>(*)(read_context&, std::variant<Ts...>&);
 
-        [[nodiscard]] inline auto write_string(const auto& value) -> std::optional<write_error_code> {
-            using value_t = std::remove_cvref_t<decltype(value)>;
-            using char_t = typename value_t::value_type;
+            // Alternatives are read via a table indexed by variant index, in constant time regardless of the alternative count.
+            static constexpr auto read_variant_value_functions = []<size_t ... Vindices>(std::index_sequence<Vindices...>) {
+                return std::array<read_variant_value_function, sizeof...(Ts)>{
+                    &read_context::template read_variant_value<Vindices, Ts...>... };
+            }(std::index_sequence_for<Ts...>{});
 
-            constexpr auto char_size = static_cast<options_string_char_size_type>(sizeof(char_t));
-            constexpr auto max_string_size = (max_string_offset - sizeof(options_string_char_size_type)) / sizeof(char_t);
+            if (!has_bytes_left(format_min_size_v<options_variant_index_type>)) {
+                return read_error_code::insufficient_data;
+            }
 
-            if (value.size() > max_string_size) {
-                return write_error_code::string_offset_overflow;
+            auto index = size_t{ 0 };
+            if (auto error = this->template read_format_value<options_variant_index_type>(index); error.has_value()) {
+                return error;
             }
 
-            const auto string_offset = (value.size() * sizeof(char_t)) + sizeof(options_string_char_size_type);
+            // Checked for trusted input as well, as the index selects the function called.
+            if (index >= sizeof...(Ts)) {
+                return read_error_code::bad_variant_index;
+            }
 
-            write_value(static_cast<options_string_offset_type>(string_offset));
-            write_value(char_size);
-            write_contiguous_container(value);
-            return {};
+            return read_variant_value_functions[index](*this, value);
         }
 
-        [[nodiscard]] inline auto write_shared_ptr(const auto& value) -> std::optional<write_error_code> {
+        [[nodiscard]] inline auto read_object(auto& value) -> std::optional<read_error_code> {
             using value_t = std::remove_cvref_t<decltype(value)>;
-            using element_t = typename value_t::element_type;
 
-            m_reference_map.emplace(value.get(), write_reference{
-                .position = static_cast<uint64_t>(m_output.size()),
-                .type_index = std::type_index(typeid(element_t))
-            });
+            if (!has_bytes_left(format_min_size_v<options_object_offset_type> + format_min_size_v<options_object_property_count_type>)) {
+                return read_error_code::insufficient_data;
+            }
 
-            return map_impl<true>(*value);
-        }
+            auto block_offset = size_t{ 0 };
+            if (auto error = this->template read_format_value<options_object_offset_type>(block_offset); error.has_value()) {
+                return error;
+            }
 
-        [[nodiscard]] inline auto write_object(const auto& value) -> std::optional<write_error_code> {
-            using value_t = std::remove_cvref_t<decltype(value)>;
-       
-            auto block_offset_writer = post_output_writer<options_object_offset_type>{ m_output };        
-            const auto block_start_position = m_output.size();
+            if constexpr (checks_input == true) {
+                if (block_offset < min_object_offset) {
+                    return read_error_code::bad_object_offset;
+                }
+            }
 
-            auto property_count_writer = post_output_writer<options_object_property_count_type>{ m_output };      
- 
-            auto object_write_context = write_context{ m_output, m_reference_map };
+            if (!has_bytes_left(block_offset)) {
+                return read_error_code::insufficient_data;
+            }
 
-            using object_map_result_t = decltype(object<value_t>::map(object_write_context, value));
+            const auto block_input_size = m_input.size();
+
+            auto property_count = size_t{ 0 };
+            if (auto error = this->template read_format_value<options_object_property_count_type>(property_count); error.has_value()) {
+                return error;
+            }
+
+            const auto header_size = block_input_size - m_input.size();
+            if constexpr (checks_input == true) {
+                if (header_size > block_offset) {
+                    return read_error_code::bad_object_offset;
+                }
+            }
+
+            const auto object_offset = block_offset - header_size;
+
+            auto object_input = m_input.subspan(0, object_offset);
+            auto object_read_context = read_context{
+                object_input, m_original_input, property_count, m_reference_map, m_resolve_missing_references, m_memory_resource };
+            object_read_context.m_depth = m_depth;
+            object_read_context.m_parent_reference_map = m_parent_reference_map;
+            object_read_context.m_chunk_references = m_chunk_references;
+            
+            using object_map_result_t = decltype(object<value_t>::map(object_read_context, value));
 
             if constexpr (std::is_same_v<object_map_result_t, void> == true) {
-                object<value_t>::map(object_write_context, value);
+                object<value_t>::map(object_read_context, value);
+
+                if (object_read_context.m_error) {
+                    return object_read_context.m_error.value();
+                }
             }
             else if constexpr (std::is_same_v<object_map_result_t, bool> == true) {
-                if (!object<value_t>::map(object_write_context, value)) {
-                    return write_error_code::user_defined_failure;
-                };
+                const auto map_result = object<value_t>::map(object_read_context, value);
+
+                if (object_read_context.m_error) {
+                    return object_read_context.m_error.value();
+                }
+                if (!map_result) {
+                    return read_error_code::user_defined_failure;
+                }
             }
             else {
                 static_assert(always_false<value_t>, "Only void and bool return type of blopp::object<T>::map is supported.");
             }
 
-            if (object_write_context.m_error) {
-                return object_write_context.m_error.value();
-            }
- 
-            const auto block_offset = m_output.size() - block_start_position;
-            if (block_offset > max_object_offset) {
-                return write_error_code::object_offset_overflow;
+            if constexpr (options_allow_object_excess_bytes == false) {
+                if (!object_input.empty()) {
+                    return read_error_code::bad_object_excess_bytes;
+                }
+            }
+
+            if constexpr (options_allow_more_object_members == false) {
+                if (object_read_context.m_property_count < property_count) {
+                    return read_error_code::mismatching_object_property_count;
+                }
             }
 
-            block_offset_writer.update(static_cast<options_object_offset_type>(block_offset));
-
-            const auto property_count = object_write_context.m_property_count;
-            property_count_writer.update(static_cast<options_object_property_count_type>(property_count));
+            skip_input_bytes(object_offset);
 
             return {};
         }
 
-        [[nodiscard]] inline auto write_list(const auto& value) -> std::optional<write_error_code> {
+        [[nodiscard]] inline auto read_list(auto& value) -> std::optional<read_error_code> {
             using value_t = std::remove_cvref_t<decltype(value)>;
             using element_t = typename value_t::value_type;
             using element_fundamental_traits = fundamental_traits<element_t>;
 
-            const auto element_count = value.size();
-            if (element_count > max_list_element_count) {
-                return write_error_code::list_element_count_overflow;
+            if (!has_bytes_left(format_min_size_v<options_list_offset_type> + min_list_offset)) {
+                return read_error_code::insufficient_data;
             }
 
-            auto block_offset_writer = post_output_writer<options_list_offset_type>{ m_output };
-            const auto block_start_position = m_output.size();
+            auto block_offset = size_t{ 0 };
+            if (auto error = this->template read_format_value<options_list_offset_type>(block_offset); error.has_value()) {
+                return error;
+            }
 
-            constexpr auto element_is_nullable = is_nullable_v<element_t>;
-            write_data_type<element_is_nullable>(get_data_type<element_t>());
+            if constexpr (checks_input == true) {
+                if (block_offset < min_list_offset) {
+                    return read_error_code::bad_list_offset;
+                }
+            }
+
+            if (!has_bytes_left(block_offset)) {
+                return read_error_code::insufficient_data;
+            }
 
-            write_value(static_cast<options_list_element_count_type>(element_count));
+            const auto block_input_size = m_input.size();
 
-            if constexpr (element_fundamental_traits::is_fundamental == true) {
-                if constexpr (std::contiguous_iterator<typename value_t::iterator> == true)
-                {
-                    write_contiguous_container(value);
+            [[maybe_unused]] const auto [element_data_type, element_nullable_flag, has_element_index] = read_list_element_data_type();
+            [[maybe_unused]] const auto [element_value_data_type, element_is_varint] = split_varint_value_flag(element_data_type);
+
+            if constexpr (checks_input == true) {
+                constexpr auto element_is_nullable = is_nullable_v<element_t>;
+
+                if (element_nullable_flag != element_is_nullable) {
+                    return read_error_code::mismatching_nullable;
                 }
-                else {
-                    for (const auto element_value : value) {
-                        write_value(static_cast<const element_t>(element_value));
-                    }
+
+                if (element_value_data_type != get_data_type<element_t>() || (element_is_varint && !is_varint_value_v<element_t>)) {
+                    return read_error_code::mismatching_type;
                 }
             }
-            else {
-                for (const auto& element_value : value) {
-                    if (auto error = map_impl<true>(element_value); error.has_value()) {
-                        return error;
-                    }
+
+            auto element_count = size_t{ 0 };
+            if (auto error = this->template read_format_value<options_list_element_count_type>(element_count); error.has_value()) {
+                return error;
+            }
+
+            const auto header_size = block_input_size - m_input.size();
+            if constexpr (checks_input == true) {
+                if (header_size > block_offset) {
+                    return read_error_code::bad_list_offset;
                 }
             }
 
-            const auto block_offset = m_output.size() - block_start_position;
-            if (block_offset > max_list_offset) {
-                return write_error_code::list_offset_overflow;
+            [[maybe_unused]] const auto elements_size = block_offset - header_size;
+
+            if constexpr (checks_input == true && is_std_array_v<value_t> == true) {
+                if (element_count != value.size()) {
+                    return read_error_code::mismatching_array_size;
+                }
             }
 
-            block_offset_writer.update(static_cast<options_list_offset_type>(block_offset));
+            use_memory_resource(value);
 
-            return {};
-        }
+            if constexpr (is_varint_integer_v<element_t> == true) {
+                if (element_is_varint) {
+                    return read_varint_elements(value, element_count, elements_size);
+                }
+            }
 
-        [[nodiscard]] inline auto write_map(const auto& value) -> std::optional<write_error_code> {
-            using value_t = std::remove_cvref_t<decltype(value)>;
-            using key_t = typename value_t::key_type;
-            using mapped_t = typename value_t::mapped_type;
+            if constexpr (is_std_const_span_v<value_t> == true) {
+                if (!this->template has_bytes_left<element_t>(element_count)) {
+                    return read_error_code::insufficient_data;
+                }
 
-            const auto element_count = value.size();
-            if (element_count > max_map_element_count) {
-                return write_error_code::map_element_count_overflow;
+                if (auto error = read_view(value, element_count); error.has_value()) {
+                    return error;
+                }
             }
+            else if constexpr (Vverify == true && element_fundamental_traits::is_fundamental == true) {
+                if (!this->template has_bytes_left<element_t>(element_count)) {
+                    return read_error_code::insufficient_data;
+                }
 
-            auto block_offset_writer = post_output_writer<options_map_offset_type>{ m_output };
-            const auto block_start_position = m_output.size();
+                if constexpr (std::is_same_v<element_t, bool> == true) {
+                    if (!has_valid_bool_values(element_count)) {
+                        return read_error_code::bad_boolean_value;
+                    }
+                }
 
-            constexpr auto key_is_nullable = is_nullable_v<key_t>;
-            write_data_type<key_is_nullable>(get_data_type<key_t>());
+                skip_input_bytes(element_count * sizeof(element_t));
+            }
+            else if constexpr (Vverify == true) {
+                auto element_value = element_t{};
 
-            constexpr auto mapped_is_nullable = is_nullable_v<mapped_t>;
-            write_data_type<mapped_is_nullable>(get_data_type<mapped_t>());
+                // Offsets of the element index are verified to point at the elements, as views and parallel reads rely on them.
+                auto element_index_input = TInput{};
+                if (has_element_index) {
+                    if (element_count > elements_size / sizeof(options_list_element_offset_type)) {
+                        return read_error_code::bad_list_element_index;
+                    }
+                    element_index_input = m_input.subspan(elements_size - (element_count * sizeof(options_list_element_offset_type)));
+                }
 
-            write_value(static_cast<options_map_element_count_type>(element_count));
+                auto element_index_reader = view_reader<TOptions, TInput>{ element_index_input };
+                const auto elements_position = get_input_position();
 
-            for (const auto& [key, mapped] : value)
-            {
-                if (auto error = map_impl<true>(key); error.has_value()) {
-                    return error;
+                for (size_t i = 0; i < element_count; ++i) {
+                    if (has_element_index) {
+                        auto element_offset = size_t{ 0 };
+                        if (auto error = element_index_reader.read_list_element_offset(element_offset); error.has_value()) {
+                            return error;
+                        }
+                        if (element_offset != get_input_position() - elements_position) {
+                            return read_error_code::bad_list_element_index;
+                        }
+                    }
+
+                    if (auto map_error = map_impl<true>(element_value, element_is_varint); map_error) {
+                        return map_error;
+                    }
+                }
+            }
+            else if constexpr (element_fundamental_traits::is_fundamental == true) {
+                if (!this->template has_bytes_left<element_t>(element_count)) {
+                    return read_error_code::insufficient_data;
                 }
-                if (auto error = map_impl<true>(mapped); error.has_value()) {
+
+                clear_container(value);
+
+                if (auto error = read_container(value, element_count); error.has_value()) {
                     return error;
                 }
             }
+            else {
+                // Each element takes at least one byte, which bounds the resize below.
+                if (!has_bytes_left(element_count)) {
+                    return read_error_code::insufficient_data;
+                }
 
-            const auto block_offset = m_output.size() - block_start_position;
-            if (block_offset > max_map_offset) {
-                return write_error_code::map_offset_overflow;
+                // Elements already in the container are read in place, keeping their allocations.
+                resize_container(value, element_count);
+
+                if (reads_in_parallel(element_count)) {
+                    auto error = read_elements_in_parallel(
+                        value,
+                        elements_size,
+                        has_element_index,
+                        [&](view_reader<TOptions, TInput>& reader) {
+                            return reader.skip_value(element_data_type, element_nullable_flag);
+                        },
+                        [&](read_context& context, auto& element_value) {
+                            return context.template map_impl<true>(element_value, element_is_varint);
+                        });
+
+                    if (error.has_value()) {
+                        return error;
+                    }
+                }
+                else {
+                    for (auto& element_value : value) {
+                        if (auto map_error = map_impl<true>(element_value, element_is_varint); map_error) {
+                            return map_error;
+                        }
+                    }
+                }
             }
 
-            block_offset_writer.update(static_cast<options_map_offset_type>(block_offset));
+            if (has_element_index) {
+                if (!this->template has_bytes_left<options_list_element_offset_type>(element_count)) {
+                    return read_error_code::insufficient_data;
+                }
+                skip_input_bytes(element_count * sizeof(options_list_element_offset_type));
+            }
 
             return {};
         }
 
-        [[nodiscard]] inline auto write_variant(const auto& value) -> std::optional<write_error_code> {
-            const auto index = value.index();    
-            write_value(static_cast<options_variant_index_type>(index));
-
-            return std::visit([&](const auto& variant_value) {
-                return map_impl<false>(variant_value);
-            }, value);
-        }
-
-        [[nodiscard]] inline auto write_formatted(const auto& value) -> std::optional<write_error_code> {
+        // Reads integers or enums of a list written as varints, which must take up the elements_size bytes of the list.
+        [[nodiscard]] inline auto read_varint_elements(auto& value, const size_t element_count, const size_t elements_size) -> std::optional<read_error_code> {
             using value_t = std::remove_cvref_t<decltype(value)>;
+            using element_t = typename value_t::value_type;
 
-            auto block_size_writer = post_output_writer<options_format_size_type>{ m_output };            
-            const auto block_start_position = m_output.size();
-
-            auto format_write_context = write_format_context<TOptions>{ m_output };
+            // Each element takes at least one byte, which bounds the resize below.
+            if (!has_bytes_left(element_count)) {
+                return read_error_code::insufficient_data;
+            }
 
-            using object_format_result_t = decltype(object<value_t>::format(format_write_context, value));
+            if (element_count > elements_size) {
+                return read_error_code::bad_list_offset;
+            }
 
-            if constexpr (std::is_same_v<object_format_result_t, void> == true) {
-                object<value_t>::format(format_write_context, value);
+            const auto input_size = m_input.size();
 
-                if (auto format_error = format_write_context.error(); format_error.has_value()) {
-                    return format_error.value();
-                }
+            if constexpr (is_std_const_span_v<value_t> == true) {
+                return read_error_code::mismatching_type;
             }
-            else if constexpr (std::is_same_v<object_format_result_t, bool> == true) {
-                const auto format_result = object<value_t>::format(format_write_context, value);
-                
-                if (auto format_error = format_write_context.error(); format_error.has_value()) {
-                    return format_error.value();
-                }
-                if (!format_result) {
-                    return write_error_code::user_defined_failure;
+            else if constexpr (Vverify == true) {
+                auto element_value = element_t{};
+                for (size_t i = 0; i < element_count; ++i) {
+                    if (auto error = read_varint_value(element_value); error.has_value()) {
+                        return error;
+                    }
                 }
             }
             else {
-                static_assert(always_false<value_t>, "Only void and bool return type of blopp::object<T>::format is supported.");
+                clear_container(value);
+
+                if (auto error = read_varint_container(value, element_count, elements_size); error.has_value()) {
+                    return error;
+                }
             }
 
-            const auto block_size = static_cast<options_format_size_type>(m_output.size() - block_start_position);
-            block_size_writer.update(block_size);
+            if constexpr (checks_input == true) {
+                if (input_size - m_input.size() != elements_size) {
+                    return read_error_code::bad_list_offset;
+                }
+            }
 
             return {};
         }
 
-        template<bool Vskip_data_type>
-        [[nodiscard]] inline auto map_impl(auto& value) -> std::optional<write_error_code> {
+        [[nodiscard]] inline auto read_map(auto& value) -> std::optional<read_error_code> {
             using value_t = std::remove_cvref_t<decltype(value)>;
-            using value_fundamental_traits = fundamental_traits<value_t>;
+            using key_t = typename value_t::key_type;
+            using mapped_t = typename value_t::mapped_type;
 
-            constexpr auto value_is_nullable = is_nullable_v<value_t>;
+            if (!has_bytes_left(format_min_size_v<options_map_offset_type> + min_map_offset)) {
+                return read_error_code::insufficient_data;
+            }
 
-            if constexpr (Vskip_data_type == false) {
-                write_data_type<value_is_nullable>(get_data_type<value_t>());
+            auto block_offset = size_t{ 0 };
+            if (auto error = this->template read_format_value<options_map_offset_type>(block_offset); error.has_value()) {
+                return error;
             }
 
-            if constexpr (value_is_nullable == true) {
-                if (!write_nullable_value_flags(value)) {
-                    return {};
+            if constexpr (checks_input == true) {
+                if (block_offset < min_map_offset) {
+                    return read_error_code::bad_map_offset;
                 }
             }
 
-            if constexpr (value_fundamental_traits::is_fundamental == true) {
-                return write_fundamental(value);
-            }
-            else if constexpr (std::is_enum_v<value_t> == true) {
-                return write_enum(value);
-            }
-            else if constexpr (is_std_string_v<value_t> == true) {
-                return write_string(value);
-            }
-            else if constexpr (
-                is_std_unique_ptr_v<value_t> == true ||
-                is_std_optional_v<value_t> == true)
-            {
-                return map_impl<true>(*value);
-            }
-            else if constexpr (is_std_shared_ptr_v<value_t> == true) {
-                return write_shared_ptr(value);
-            }
-            else if constexpr (
-                is_std_array_v<value_t> == true ||
-                is_std_vector_v<value_t> == true ||
-                is_std_list_v<value_t> == true)
-            {
-                return write_list(value);
-            }
-            else if constexpr (std::is_array_v<value_t> == true) {
-                return write_list(std::span(value));
+            if (!has_bytes_left(block_offset)) {
+                return read_error_code::insufficient_data;
             }
-            else if constexpr (is_std_map_v<value_t> == true) {
-                return write_map(value);
+
+            const auto block_input_size = m_input.size();
+
+            [[maybe_unused]] const auto [key_data_type, key_nullable_flag] = read_data_type_with_nullable_flag();
+            [[maybe_unused]] const auto [mapped_data_type, mapped_nullable_flag] = read_data_type_with_nullable_flag();
+            [[maybe_unused]] const auto [key_value_data_type, key_is_varint] = split_varint_value_flag(key_data_type);
+            [[maybe_unused]] const auto [mapped_value_data_type, mapped_is_varint] = split_varint_value_flag(mapped_data_type);
+
+            if constexpr (checks_input == true) {
+                constexpr auto key_is_nullable = is_nullable_v<key_t>;
+
+                if (key_is_nullable != key_nullable_flag) {
+                    return read_error_code::mismatching_nullable;
+                }
+
+                if (key_value_data_type != get_data_type<key_t>() || (key_is_varint && !is_varint_value_v<key_t>)) {
+                    return read_error_code::mismatching_type;
+                }
+
+                constexpr auto mapped_is_nullable = is_nullable_v<mapped_t>;
+
+                if (mapped_is_nullable != mapped_nullable_flag) {
+                    return read_error_code::mismatching_nullable;
+                }
+
+                if (mapped_value_data_type != get_data_type<mapped_t>() || (mapped_is_varint && !is_varint_value_v<mapped_t>)) {
+                    return read_error_code::mismatching_type;
+                }
             }
-            else if constexpr (is_std_variant_v<value_t> == true) {
-                return write_variant(value);
+
+            auto element_count = size_t{ 0 };
+            if (auto error = this->template read_format_value<options_map_element_count_type>(element_count); error.has_value()) {
+                return error;
             }
-            else if constexpr (object_is_mapped<value_t>() == true) {
-                return write_object(value);
+
+            const auto header_size = block_input_size - m_input.size();
+            if constexpr (checks_input == true) {
+                if (header_size > block_offset) {
+                    return read_error_code::bad_map_offset;
+                }
             }
-            else if constexpr (object_is_formatted<value_t>() == true) {
-                return write_formatted(value);
+
+            if constexpr (Vverify == true) {
+                auto key_value = key_t{};
+                auto mapped_value = mapped_t{};
+
+                for (size_t i = 0; i < element_count; ++i) {
+                    if (auto map_error = map_impl<true>(key_value, key_is_varint); map_error) {
+                        return map_error;
+                    }
+                    if (auto map_error = map_impl<true>(mapped_value, mapped_is_varint); map_error) {
+                        return map_error;
+                    }
+                }
+
+                return {};
             }
-            else {
-                static_assert(always_false<value_t>, "Unmapped blopp data type.");
+            
+            use_memory_resource(value);
+
+            if (reads_in_parallel(element_count)) {
+                // Elements are read into slots of their own in parallel, and inserted in the map once all are read.
+                if (!has_bytes_left(element_count)) {
+                    return read_error_code::insufficient_data;
+                }
+
+                auto elements = std::vector<std::pair<key_t, mapped_t>>(element_count);
+
+                auto error = read_elements_in_parallel(
+                    elements,
+                    block_offset - header_size,
+                    false,
+                    [&](view_reader<TOptions, TInput>& reader) -> std::optional<read_error_code> {
+                        if (auto key_error = reader.skip_value(key_data_type, key_nullable_flag); key_error.has_value()) {
+                            return key_error;
+                        }
+                        return reader.skip_value(mapped_data_type, mapped_nullable_flag);
+                    },
+                    [&](read_context& context, auto& element_value) -> std::optional<read_error_code> {
+                        if (auto key_error = context.template map_impl<true>(element_value.first, key_is_varint); key_error.has_value()) {
+                            return key_error;
+                        }
+                        return context.template map_impl<true>(element_value.second, mapped_is_varint);
+                    });
+
+                if (error.has_value()) {
+                    return error;
+                }
+
+                // Duplicate keys keep their first value, as by serial reads.
+                value.clear();
+                for (auto& [key_value, mapped_value] : elements) {
+                    value.emplace_hint(value.end(), std::move(key_value), std::move(mapped_value));
+                }
+
+                return {};
             }
-        }
 
-        std::optional<write_error_code> m_error = {};
-        size_t m_property_count = 0;
-        write_reference_map& m_reference_map;
+            // Nodes of the previous entries are reused for the new ones, keeping their allocations.
+            auto old_value = std::move(value);
+            value.clear();
 
-    };
+            // References to values of other chunks are assigned once all chunks are read, so mapped values are read
+            // in their final slot. Keys can't change once inserted, so from the first key referencing a value of another chunk, 
+            // entries are read into nodes apart from the map, and inserted in order once the references are assigned.
+            using node_t = typename value_t::node_type;
+            auto deferred_nodes = std::shared_ptr<std::vector<node_t>>{};
 
-    class read_context_base {
+            for (size_t i = 0; i < element_count; ++i) {
+                const auto deferred_reference_count = get_deferred_reference_count();
+
+                auto node = node_t{};
+                if (!old_value.empty()) {
+                    node = old_value.extract(old_value.begin());
+                }
+                else if constexpr (may_hold_shared_ptr_v<key_t> == true) {
+                    // Keys of chunks are read into nodes, which keep their address once moved apart from the map.
+                    if (m_chunk_references != nullptr) {
+                        node = make_map_node(value);
+                    }
+                }
+
+                if (!node.empty()) {
+                    if (auto map_error = map_impl<true>(node.key(), key_is_varint); map_error) {
+                        return map_error;
+                    }
+
+                    if (deferred_nodes != nullptr || get_deferred_reference_count() != deferred_reference_count) {
+                        if (deferred_nodes == nullptr) {
+                            deferred_nodes = std::make_shared<std::vector<node_t>>();
+                            defer_map_insert(value, deferred_nodes);
+                        }
+
+                        if (auto map_error = map_impl<true>(node.mapped(), mapped_is_varint); map_error) {
+                            return map_error;
+                        }
+
+                        deferred_nodes->push_back(std::move(node));
+                        continue;
+                    }
+
+                    if (auto map_error = map_impl<true>(node.mapped(), mapped_is_varint); map_error) {
+                        return map_error;
+                    }
+
+                    // Duplicate keys keep their first value, as by std::map::insert, and the node is kept for reuse.
+                    if constexpr (is_specialization_v<value_t, std::map> == true) {
+                        if (auto insert_result = value.insert(std::move(node)); !insert_result.inserted) {
+                            old_value.insert(std::move(insert_result.node));
+                            drop_deferred_references(deferred_reference_count);
+                        }
+                    }
+                    else {
+                        value.insert(std::move(node));
+                    }
+                    continue;
+                }
+
+                auto key_value = key_t{};
 
-    protected:
+                if (auto map_error = map_impl<true>(key_value, key_is_varint); map_error) {
+                    return map_error;
+                }
 
-        explicit read_context_base(read_input_type& input) :
-            m_input{ input }
-        {}
+                // Duplicate keys keep their first value, as by std::map::insert.
+                auto mapped_value = mapped_t{};
+                auto* mapped_slot = &mapped_value;
 
-        [[nodiscard]] inline bool has_bytes_left(const size_t count)
-        {
-            return m_input.size() >= count;
-        }
+                if constexpr (is_specialization_v<value_t, std::map> == true) {
+                    if (auto [it, inserted] = value.try_emplace(std::move(key_value)); inserted) {
+                        mapped_slot = &it->second;
+                    }
+                }
+                else {
+                    mapped_slot = &value.emplace(std::move(key_value), mapped_t{})->second;
+                }
 
-        template<typename T>
-        [[nodiscard]] inline bool has_bytes_left(const size_t count)
-        {
-            constexpr auto max_count = std::numeric_limits<size_t>::max() / sizeof(T);
+                if (auto map_error = map_impl<true>(*mapped_slot, mapped_is_varint); map_error) {
+                    return map_error;
+                }
 
-            if (count > max_count) {
-                return false;
+                if (mapped_slot == &mapped_value) {
+                    drop_deferred_references(deferred_reference_count);
+                }
             }
 
-            return m_input.size() >= (count * sizeof(T));
+            return {};
         }
 
-        [[nodiscard]] inline data_types read_data_type() {
-            auto next_byte_without_flag = static_cast<uint8_t>(*m_input.data() & 0b01111111);
-            m_input = m_input.subspan(sizeof(uint8_t));
-            return static_cast<data_types>(next_byte_without_flag);
+        // Inserts nodes into map once references to values of other chunks are assigned, keeping the first value of duplicate keys.
+        template<typename TMap>
+        inline void defer_map_insert(TMap& map, std::shared_ptr<std::vector<typename TMap::node_type>> nodes) {
+            auto& deferred_insert = m_chunk_references->deferred_inserts.emplace_back();
+            deferred_insert.map = &map;
+            deferred_insert.nodes = std::move(nodes);
+            deferred_insert.insert = [](void* map_pointer, void* nodes_pointer) {
+                auto& map_value = *static_cast<TMap*>(map_pointer);
+                for (auto& node : *static_cast<std::vector<typename TMap::node_type>*>(nodes_pointer)) {
+                    map_value.insert(std::move(node));
+                }
+            };
         }
 
-        [[nodiscard]] inline uint8_t read_nullable_value_flags() {
-            auto value = static_cast<uint8_t>(*m_input.data() & 0b00000011);
-            m_input = m_input.subspan(sizeof(uint8_t));
-            return value;
+        // Node of a default key and mapped value, allocated as the entries of map.
+        template<typename TMap>
+        [[nodiscard]] static typename TMap::node_type make_map_node(const TMap& map) {
+            auto node_map = TMap(map.get_allocator());
+            node_map.emplace(std::piecewise_construct, std::tuple<>{}, std::tuple<>{});
+            return node_map.extract(node_map.begin());
         }
 
-        [[nodiscard]] inline std::pair<data_types, bool> read_data_type_with_nullable_flag() {
-            auto next_byte = *m_input.data();
-            auto next_byte_without_flag = static_cast<uint8_t>(next_byte & 0b01111111);
-            auto flag = static_cast<bool>(next_byte & 0b10000000);
-            m_input = m_input.subspan(sizeof(uint8_t));
-            return { static_cast<data_types>(next_byte_without_flag), flag };
+        [[nodiscard]] inline size_t get_deferred_reference_count() const {
+            return m_chunk_references != nullptr ? m_chunk_references->deferred.size() : 0;
         }
 
-        template<typename T>
-        inline void read_value(T& value) {
-            if constexpr (sizeof(T) == 1) {
-                value = static_cast<T>(*m_input.data());
+        // Drops references deferred while reading a value that is discarded, such as the value of a duplicate map key.
+        inline void drop_deferred_references(const size_t deferred_reference_count) {
+            if (m_chunk_references != nullptr) {
+                auto& deferred = m_chunk_references->deferred;
+                deferred.erase(deferred.begin() + static_cast<std::ptrdiff_t>(deferred_reference_count), deferred.end());
+            }
+        }
+
+        // Lists and maps are read in parallel chunks if enabled by parallel_read_chunk_size of the options.
+        // Allocations from a memory resource aren't synchronized, so values read into one are read serially.
+        [[nodiscard]] inline bool reads_in_parallel([[maybe_unused]] const size_t element_count) const {
+            if constexpr (options_parallel_read_chunk_size > 0 && Vverify == false) {
+                // Containers nested in chunks are read serially, as the chunks are already read in parallel.
+                return
+                    m_chunk_references == nullptr &&
+                    m_memory_resource == nullptr &&
+                    element_count >= options_parallel_read_chunk_size * 2;
             }
             else {
-                std::memcpy(&value, m_input.data(), sizeof(T));
+                return false;
             }
-            m_input = m_input.subspan(sizeof(T));
         }
 
-        template<typename T>
-        [[nodiscard]] inline T read_value() {
-            auto value = T{};
-            read_value(value);
-            return value;
-        }
+        // Reads elements into the preallocated slots of elements, in chunks on the read_executor of the options. 
+        // Chunks are located via the element index of the list if present, else by skipping over elements by their block offsets. 
+        template<typename TElementSkipper, typename TElementReader>
+        [[nodiscard]] inline auto read_elements_in_parallel(
+            auto& elements,
+            const size_t elements_size,
+            const bool has_element_index,
+            const TElementSkipper& skip_element,
+            const TElementReader& read_element) -> std::optional<read_error_code>
+        {
+            using elements_iterator_t = decltype(std::begin(elements));
 
-        template<typename TContainer>
-        [[nodiscard]] inline auto read_bool_container(TContainer& container, const size_t count) -> std::optional<read_error_code> {
-            using container_t = std::remove_cvref_t<decltype(container)>;
-            using element_t = typename container_t::value_type;
+            const auto element_count = static_cast<size_t>(std::size(elements));
+            const auto chunk_count = (element_count + options_parallel_read_chunk_size - 1) / options_parallel_read_chunk_size;
 
-            static_assert(std::is_same_v<element_t, bool>, "Wrong element type for blopp::read_bool_container");
+            auto elements_input = m_input.subspan(0, elements_size);
+            auto element_index_input = TInput{};
+            if (has_element_index) {
+                if (element_count > elements_size / sizeof(options_list_element_offset_type)) {
+                    return read_error_code::bad_list_element_index;
+                }
 
-            if constexpr (is_std_vector_v< container_t> == true) {
-                resize_add_container(container, count);
+                const auto element_index_size = element_count * sizeof(options_list_element_offset_type);
+                element_index_input = elements_input.subspan(elements_size - element_index_size);
+                elements_input = elements_input.subspan(0, elements_size - element_index_size);
             }
 
-            auto* src_element_ptr = m_input.data();
-            for (size_t i = 0; i < count; i++) {
-                auto raw_boolean_value = *(src_element_ptr++);
-                if (raw_boolean_value > 1) {
-                    return read_error_code::bad_boolean_value;
+            auto chunk_offsets = std::vector<size_t>(chunk_count + 1, elements_input.size());
+            auto chunk_begins = std::vector<elements_iterator_t>{};
+            chunk_begins.reserve(chunk_count);
+
+            auto scan_input = elements_input;
+            auto scan_reader = view_reader<TOptions, TInput>{ scan_input };
+            auto element_it = std::begin(elements);
+
+            for (size_t i = 0; i < element_count; ++i, ++element_it) {
+                if (i % options_parallel_read_chunk_size == 0) {
+                    chunk_begins.push_back(element_it);
+
+                    if (has_element_index) {
+                        auto element_index_reader_input = element_index_input.subspan(i * sizeof(options_list_element_offset_type));
+                        auto element_index_reader = view_reader<TOptions, TInput>{ element_index_reader_input };
+                        if (auto error = element_index_reader.read_list_element_offset(chunk_offsets[i / options_parallel_read_chunk_size]); error.has_value()) {
+                            return error;
+                        }
+                    }
+                    else {
+                        chunk_offsets[i / options_parallel_read_chunk_size] = elements_input.size() - scan_input.size();
+                    }
                 }
 
-                if constexpr (
-                    is_std_vector_v<container_t> == true ||
-                    is_std_array_v<container_t> == true ||
-                    is_std_span_v<container_t> == true)
-                {
-                    container.at(i) = static_cast<bool>(raw_boolean_value);
+                if (!has_element_index) {
+                    if (auto error = skip_element(scan_reader); error.has_value()) {
+                        return error;
+                    }
                 }
-                else {
-                    container.push_back(static_cast<bool>(raw_boolean_value));
+            }
+
+            for (size_t i = 0; i < chunk_count; ++i) {
+                if (chunk_offsets[i] > chunk_offsets[i + 1]) {
+                    return read_error_code::bad_list_element_index;
                 }
             }
 
-            return {};
-        }
+            auto chunk_errors = std::vector<std::optional<read_error_code>>(chunk_count);
+            auto chunk_references = std::vector<read_chunk_references>(chunk_count);
+
+            // The reference map is only read while chunks are read. References to values of other chunks are deferred.
+            options_read_executor::run(chunk_count, [&](const size_t chunk_index) {
+                const auto chunk_offset = chunk_offsets[chunk_index];
+                auto chunk_input = elements_input.subspan(chunk_offset, chunk_offsets[chunk_index + 1] - chunk_offset);
+                auto chunk_reference_map = read_reference_map<TOptions>{};
+                auto chunk_context = read_context{ chunk_input, m_original_input, 1, chunk_reference_map, m_resolve_missing_references };
+                chunk_context.m_depth = m_depth;
+                chunk_context.m_parent_reference_map = &m_reference_map;
+                chunk_context.m_chunk_references = &chunk_references[chunk_index];
+
+                const auto chunk_element_count = std::min(options_parallel_read_chunk_size, element_count - (chunk_index * options_parallel_read_chunk_size));
+                auto it = chunk_begins[chunk_index];
+                for (size_t i = 0; i < chunk_element_count; ++i, ++it) {
+                    if (chunk_errors[chunk_index] = read_element(chunk_context, *it); chunk_errors[chunk_index].has_value()) {
+                        return;
+                    }
+                }
 
-        template<typename TContainer>
-        [[nodiscard]] inline auto read_container(TContainer& container, const size_t count) -> std::optional<read_error_code> {
-            using container_t = std::remove_cvref_t<decltype(container)>;
-            using element_t = typename container_t::value_type;
+                // Chunks must end where the next chunk starts, as located via the element index.
+                if constexpr (checks_input == true) {
+                    if (!chunk_input.empty()) {
+                        chunk_errors[chunk_index] = read_error_code::bad_list_element_index;
+                    }
+                }
+            });
 
-            if (count == 0) {
-                return {};
+            for (const auto& chunk_error : chunk_errors) {
+                if (chunk_error.has_value()) {
+                    return chunk_error;
+                }
             }
 
-            if constexpr (std::is_same_v<element_t, bool> == true) {
-                if (auto error = read_bool_container(container, count); error.has_value()) {
-                    return error;
+            for (auto& references : chunk_references) {
+                for (auto& [position, reference] : references.values) {
+                    m_reference_map.insert(position, std::move(reference));
                 }
             }
-            else if constexpr (
-                is_std_array_v<container_t> == true ||
-                is_std_span_v<container_t> == true)
-            {
-                const auto* src_element_ptr = m_input.data();
-                auto* dest_element_ptr = container.data();
-                std::memcpy(dest_element_ptr, src_element_ptr, count * sizeof(element_t));
-            }
-            else if constexpr (std::contiguous_iterator<typename TContainer::iterator> == true) {
-                const size_t old_container_size = container.size();
-                container.resize(old_container_size + count);
-                const auto* src_element_ptr = m_input.data();
-                auto* dest_element_ptr = container.data() + old_container_size;
-                std::memcpy(dest_element_ptr, src_element_ptr, count * sizeof(element_t));  
+
+            for (const auto& references : chunk_references) {
+                for (const auto& deferred : references.deferred) {
+                    const auto* reference = m_reference_map.find(deferred.position);
+                    if (reference == nullptr) {
+                        if (deferred.read_skipped == nullptr) {
+                            return read_error_code::bad_reference_position;
+                        }
+                        if (auto error = deferred.read_skipped(this, deferred.target, deferred.position); error.has_value()) {
+                            return error;
+                        }
+                        continue;
+                    }
+                    if (reference->type_index != deferred.type_index) {
+                        return read_error_code::bad_reference_type;
+                    }
+                    deferred.assign(deferred.target, reference->pointer);
+                }
             }
-            else {
-                auto* src_element_ptr = m_input.data();
-                for (size_t i = 0; i < count; ++i) {
-                    auto element_value = element_t{};
-                    std::memcpy(&element_value, src_element_ptr, sizeof(element_t));
-                    container.push_back(element_value);
-                    src_element_ptr += sizeof(element_t);
+
+            // Entries of maps read by different chunks are inserted into different maps, in the order read.
+            for (const auto& references : chunk_references) {
+                for (const auto& deferred_insert : references.deferred_inserts) {
+                    deferred_insert.insert(deferred_insert.map, deferred_insert.nodes.get());
                 }
             }
 
-            m_input = m_input.subspan(count * sizeof(element_t));
+            skip_input_bytes(elements_input.size());
+
             return {};
         }
-        
-        read_input_type& m_input;
 
-    };
+        [[nodiscard]] inline auto read_formatted(auto& value) -> std::optional<read_error_code> {
+            using value_t = std::remove_cvref_t<decltype(value)>;
 
+            if (!has_bytes_left(sizeof(options_format_size_type))) {
+                return read_error_code::insufficient_data;
+            }
 
-    template<typename TOptions>
-    class read_format_context: private read_context_base {
+            const auto object_size = static_cast<size_t>(this->template read_value<options_format_size_type>());
+            if (!has_bytes_left(object_size)) {
+                return read_error_code::insufficient_data;
+            }
 
-    private:
+            auto format_read_context = read_format_context<TOptions, TInput, checks_input>{ m_input };
 
-        using options = TOptions;
-        using options_format_size_type = typename options::format_size_type;
-        static constexpr auto max_format_size = static_cast<size_t>(std::numeric_limits<options_format_size_type>::max());
+            using object_format_result_t = decltype(object<value_t>::format(format_read_context, value));
 
-    public:   
+            if constexpr (std::is_same_v<object_format_result_t, void> == true) {
+                object<value_t>::format(format_read_context, value);
 
-        static constexpr auto direction = context_direction::write;    
+                if (auto format_error = format_read_context.error(); format_error.has_value()) {
+                    return format_error.value();
+                }
+            }
+            else if constexpr (std::is_same_v<object_format_result_t, bool> == true) {
+                const auto format_result = object<value_t>::format(format_read_context, value);
 
-        explicit read_format_context(
-            read_input_type& input
-        ) :
-            read_context_base{ input }
-        {}
+                if (auto format_error = format_read_context.error(); format_error.has_value()) {
+                    return format_error.value();
+                }
+                if (!format_result) {
+                    return read_error_code::user_defined_failure;
+                }
+            }
+            else {
+                static_assert(always_false<value_t>, "Only void and bool return type of blopp::object<T>::format is supported.");
+            }
+  
+            return {};
+        }
 
-        read_format_context(const read_format_context&) = delete;
-        read_format_context(read_format_context&&) = delete;
-        read_format_context& operator = (const read_format_context&) = delete;
-        read_format_context& operator = (read_format_context&&) = delete;
+        // Reads value, of integers written as varints if is_varint is set, or if flagged by the data type read.
+        template<bool Vskip_data_type>
+        [[nodiscard]] inline auto map_impl(auto& value, bool is_varint = false) -> std::optional<read_error_code> {
+            using value_t = std::remove_cvref_t<decltype(value)>;
+            using value_fundamental_traits = fundamental_traits<value_t>;
 
-        template<typename ... T>
-        auto format(T& ... value) -> bool {
-            static_assert(sizeof...(value) > 0,
-                "Cannot pass 0 parameters to format function of blopp context.");
+            constexpr auto value_is_nullable = is_nullable_v<value_t>;
 
-            constexpr auto total_variadic_size = get_total_variadic_size<T...>();
+            if constexpr (Vskip_data_type == false) {
+                if (!has_bytes_left(sizeof(data_types))) {
+                    return read_error_code::insufficient_data;
+                }
 
-            static_assert(max_format_size >= total_variadic_size,
-                "Total size of variadics passed to blopp format exceeds max format size");
+                const auto [flagged_data_type, nullable_flag] = read_data_type_with_nullable_flag();
+                [[maybe_unused]] const auto [data_type, varint_flag] = split_varint_value_flag(flagged_data_type);
+                is_varint = varint_flag;
 
-            (void)( ( !m_error.has_value() && format_impl(value) ) && ...);
+                if constexpr (checks_input == true) {
+                    if (nullable_flag != value_is_nullable) {
+                        return read_error_code::mismatching_nullable;
+                    }
 
-            return !m_error.has_value();
-        }
+                    const auto value_data_type = get_data_type<value_t>();
+                    if (data_type != value_data_type || (is_varint && !is_varint_value_v<value_t>)) {
+                        return read_error_code::mismatching_type;
+                    }
+                }
+            }
 
-        [[nodiscard]] inline auto error() const {
-            return m_error;
+            if constexpr (value_is_nullable == true && is_std_shared_ptr_v<value_t> == false) {
+                if (!has_bytes_left(sizeof(uint8_t))) {
+                    return read_error_code::insufficient_data;
+                }
+
+                const auto nullable_value_flags = read_nullable_value_flags();
+
+                if constexpr (checks_input == true) {
+                    if (nullable_value_flags & static_cast<uint8_t>(nullable_value_flags::is_reference)) {
+                        return read_error_code::mismatching_reference;
+                    }
+                }
+
+                if (!nullable_value_flags)
+                {
+                    clear_nullable_value(value);
+                    return std::nullopt;
+                }
+            }
+
+            if constexpr (
+                value_fundamental_traits::is_fundamental == true ||
+                std::is_enum_v<value_t> == true ||
+                is_std_string_v<value_t> == true ||
+                is_std_string_view_v<value_t> == true ||
+                options_max_depth == std::numeric_limits<size_t>::max())
+            {
+                return read_payload(value, is_varint);
+            }
+            else {
+                // Nested values are limited to the max_depth of options, to fail instead of overflowing the stack.
+                if (m_depth == options_max_depth) {
+                    return read_error_code::max_depth_exceeded;
+                }
+
+                ++m_depth;
+                const auto error = read_payload(value, is_varint);
+                --m_depth;
+                return error;
+            }
         }
 
-    private:
+        [[nodiscard]] inline auto read_payload(auto& value, [[maybe_unused]] const bool is_varint) -> std::optional<read_error_code> {
+            using value_t = std::remove_cvref_t<decltype(value)>;
+            using value_fundamental_traits = fundamental_traits<value_t>;
 
-        template<typename ... T>
-        [[nodiscard]] inline static constexpr size_t get_total_variadic_size()
-        {
-            return (value_size_trait<std::remove_cvref_t<T>>::size + ...);
+            if constexpr (value_fundamental_traits::is_fundamental == true) {
+                return read_fundamental(value, is_varint);
+            }
+            else if constexpr (std::is_enum_v<value_t> == true) {
+                return read_enum(value, is_varint);
+            }
+            else if constexpr (
+                is_std_string_v<value_t> == true ||
+                is_std_string_view_v<value_t> == true)
+            {
+                return read_string(value);
+            }
+            else if constexpr (is_std_unique_ptr_v<value_t> == true) {
+                return read_unique_ptr(value, is_varint);
+            }
+            else if constexpr (is_std_shared_ptr_v<value_t> == true) {
+                return read_shared_ptr(value);
+            }
+            else if constexpr (is_std_optional_v<value_t> == true) {
+                return read_optional(value, is_varint);
+            }
+            else if constexpr (
+                is_std_array_v<value_t> == true ||
+                is_std_vector_v<value_t> == true ||
+                is_std_list_v<value_t> == true ||
+                is_std_const_span_v<value_t> == true)
+            {
+                return read_list(value);
+            }
+            else if constexpr (std::is_array_v<value_t> == true) {
+                auto array_span = std::span(value);
+                return read_list(array_span);
+            }
+            else if constexpr (is_std_variant_v<value_t> == true) {
+                return read_variant(value);
+            }
+            else if constexpr (is_std_map_v<value_t> == true) {
+                return read_map(value);
+            }
+            else if constexpr (object_is_mapped<value_t>() == true) {
+                return read_object(value);
+            }
+            else if constexpr (object_is_formatted<value_t>() == true) {
+                return read_formatted(value);
+            }
+            else {
+                static_assert(always_false<value_t>, "Unmapped blopp data type.");
+            }
         }
 
-        [[nodiscard]] inline auto read_fundamental(auto& value) -> bool {
-            using value_t = std::remove_cvref_t<decltype(value)>;
+        std::optional<read_error_code> m_error = {};
+        size_t m_property_count;
+        size_t m_max_property_count;
+        size_t m_depth = 0;
+        TInput m_original_input;
+        read_reference_map<TOptions>& m_reference_map;
+        bool m_resolve_missing_references;
+        std::pmr::memory_resource* m_memory_resource;
+        const read_reference_map<TOptions>* m_parent_reference_map = nullptr;
+        read_chunk_references* m_chunk_references = nullptr;
 
-            if (!has_bytes_left(sizeof(value_t)))
-            {
-                m_error = read_error_code::insufficient_data;
-                return false;
-            }
+    };
 
-            read_value(value);
-            return true;
-        }
+}
 
-        [[nodiscard]] inline auto read_array(auto& value) -> bool {
-            using value_t = std::remove_cvref_t<decltype(value)>;
-            using element_t = typename value_t::value_type;
-            using element_fundamental_traits = fundamental_traits<element_t>;
 
-            static_assert(
-                element_fundamental_traits::is_fundamental == true ||
-                std::is_enum_v<element_t> == true,
-                "Only fundamentals and enums are supported for blopp formatting of arrays.");
+namespace blopp
+{
 
-            if (!has_bytes_left<element_t>(value.size()))
-            {
-                m_error = read_error_code::insufficient_data;
-                return false;
-            }
+    template<typename T>
+    [[nodiscard]] auto write(const T& value) -> write_result_type {
+        return write<default_options, T>(value);
+    }
 
-            if (m_error = read_container(value, value.size());  m_error.has_value()) {
-                return false;
+    template<typename TOptions, typename T>
+    [[nodiscard]] auto write(const T& value) -> write_result_type {
+        if constexpr (impl::options_has_varint_v<TOptions> == true) {
+            // The plan sizes the output, and is reused to write it.
+            auto varint_plan_values = impl::varint_plan_values{};
+
+            auto size_result = impl::plan_varints<TOptions>(value, varint_plan_values);
+            if (!size_result) {
+                return make_unexpected<write_output_type, write_error_code>(size_result.error());
             }
 
-            return true;
-        }
+            auto result = write_output_type{};
+            result.reserve(size_result.value());
 
-        [[nodiscard]] inline auto format_impl(auto& value) -> bool {
-            using value_t = std::remove_cvref_t<decltype(value)>;
-            using value_fundamental_traits = fundamental_traits<value_t>;     
+            auto output_sink = vector_output_sink{ result };
 
-            if constexpr (
-                value_fundamental_traits::is_fundamental == true ||
-                std::is_enum_v<value_t> == true)
-            {
-                return read_fundamental(value);
+            if (auto error = impl::write_planned<TOptions>(value, output_sink, varint_plan_values); error) {
+                return make_unexpected<write_output_type, write_error_code>(error.value());
             }
-            else if constexpr (is_std_array_v<value_t> == true) {
-                return read_array(value);
-            }
-            else if constexpr (std::is_array_v<value_t> == true) {
-                auto array_span = std::span(value);
-                return read_array(array_span);
+
+            return result;
+        }
+        else {
+            auto size_result = serialized_size<TOptions, T>(value);
+            if (!size_result) {
+                return make_unexpected<write_output_type, write_error_code>(size_result.error());
             }
-            else {
-                static_assert(always_false<value_t>, "Unmapped blopp format data type.");
+
+            auto result = write_output_type{};
+            result.reserve(size_result.value());
+
+            if (auto write_span_result = write<TOptions, T>(value, result); !write_span_result) {
+                return make_unexpected<write_output_type, write_error_code>(write_span_result.error());
             }
-        }
 
-        std::optional<read_error_code> m_error;
+            return result;
+        }
+    }
 
-    };
+    template<typename T>
+    [[nodiscard]] auto write(
+        const T& value,
+        write_output_type& output,
+        write_output_mode output_mode) -> write_span_result_type
+    {
+        return write<default_options, T>(value, output, output_mode);
+    }
 
-    struct read_reference {
-        std::shared_ptr<void> pointer;
-        std::type_index type_index;
-    };
+    template<typename TOptions, typename T>
+    [[nodiscard]] auto write(
+        const T& value,
+        write_output_type& output,
+        write_output_mode output_mode) -> write_span_result_type
+    {
+        if (output_mode == write_output_mode::replace) {
+            output.clear();
+        }
 
-    using read_reference_map = std::map<uint64_t, read_reference>;
+        const auto output_start_position = output.size();
 
-    template<typename TOptions>
-    class read_context : private read_context_base {
+        auto output_sink = vector_output_sink{ output };
 
-    public:
+        if (auto result = write<TOptions, T>(value, output_sink); !result) {
+            output.resize(output_start_position);
+            return make_unexpected<write_output_span_type, write_error_code>(result.error());
+        }
 
-        static constexpr auto direction = context_direction::read;
+        return write_output_span_type{ output.data() + output_start_position, output.size() - output_start_position };
+    }
 
-        explicit read_context(
-            read_input_type& input,
-            read_input_type original_input,
-            size_t max_property_count,
-            read_reference_map& reference_map
-        ) :
-            read_context_base{ input },
-            m_property_count{ 0 },
-            m_max_property_count{ max_property_count },
-            m_original_input{ original_input },
-            m_reference_map{ reference_map }
-        {} 
+    template<typename T>
+    [[nodiscard]] auto write_to(write_to_output_type output, const T& value) -> write_to_result_type {
+        return write_to<default_options, T>(output, value);
+    }
 
-        read_context(const read_context&) = delete;
-        read_context(read_context&&) = delete;
-        read_context& operator = (const read_context&) = delete;
-        read_context& operator = (read_context&&) = delete;
+    template<typename TOptions, typename T>
+    [[nodiscard]] auto write_to(write_to_output_type output, const T& value) -> write_to_result_type {
+        auto output_sink = span_output_sink{ output };
 
-        template<typename ... T>
-        auto map(T& ... value) -> bool {
-            static_assert(sizeof...(value) > 0, "Cannot pass 0 parameters to map function of blopp context.");
-            
-            if constexpr (sizeof...(value) == 1) {
-                if (m_error.has_value()) {
-                    return false;
-                }
+        if (auto result = write<TOptions, T>(value, output_sink); !result) {
+            return make_unexpected<size_t, write_error_code>(result.error());
+        }
 
-                ++m_property_count;
-                if (m_property_count > m_max_property_count) {
-                    m_error = read_error_code::mismatching_object_property_count;
-                }
-                else {
-                    ((m_error = map_impl<false>(value)), ...);
-                }
-            }
-            else {             
-                (void)((!m_error.has_value() && (++m_property_count <= m_max_property_count) && (m_error = map_impl<false>(value), 1) ) && ...);
+        return output_sink.position();
+    }
 
-                if (!m_error.has_value() && m_property_count > m_max_property_count) {
-                    m_error = read_error_code::mismatching_object_property_count;
-                }
-            }
+    template<typename T>
+    [[nodiscard]] auto serialized_size(const T& value) -> serialized_size_result_type {
+        return serialized_size<default_options, T>(value);
+    }
 
-            return !m_error.has_value();
+    template<typename TOptions, typename T>
+    [[nodiscard]] auto serialized_size(const T& value) -> serialized_size_result_type {
+        if constexpr (impl::options_has_varint_v<TOptions> == true) {
+            auto varint_plan_values = impl::varint_plan_values{};
+            return impl::plan_varints<TOptions>(value, varint_plan_values);
         }
 
-        template<typename Tas, typename T>
-        auto map_as(T& value) -> bool {
-            using from_t = std::remove_cvref_t<Tas>;
-            using to_t = std::remove_cvref_t<T>;
+        auto output_sink = counting_output_sink{};
 
-            static_assert(std::is_integral_v<Tas> || std::is_floating_point_v<Tas>,
-                "Can only cast integral and floating point types.");
+        if (auto result = write<TOptions, T>(value, output_sink); !result) {
+            return make_unexpected<size_t, write_error_code>(result.error());
+        }
 
-            if constexpr (std::is_same_v<to_t, from_t> == true) {
-                return map(value);
-            }
-            else if constexpr (
-                (std::is_integral_v<to_t> == true && std::is_integral_v<from_t> == true) ||
-                (std::is_floating_point_v<to_t> == true && std::is_integral_v<from_t> == true))
-            {
-                auto from_value = from_t{};
-                if (!map(from_value)) {
-                    return false;
-                }
+        return output_sink.position();
+    }
 
-                if (conversion_overflows<from_t, to_t>(from_value)) {
-                    m_error = read_error_code::conversion_overflow;
-                    return false;
-                }
+    template<typename T, output_sink TOutputSink>
+    [[nodiscard]] auto write(const T& value, TOutputSink& output_sink) -> write_void_result_type {
+        return write<default_options, T, TOutputSink>(value, output_sink);
+    }
 
-                value = static_cast<to_t>(from_value);
-                return true;
-            }
-            else if constexpr (
-                (std::is_floating_point_v<to_t> == true && std::is_floating_point_v<from_t> == true) ||
-                (std::is_integral_v<to_t> == true && std::is_floating_point_v<from_t> == true))
-            {
-                auto from_value = from_t{};
-                if (!map(from_value)) {
-                    return false;
-                }
+    template<typename TOptions, typename T, output_sink TOutputSink>
+    [[nodiscard]] auto write(const T& value, TOutputSink& output_sink) -> write_void_result_type {
+        auto varint_plan_values = impl::varint_plan_values{};
 
-                value = static_cast<to_t>(from_value);
-                return true;
-            }
-            else {
-                static_assert(always_false<Tas>, "Mising map_as case.");
+        if constexpr (impl::options_has_varint_v<TOptions> == true) {
+            if (auto plan_result = impl::plan_varints<TOptions>(value, varint_plan_values); !plan_result) {
+                return make_unexpected<void, write_error_code>(plan_result.error());
             }
         }
 
-        [[nodiscard]] inline auto error() const {
-            return m_error;
+        if (auto error = impl::write_planned<TOptions>(value, output_sink, varint_plan_values); error) {
+            return make_unexpected<void, write_error_code>(error.value());
         }
 
-    private:
+        return {};
+    }
 
-        using options = TOptions;
-        using options_object_property_count_type = typename options::object_property_count_type;
-        using options_string_offset_type = typename options::string_offset_type;
-        using options_string_char_size_type = typename options::string_char_size_type;
-        using options_object_offset_type = typename options::object_offset_type;
-        using options_list_offset_type = typename options::list_offset_type;
-        using options_list_element_count_type = typename options::list_element_count_type;
-        using options_map_offset_type = typename options::map_offset_type;
-        using options_map_element_count_type = typename options::map_element_count_type;
-        using options_variant_index_type = typename options::variant_index_type;
-        using options_format_size_type = typename options::format_size_type;
+#if !defined(BLOPP_NO_FILESYSTEM)
 
-        constexpr static auto min_string_offset = sizeof(options_string_char_size_type);
-        constexpr static auto min_object_offset = sizeof(options_object_property_count_type);
-        constexpr static auto min_list_offset = sizeof(data_types) + sizeof(options_list_element_count_type);
-        constexpr static auto min_map_offset = sizeof(data_types) + sizeof(data_types) + sizeof(options_map_element_count_type);
+    template<typename T>
+    [[nodiscard]] auto write(const T& value, std::ostream& stream, const size_t chunk_size) -> write_void_result_type {
+        return  write<default_options, T>(value, stream, chunk_size);
+    } 
 
-        static constexpr auto options_allow_object_excess_bytes = options::allow_object_excess_bytes;
-        static constexpr auto options_allow_more_object_members = options::allow_more_object_members;
+    template<typename TOptions, typename T>
+    [[nodiscard]] auto write(const T& value, std::ostream& stream, const size_t chunk_size) -> write_void_result_type {
+        auto output_sink = stream_output_sink{ stream, chunk_size };
 
-        inline void skip_input_bytes(const size_t byte_count) {
-            m_input = m_input.subspan(byte_count);
+        if (auto result = write<TOptions, T>(value, output_sink); !result) {
+            return result;
         }
 
-        template<typename T>
-        inline auto read_fundamental_value(T& value) -> std::optional<read_error_code> {
-            using value_t = std::remove_cvref_t<T>;
+        output_sink.flush();
 
-            if (!has_bytes_left(sizeof(value_t))) {
-                return read_error_code::insufficient_data;
-            }
+        if (auto error = output_sink.error(); error) {
+            return make_unexpected<void, write_error_code>(error.value());
+        }
 
-            if constexpr (std::is_same_v<value_t, bool> == true) {
-                auto raw_boolean_value = read_value<uint8_t>();
-                if (raw_boolean_value > 1) {
-                    return read_error_code::bad_boolean_value;
-                }
-                value = static_cast<bool>(raw_boolean_value);
+        return {};
+    }
+
+    template<typename T>
+    [[nodiscard]] auto write(const T& value, const std::filesystem::path& path) -> write_void_result_type {
+        return write<default_options, T>(value, path);
+    }
+
+    template<typename TOptions, typename T>
+    [[nodiscard]] auto write(const T& value, const std::filesystem::path& path) -> write_void_result_type {
+#if defined(BLOPP_HAS_MEMORY_MAPPING)
+        if (auto output_sink_result = mapped_file_output_sink::open(path); output_sink_result) {
+            auto& output_sink = output_sink_result.value();
+
+            if (auto result = write<TOptions, T>(value, output_sink); !result) {
+                output_sink.discard();
+                return result;
             }
-            else {
-                read_value(value);
+
+            if (!output_sink.finish()) {
+                return make_unexpected<void, write_error_code>(write_error_code::cannot_write_file);
             }
-            
+
             return {};
         }
+#endif
 
-        [[nodiscard]] inline auto read_fundamental(auto& value) -> std::optional<read_error_code> {
-            return read_fundamental_value(value);
+        std::ofstream stream(path, std::ofstream::binary);
+        if (!stream.is_open()) {
+            return make_unexpected<void, write_error_code>(write_error_code::cannot_open_file);
         }
 
-        [[nodiscard]] inline auto read_enum(auto& value) -> std::optional<read_error_code> {
-            using value_t = std::underlying_type_t<std::remove_cvref_t<decltype(value)>>;
-            return read_fundamental_value(reinterpret_cast<value_t&>(value));
-        }
+        return write<TOptions, T>(value, stream);
+    }
 
-        [[nodiscard]] inline auto read_string(auto& value) -> std::optional<read_error_code> {
-            using value_t = std::remove_cvref_t<decltype(value)>;
-            using char_t = typename value_t::value_type;
-            
-            if (!has_bytes_left(sizeof(options_string_offset_type) + sizeof(options_string_char_size_type))) {
-                return read_error_code::insufficient_data;
-            }
+#endif
 
-            const auto block_offset = static_cast<size_t>(read_value<options_string_offset_type>());
-            if (block_offset < min_string_offset) {
-                return read_error_code::bad_string_offset;
-            }
+    template<typename T>
+    [[nodiscard]] auto read(read_input_type input) -> read_result_type<T> {
+        return read<default_options, T>(input);
+    }
 
-            if (!has_bytes_left(block_offset)) {
-                return read_error_code::insufficient_data;
-            }
+    template<typename TOptions, typename T>
+    [[nodiscard]] auto read(read_input_type input) -> read_result_type<T> {
+        return read<TOptions, T>(input, nullptr);
+    }
 
-            const auto char_size = read_value<options_string_char_size_type>();
-            if (char_size != sizeof(char_t)) {
-                return read_error_code::mismatching_string_char_size;
-            }
+    template<typename T>
+    [[nodiscard]] auto read(read_input_type input, std::pmr::memory_resource* memory_resource) -> read_result_type<T> {
+        return read<default_options, T>(input, memory_resource);
+    }
+
+    template<typename TOptions, typename T>
+    [[nodiscard]] auto read(read_input_type input, std::pmr::memory_resource* memory_resource) -> read_result_type<T> {
+        auto result = read_result<T>{};
+
+        read_input_type input_remaining = input;
+        impl::read_reference_map<TOptions> reference_map = {};
+        
+        auto context = impl::read_context<TOptions>{ 
+            input_remaining,
+            input_remaining,
+            1,
+            reference_map,
+            false,
+            memory_resource
+        };
+
+        context.map(result.value);
+
+        if (auto error = context.error(); error) {
+            return make_unexpected<read_result<T>, read_error_code>(error.value());
+        }
 
-            value.clear();
+        result.remaining = input_remaining;
+        return result;
+    }
 
-            const auto string_size = (block_offset - 1) / sizeof(char_t);
-            if (auto error = read_container(value, string_size); error.has_value()) {
-                return error;
-            }
+    template<typename T>
+    [[nodiscard]] auto read_into(read_input_type input, T& value) -> read_into_result_type {
+        return read_into<default_options, T>(input, value);
+    }
 
-            return {};
-        }
+    template<typename TOptions, typename T>
+    [[nodiscard]] auto read_into(read_input_type input, T& value) -> read_into_result_type {
+        read_input_type input_remaining = input;
+        impl::read_reference_map<TOptions> reference_map = {};
 
-        [[nodiscard]] inline auto read_unique_ptr(auto& value) -> std::optional<read_error_code> {
-            using value_t = std::remove_cvref_t<decltype(value)>;
-            using element_t = typename value_t::element_type;
+        auto context = impl::read_context<TOptions>{
+            input_remaining,
+            input_remaining,
+            1,
+            reference_map
+        };
 
-            if (!has_bytes_left(sizeof(data_types))) {
-                return read_error_code::insufficient_data;
-            }
+        context.map(value);
 
-            value = std::make_unique<element_t>();
-            return map_impl<true>(*value);
+        if (auto error = context.error(); error) {
+            return make_unexpected<read_input_type, read_error_code>(error.value());
         }
 
-        [[nodiscard]] inline auto read_shared_ptr(auto& value) -> std::optional<read_error_code> {
-            using value_t = std::remove_cvref_t<decltype(value)>;
-            using element_t = typename value_t::element_type;
-
-            if (!has_bytes_left(sizeof(uint8_t))) {
-                return read_error_code::insufficient_data;
-            }
+        return input_remaining;
+    }
 
-            const auto nullable_value_flags = read_nullable_value_flags();
+    template<typename T>
+    [[nodiscard]] auto verify(read_input_type input) -> verify_result_type {
+        return verify<default_options, T>(input);
+    }
 
-            if (!(nullable_value_flags & static_cast<uint8_t>(nullable_value_flags::has_value))) {
-                clear_nullable_value(value);
-                return std::nullopt;
-            }
+    template<typename TOptions, typename T>
+    [[nodiscard]] auto verify(read_input_type input) -> verify_result_type {
+        auto value = T{};
 
-            if (nullable_value_flags & static_cast<uint8_t>(nullable_value_flags::is_reference)) {
-                if (!has_bytes_left(sizeof(uint64_t))) {
-                    return read_error_code::insufficient_data;
-                }
-                const auto position = read_value<uint64_t>();
+        read_input_type input_remaining = input;
+        impl::read_reference_map<TOptions> reference_map = {};
 
-                auto it = m_reference_map.find(position);
-                if (it == m_reference_map.end()) {
-                    return read_error_code::bad_reference_position;
-                }
+        auto context = impl::read_context<TOptions, read_input_type, true>{
+            input_remaining,
+            input_remaining,
+            1,
+            reference_map
+        };
 
-                if (it->second.type_index != std::type_index(typeid(element_t))) {
-                    return read_error_code::bad_reference_type;
-                }
+        context.map(value);
 
-                value = std::static_pointer_cast<element_t>(it->second.pointer);
-                return std::nullopt;
-            }
+        if (auto error = context.error(); error) {
+            return make_unexpected<read_input_type, read_error_code>(error.value());
+        }
 
-            value = std::make_shared<element_t>();
+        return input_remaining;
+    }
 
-            const auto position = static_cast<uint64_t>(m_input.data() - m_original_input.data());
+    template<typename T>
+    [[nodiscard]] auto read(read_segmented_input_type input) -> segmented_read_result_type<T> {
+        return read<default_options, T>(input);
+    }
 
-            m_reference_map.emplace(position, read_reference{
-                .pointer = value,
-                .type_index = std::type_index(typeid(element_t))
-            });
+    template<typename TOptions, typename T>
+    [[nodiscard]] auto read(read_segmented_input_type input) -> segmented_read_result_type<T> {
+        auto result = segmented_read_result<T>{};
 
-            return map_impl<true>(*value);
-        }
+        const auto original_input = impl::segmented_input{ input };
+        auto input_remaining = original_input;
+        impl::read_reference_map<TOptions> reference_map = {};
 
-        [[nodiscard]] inline auto read_optional(auto& value) -> std::optional<read_error_code> {
-            using value_t = std::remove_cvref_t<decltype(value)>;
-            using element_t = typename value_t::value_type;
+        auto context = impl::read_context<TOptions, impl::segmented_input>{
+            input_remaining,
+            original_input,
+            1,
+            reference_map
+        };
 
-            if (!has_bytes_left(sizeof(data_types))) {
-                return read_error_code::insufficient_data;
-            }
+        context.map(result.value);
 
-            value = std::make_optional<element_t>();
-            return map_impl<true>(*value);
+        if (auto error = context.error(); error) {
+            return make_unexpected<segmented_read_result<T>, read_error_code>(error.value());
         }
 
-        template<typename T, typename ... Ts>
-        [[nodiscard]] inline auto read_variant_value(std::variant<Ts...>& value) -> std::optional<read_error_code>
-        {
-            value = T{};
-            return map_impl<false>(std::get<T>(value));
-        }
+        result.read_size = original_input.size() - input_remaining.size();
+        return result;
+    }
 
-        template<typename ... Ts>
-        [[nodiscard]] inline auto read_variant(std::variant<Ts...>& value) -> std::optional<read_error_code> {
-            if (!has_bytes_left(sizeof(options_variant_index_type))) {
-                return read_error_code::insufficient_data;
-            }
+#if !defined(BLOPP_NO_FILESYSTEM)
 
-            const auto index = static_cast<size_t>(read_value<options_variant_index_type>());
-            if (index >= sizeof...(Ts)) {
-                return read_error_code::bad_variant_index;
-            }
+    template<typename T>
+    [[nodiscard]] auto read(std::istream& stream) -> read_result_type<T> {
+        return read<default_options, T>(stream);
+    }
+
+    template<typename TOptions, typename T>
+    [[nodiscard]] auto read(std::istream& stream) -> read_result_type<T> {
+        impl::assert_no_input_views<T>();
 
-            size_t loop_index = 0;
-            auto read_variant_error = std::optional<read_error_code>{};
+        const auto streamStart = stream.tellg();
+        stream.seekg(0, std::istream::end);
+        const auto streamEnd = stream.tellg();
+        stream.clear();
+        stream.seekg(streamStart, std::istream::beg);
 
-            (void)((index == loop_index++ && ((read_variant_error = read_variant_value<Ts>(value)), 1)) || ...);
+        auto data = std::vector<uint8_t>{ };
 
-            return read_variant_error;
+        // Streams without a known size, such as pipes and files of /proc, are read until their end.
+        if (streamStart != std::istream::pos_type(-1) && streamEnd > streamStart) {
+            data.resize(static_cast<size_t>(streamEnd - streamStart));
+            stream.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(data.size()));
+        }
+        else {
+            stream.clear();
+            data.assign(std::istreambuf_iterator<char>{ stream }, std::istreambuf_iterator<char>{});
         }
 
-        [[nodiscard]] inline auto read_object(auto& value) -> std::optional<read_error_code> {
-            using value_t = std::remove_cvref_t<decltype(value)>;
+        return read<TOptions, T>(data);
+    }
 
-            if (!has_bytes_left(sizeof(options_object_offset_type) + sizeof(options_object_property_count_type))) {
-                return read_error_code::insufficient_data;
-            }
+    template<typename T>
+    [[nodiscard]] auto read(const std::filesystem::path& path) -> read_result_type<T> {
+        return read<default_options, T>(path);
+    }
 
-            const auto block_offset = static_cast<size_t>(read_value<options_object_offset_type>());
-            if (block_offset < min_object_offset) {
-                return read_error_code::bad_object_offset;
-            }
+    template<typename TOptions, typename T>
+    [[nodiscard]] auto read(const std::filesystem::path& path) -> read_result_type<T> {
+        impl::assert_no_input_views<T>();
 
-            if (!has_bytes_left(block_offset)) {
-                return read_error_code::insufficient_data;
-            }
+#if defined(BLOPP_HAS_MEMORY_MAPPING)
+        auto mapped_file_result = mapped_file::open(path, mapped_file_advice::sequential);
+        if (!mapped_file_result) {
+            return make_unexpected<read_result<T>, read_error_code>(mapped_file_result.error());
+        }
 
-            const auto property_count = static_cast<size_t>(read_value<options_object_property_count_type>());
+        // Files without a size to map, such as pipes and files of /proc, are read as streams.
+        if (mapped_file_result->size() > 0) {
+            auto result = read<TOptions, T>(mapped_file_result->data());
+            if (result) {
+                result->remaining = {};
+            }
 
-            const auto object_offset = block_offset - sizeof(options_object_property_count_type);
+            return result;
+        }
+#endif
+        std::ifstream stream(path, std::ios::binary);
+        if (!stream.is_open()) {
+            return make_unexpected<read_result<T>, read_error_code>(read_error_code::cannot_open_file);
+        }
 
-            auto object_input = m_input.subspan(0, object_offset);
-            auto object_read_context = read_context{ object_input, m_original_input, property_count, m_reference_map };
-            
-            using object_map_result_t = decltype(object<value_t>::map(object_read_context, value));
+        return read<TOptions, T>(stream);
+    }
 
-            if constexpr (std::is_same_v<object_map_result_t, void> == true) {
-                object<value_t>::map(object_read_context, value);
+#endif
 
-                if (object_read_context.m_error) {
-                    return object_read_context.m_error.value();
+    template<typename T, typename TOptions>
+    [[nodiscard]] auto encoder<T, TOptions>::write(write_to_output_type output) -> encode_result_type {
+        // Varints planned within skipped blocks are skipped along with the blocks, which only blocks of varint offsets do.
+        static_assert(
+            (impl::is_varint_v<typename TOptions::object_offset_type> == false &&
+                impl::is_varint_v<typename TOptions::object_property_count_type> == false &&
+                impl::is_varint_v<typename TOptions::list_offset_type> == false &&
+                impl::is_varint_v<typename TOptions::map_offset_type> == false) ||
+            (impl::is_varint_v<typename TOptions::object_offset_type> == true &&
+                impl::is_varint_v<typename TOptions::list_offset_type> == true &&
+                impl::is_varint_v<typename TOptions::map_offset_type> == true),
+            "blopp::encoder requires object, list and map offsets to be varints, if any of them or the object property count is.");
+
+        if (m_is_planned == false) {
+            if constexpr (impl::options_has_varint_v<TOptions> == true) {
+                if (auto plan_result = impl::plan_varints<TOptions>(m_value, m_varint_plan); !plan_result) {
+                    m_error = plan_result.error();
                 }
             }
-            else if constexpr (std::is_same_v<object_map_result_t, bool> == true) {
-                const auto map_result = object<value_t>::map(object_read_context, value);
 
-                if (object_read_context.m_error) {
-                    return object_read_context.m_error.value();
-                }
-                if (!map_result) {
-                    return read_error_code::user_defined_failure;
-                }
-            }
-            else {
-                static_assert(always_false<value_t>, "Only void and bool return type of blopp::object<T>::map is supported.");
-            }
+            if (m_error.has_value() == false) {
+                auto plan_output_sink = impl::write_plan_output_sink<decltype(m_plan)>{ m_plan };
+                auto varint_plan = impl::varint_plan{ m_varint_plan };
 
-            if constexpr (options_allow_object_excess_bytes == false) {
-                if (!object_input.empty()) {
-                    return read_error_code::bad_object_excess_bytes;
-                }
+                m_error = impl::write_pass<TOptions>(m_value, plan_output_sink, varint_plan);
+                m_size = plan_output_sink.position();
+                plan_output_sink.complete();
             }
 
-            if constexpr (options_allow_more_object_members == false) {
-                if (object_read_context.m_property_count < property_count) {
-                    return read_error_code::mismatching_object_property_count;
-                }
-            }
+            m_is_planned = true;
+        }
 
-            skip_input_bytes(object_offset);
+        if (m_error.has_value()) {
+            return make_unexpected<encode_result, write_error_code>(m_error.value());
+        }
 
-            return {};
+        if (m_position == m_size) {
+            return encode_result{ encode_status::complete, 0 };
         }
 
-        [[nodiscard]] inline auto read_list(auto& value) -> std::optional<read_error_code> {
-            using value_t = std::remove_cvref_t<decltype(value)>;
-            using element_t = typename value_t::value_type;
-            using element_fundamental_traits = fundamental_traits<element_t>;
+        auto window_output_sink = impl::write_window_output_sink<decltype(m_plan)>{ m_plan, output, m_position };
+        auto varint_plan = impl::varint_plan{ m_varint_plan };
 
-            if (!has_bytes_left(sizeof(options_list_offset_type) + sizeof(data_types) + sizeof(options_list_element_count_type))) {
-                return read_error_code::insufficient_data;
-            }
+        if (auto error = impl::write_pass<TOptions>(m_value, window_output_sink, varint_plan); error) {
+            m_error = error;
+            return make_unexpected<encode_result, write_error_code>(error.value());
+        }
 
-            const auto block_offset = static_cast<size_t>(read_value<options_list_offset_type>());
-            if (block_offset < min_list_offset) {
-                return read_error_code::bad_list_offset;
-            }
+        const auto written_size = std::min(output.size(), m_size - m_position);
+        m_position += written_size;
 
-            if (!has_bytes_left(block_offset)) {
-                return read_error_code::insufficient_data;
-            }
+        return encode_result{ status(), written_size };
+    }
 
-            const auto [element_data_type, element_nullable_flag] = read_data_type_with_nullable_flag();
-            constexpr auto element_is_nullable = is_nullable_v<element_t>;
+    template<typename T, typename TOptions>
+    [[nodiscard]] auto decoder<T, TOptions>::push(read_input_type input) -> decode_result_type {
+        if (m_error.has_value()) {
+            return make_unexpected<decode_result, read_error_code>(m_error.value());
+        }
 
-            if (element_nullable_flag != element_is_nullable) {
-                return read_error_code::mismatching_nullable;
-            }
+        if (m_stage == scan_stage::complete) {
+            return decode_result{ decode_status::complete, 0 };
+        }
 
-            if (element_data_type != get_data_type<element_t>()) {
-                return read_error_code::mismatching_type;
+        if (m_buffer.empty()) {
+            if (m_error = scan(input); m_error.has_value()) {
+                return make_unexpected<decode_result, read_error_code>(m_error.value());
             }
 
-            const auto element_count = static_cast<size_t>(read_value<options_list_element_count_type>());
-            if constexpr (is_std_array_v<value_t> == true) {
-                if (element_count != value.size()) {
-                    return read_error_code::mismatching_array_size;
-                }
+            if (m_stage == scan_stage::message && input.size() >= m_message_size) {
+                return read_message(input.first(m_message_size));
             }
 
-            clear_container(value);
-
-            if constexpr (element_fundamental_traits::is_fundamental == true) {
-                if (!has_bytes_left<element_t>(element_count)) {
-                    return read_error_code::insufficient_data;
-                }
+            m_buffer.assign(input.begin(), input.end());
+            return decode_result{ decode_status::need_more_data, input.size() };
+        }
 
-                if (auto error = read_container(value, element_count); error.has_value()) {
-                    return error;
-                }
-            }
-            else {
-                for (size_t i = 0; i < element_count; ++i) {
-                    auto& element_value = emplace_container(value, i);
-                    if (auto map_error = map_impl<true>(element_value); map_error) {
-                        return map_error;
-                    }
-                }
-            }
+        size_t consumed_size = 0;
 
-            return {};
-        }
+        while (true) {
+            const auto required_size = m_stage == scan_stage::message ? m_message_size : m_required_size;
+            const auto append_size = std::min(required_size - m_buffer.size(), input.size() - consumed_size);
 
-        [[nodiscard]] inline auto read_map(auto& value) -> std::optional<read_error_code> {
-            using value_t = std::remove_cvref_t<decltype(value)>;
-            using key_t = typename value_t::key_type;
-            using mapped_t = typename value_t::mapped_type;
+            m_buffer.insert(m_buffer.end(), input.begin() + consumed_size, input.begin() + consumed_size + append_size);
+            consumed_size += append_size;
 
-            if (!has_bytes_left(
-                    sizeof(options_map_offset_type) + sizeof(data_types) + 
-                    sizeof(data_types) + sizeof(options_map_element_count_type)))
-            {
-                return read_error_code::insufficient_data;
+            if (m_buffer.size() < required_size) {
+                return decode_result{ decode_status::need_more_data, consumed_size };
             }
 
-            const auto block_offset = static_cast<size_t>(read_value<options_map_offset_type>());
-            if (block_offset < min_map_offset) {
-                return read_error_code::bad_map_offset;
+            if (m_stage == scan_stage::message) {
+                auto result = read_message(m_buffer);
+                if (result) {
+                    result->consumed_size = consumed_size;
+                }
+                return result;
             }
 
-            if (!has_bytes_left(block_offset)) {
-                return read_error_code::insufficient_data;
+            if (m_error = scan(m_buffer); m_error.has_value()) {
+                return make_unexpected<decode_result, read_error_code>(m_error.value());
             }
+        }
+    }
 
-            const auto [key_data_type, key_nullable_flag] = read_data_type_with_nullable_flag();
-            constexpr auto key_is_nullable = is_nullable_v<key_t>;
+    template<typename T, typename TOptions>
+    [[nodiscard]] auto decoder<T, TOptions>::scan(read_input_type input) -> std::optional<read_error_code> {
+        using data_types = impl::data_types;
+        using variant_index_type = typename TOptions::variant_index_type;
+
+        while (true) {
+            switch (m_stage) {
+                case scan_stage::data_type: {
+                    m_required_size = m_scan_position + sizeof(data_types);
+                    if (input.size() < m_required_size) {
+                        return {};
+                    }
 
-            if (key_is_nullable != key_nullable_flag) {
-                return read_error_code::mismatching_nullable;
-            }
+                    const auto data_type_byte = input[m_scan_position];
+                    m_data_type = static_cast<uint8_t>(data_type_byte & 0b01111111);
+                    m_scan_position += sizeof(data_types);
+                    m_stage = (data_type_byte & 0b10000000) ? scan_stage::nullable_value_flags : scan_stage::payload;
+                } break;
+                case scan_stage::nullable_value_flags: {
+                    m_required_size = m_scan_position + sizeof(uint8_t);
+                    if (input.size() < m_required_size) {
+                        return {};
+                    }
 
-            if (key_data_type != get_data_type<key_t>()) {
-                return read_error_code::mismatching_type;
-            }
+                    const auto nullable_value_flags = static_cast<uint8_t>(input[m_scan_position] & 0b00000011);
+                    m_scan_position += sizeof(uint8_t);
 
-            const auto [mapped_data_type, mapped_nullable_flag] = read_data_type_with_nullable_flag();
-            constexpr auto mapped_is_nullable = is_nullable_v<mapped_t>;
+                    if (!(nullable_value_flags & static_cast<uint8_t>(impl::nullable_value_flags::has_value))) {
+                        m_message_size = m_scan_position;
+                        m_stage = scan_stage::message;
+                        return {};
+                    }
 
-            if (mapped_is_nullable != mapped_nullable_flag) {
-                return read_error_code::mismatching_nullable;
-            }
+                    if (nullable_value_flags & static_cast<uint8_t>(impl::nullable_value_flags::is_reference)) {
+                        m_message_size = m_scan_position + sizeof(uint64_t);
+                        m_stage = scan_stage::message;
+                        return {};
+                    }
 
-            if (mapped_data_type != get_data_type<mapped_t>()) {
-                return read_error_code::mismatching_type;
+                    m_stage = scan_stage::payload;
+                } break;
+                case scan_stage::payload: {
+                    switch (static_cast<data_types>(m_data_type)) {
+                        case data_types::string:
+                            return scan_block_size<typename TOptions::string_offset_type>(input);
+                        case data_types::object:
+                            return scan_block_size<typename TOptions::object_offset_type>(input);
+                        case data_types::list:
+                            return scan_block_size<typename TOptions::list_offset_type>(input);
+                        case data_types::map:
+                            return scan_block_size<typename TOptions::map_offset_type>(input);
+                        case data_types::unspecified:
+                            return scan_block_size<typename TOptions::format_size_type>(input);
+                        case data_types::variant: {
+                            auto index = std::optional<size_t>{};
+                            if (auto error = scan_format_value<variant_index_type>(input, index); error.has_value()) {
+                                return error;
+                            }
+
+                            if (!index.has_value()) {
+                                return {};
+                            }
+
+                            m_stage = scan_stage::data_type;
+                        } break;
+                        default: {
+                            if (const auto [value_data_type, is_varint] = impl::split_varint_value_flag(static_cast<data_types>(m_data_type)); is_varint) {
+                                if (!impl::is_varint_data_type(value_data_type)) {
+                                    return read_error_code::bad_data_type;
+                                }
+
+                                auto value = std::optional<size_t>{};
+                                if (auto error = scan_format_value<varint<uint64_t>>(input, value); error.has_value()) {
+                                    return error;
+                                }
+
+                                if (value.has_value()) {
+                                    m_message_size = m_scan_position;
+                                    m_stage = scan_stage::message;
+                                }
+                                return {};
+                            }
+
+                            const auto fundamental_size = impl::view_reader<TOptions>::get_fundamental_size(static_cast<data_types>(m_data_type));
+                            if (fundamental_size == 0) {
+                                return read_error_code::bad_data_type;
+                            }
+
+                            m_message_size = m_scan_position + fundamental_size;
+                            m_stage = scan_stage::message;
+                            return {};
+                        }
+                    }
+                } break;
+                default:
+                    return {};
             }
+        }
+    }
 
-            const auto element_count = static_cast<size_t>(read_value<options_map_element_count_type>());
-            
-            clear_container(value);
+    template<typename T, typename TOptions>
+    template<typename TSize>
+    [[nodiscard]] auto decoder<T, TOptions>::scan_block_size(read_input_type input) -> std::optional<read_error_code> {
+        auto block_size = std::optional<size_t>{};
+        if (auto error = scan_format_value<TSize>(input, block_size); error.has_value()) {
+            return error;
+        }
 
-            for (size_t i = 0; i < element_count; ++i) {
+        if (block_size.has_value()) {
+            if (block_size.value() > m_max_message_size || m_scan_position > m_max_message_size - block_size.value()) {
+                return read_error_code::max_message_size_exceeded;
+            }
 
-                auto key_value = key_t{};
+            m_message_size = m_scan_position + block_size.value();
+            m_stage = scan_stage::message;
+        }
 
-                if (auto map_error = map_impl<true>(key_value); map_error) {
-                    return map_error;
-                }
+        return {};
+    }
 
-                auto mapped_value = mapped_t{};
+    template<typename T, typename TOptions>
+    template<typename TValue>
+    [[nodiscard]] auto decoder<T, TOptions>::scan_format_value(
+        read_input_type input,
+        std::optional<size_t>& value) -> std::optional<read_error_code>
+    {
+        // Varints are scanned again as each byte arrives, as their size is known once their last byte has.
+        m_required_size = impl::is_varint_v<TValue> ? input.size() + 1 : m_scan_position + sizeof(TValue);
+        if (input.size() < m_scan_position + impl::format_min_size_v<TValue>) {
+            return {};
+        }
 
-                if (auto map_error = map_impl<true>(mapped_value); map_error) {
-                    return map_error;
-                }
+        auto value_input = input.subspan(m_scan_position);
+        auto format_value = size_t{ 0 };
 
-                value.insert({ std::move(key_value), std::move(mapped_value) });
-            }
+        if (auto error = impl::view_reader<TOptions>{ value_input }.template read_format_value<TValue>(format_value); error.has_value()) {
+            return error == read_error_code::insufficient_data ? std::nullopt : error;
+        }
 
-            return {};
+        m_scan_position = input.size() - value_input.size();
+        m_required_size = m_scan_position;
+        value = format_value;
+        return {};
+    }
+
+    template<typename T, typename TOptions>
+    [[nodiscard]] auto decoder<T, TOptions>::read_message(read_input_type input) -> decode_result_type {
+        auto result = read<TOptions, T>(input);
+        if (!result) {
+            m_error = result.error();
+            return make_unexpected<decode_result, read_error_code>(result.error());
         }
 
-        [[nodiscard]] inline auto read_formatted(auto& value) -> std::optional<read_error_code> {
-            using value_t = std::remove_cvref_t<decltype(value)>;
+        m_value = std::move(result->value);
+        m_stage = scan_stage::complete;
 
-            if (!has_bytes_left(sizeof(options_format_size_type))) {
-                return read_error_code::insufficient_data;
-            }
+        return decode_result{ decode_status::complete, input.size() };
+    }
 
-            const auto object_size = static_cast<size_t>(read_value<options_format_size_type>());
-            if (!has_bytes_left(object_size)) {
-                return read_error_code::insufficient_data;
-            }
+    template<typename TOptions>
+    [[nodiscard]] auto make_view(read_input_type input) -> view_result_type<TOptions> {
+        return view<TOptions>::read_value(input, input);
+    }
 
-            auto format_read_context = read_format_context<TOptions>{ m_input };
+    template<typename TOptions>
+    template<typename T>
+    [[nodiscard]] auto view<TOptions>::as() const -> expected<T, read_error_code> {
+        if (impl::is_nullable_v<T> != m_is_nullable) {
+            return make_unexpected<T, read_error_code>(read_error_code::mismatching_nullable);
+        }
 
-            using object_format_result_t = decltype(object<value_t>::format(format_read_context, value));
+        const auto [data_type, is_varint] = impl::split_varint_value_flag(static_cast<impl::data_types>(m_data_type));
+        if (impl::get_data_type<T>() != data_type || (is_varint && !impl::is_varint_value_v<T>)) {
+            return make_unexpected<T, read_error_code>(read_error_code::mismatching_type);
+        }
 
-            if constexpr (std::is_same_v<object_format_result_t, void> == true) {
-                object<value_t>::format(format_read_context, value);
+        auto result = T{};
 
-                if (auto format_error = format_read_context.error(); format_error.has_value()) {
-                    return format_error.value();
-                }
+        if constexpr (impl::is_nullable_v<T> == true) {
+            if (!m_has_value) {
+                return result;
             }
-            else if constexpr (std::is_same_v<object_format_result_t, bool> == true) {
-                const auto format_result = object<value_t>::format(format_read_context, value);
 
-                if (auto format_error = format_read_context.error(); format_error.has_value()) {
-                    return format_error.value();
-                }
-                if (!format_result) {
-                    return read_error_code::user_defined_failure;
-                }
+            if constexpr (impl::is_std_unique_ptr_v<T> == true) {
+                result = std::make_unique<typename T::element_type>();
+            }
+            else if constexpr (impl::is_std_shared_ptr_v<T> == true) {
+                result = std::make_shared<typename T::element_type>();
             }
             else {
-                static_assert(always_false<value_t>, "Only void and bool return type of blopp::object<T>::format is supported.");
+                result.emplace();
+            }
+
+            if (auto error = read_payload(*result); error.has_value()) {
+                return make_unexpected<T, read_error_code>(error.value());
+            }
+        }
+        else {
+            if (auto error = read_payload(result); error.has_value()) {
+                return make_unexpected<T, read_error_code>(error.value());
             }
-  
-            return {};
         }
 
-        template<bool Vskip_data_type>
-        [[nodiscard]] inline auto map_impl(auto& value) -> std::optional<read_error_code> {
-            using value_t = std::remove_cvref_t<decltype(value)>;
-            using value_fundamental_traits = fundamental_traits<value_t>;
+        return result;
+    }
 
-            constexpr auto value_is_nullable = is_nullable_v<value_t>;
+    template<typename TOptions>
+    [[nodiscard]] auto view<TOptions>::as_object() const -> object_view_result_type<TOptions> {
+        using result_t = object_view<TOptions>;
 
-            if constexpr (Vskip_data_type == false) {
-                if (!has_bytes_left(sizeof(data_types))) {
-                    return read_error_code::insufficient_data;
-                }
+        if (static_cast<impl::data_types>(m_data_type) != impl::data_types::object) {
+            return make_unexpected<result_t, read_error_code>(read_error_code::mismatching_type);
+        }
 
-                const auto [data_type, nullable_flag] = read_data_type_with_nullable_flag();
-            
-                if (nullable_flag != value_is_nullable) {
-                    return read_error_code::mismatching_nullable;
-                }
+        if (!m_has_value) {
+            return make_unexpected<result_t, read_error_code>(read_error_code::null_value);
+        }
 
-                const auto value_data_type = get_data_type<value_t>();
-                if (data_type != value_data_type) {
-                    return read_error_code::mismatching_type;
-                }
-            }
+        auto result = result_t{};
+        result.m_root = m_root;
 
-            if constexpr (value_is_nullable == true && is_std_shared_ptr_v<value_t> == false) {
-                if (!has_bytes_left(sizeof(uint8_t))) {
-                    return read_error_code::insufficient_data;
-                }
+        auto input = m_input;
+        auto reader = impl::view_reader<TOptions>{ input };
 
-                const auto nullable_value_flags = read_nullable_value_flags();
+        if (auto error = reader.read_object(result.m_property_count, result.m_properties); error.has_value()) {
+            return make_unexpected<result_t, read_error_code>(error.value());
+        }
 
-                if (nullable_value_flags & static_cast<uint8_t>(nullable_value_flags::is_reference)) {
-                    return read_error_code::mismatching_reference;
-                }
+        return result;
+    }
 
-                if (!nullable_value_flags)
-                {
-                    clear_nullable_value(value);
-                    return std::nullopt;
-                }
-            }
+    template<typename TOptions>
+    [[nodiscard]] auto view<TOptions>::as_list() const -> list_view_result_type<TOptions> {
+        using result_t = list_view<TOptions>;
 
-            if constexpr (value_fundamental_traits::is_fundamental == true) {
-                return read_fundamental(value);
-            }
-            else if constexpr (std::is_enum_v<value_t> == true) {
-                return read_enum(value);
-            }
-            else if constexpr (is_std_string_v<value_t> == true) {
-                return read_string(value);
-            }
-            else if constexpr (is_std_unique_ptr_v<value_t> == true) {
-                return read_unique_ptr(value);
-            }
-            else if constexpr (is_std_shared_ptr_v<value_t> == true) {
-                return read_shared_ptr(value);
-            }
-            else if constexpr (is_std_optional_v<value_t> == true) {
-                return read_optional(value);
-            }
-            else if constexpr (
-                is_std_array_v<value_t> == true ||
-                is_std_vector_v<value_t> == true ||
-                is_std_list_v<value_t> == true)
-            {
-                return read_list(value);
-            }
-            else if constexpr (std::is_array_v<value_t> == true) {
-                auto array_span = std::span(value);
-                return read_list(array_span);
-            }
-            else if constexpr (is_std_variant_v<value_t> == true) {
-                return read_variant(value);
-            }
-            else if constexpr (is_std_map_v<value_t> == true) {
-                return read_map(value);
-            }
-            else if constexpr (object_is_mapped<value_t>() == true) {
-                return read_object(value);
-            }
-            else if constexpr (object_is_formatted<value_t>() == true) {
-                return read_formatted(value);
-            }
-            else {
-                static_assert(always_false<value_t>, "Unmapped blopp data type.");
-            }
+        if (static_cast<impl::data_types>(m_data_type) != impl::data_types::list) {
+            return make_unexpected<result_t, read_error_code>(read_error_code::mismatching_type);
         }
 
-        std::optional<read_error_code> m_error = {};
-        size_t m_property_count;
-        size_t m_max_property_count;
-        read_input_type m_original_input;
-        read_reference_map& m_reference_map;
-
-    };
+        if (!m_has_value) {
+            return make_unexpected<result_t, read_error_code>(read_error_code::null_value);
+        }
 
-}
+        auto result = result_t{};
+        result.m_root = m_root;
 
+        auto input = m_input;
+        auto reader = impl::view_reader<TOptions>{ input };
+        auto element_data_type = impl::data_types::unspecified;
 
-namespace blopp
-{
+        if (auto error = reader.read_list(
+                element_data_type,
+                result.m_element_is_nullable,
+                result.m_element_count,
+                result.m_elements,
+                result.m_element_index);
+            error.has_value())
+        {
+            return make_unexpected<result_t, read_error_code>(error.value());
+        }
 
-    template<typename T>
-    [[nodiscard]] auto write(const T& value) -> write_result_type {
-        return write<default_options, T>(value);
+        result.m_element_data_type = static_cast<uint8_t>(element_data_type);
+        return result;
     }
 
-    template<typename TOptions, typename T>
-    [[nodiscard]] auto write(const T& value) -> write_result_type {
-        auto result = write_output_type{};
+    template<typename TOptions>
+    [[nodiscard]] auto view<TOptions>::as_map() const -> map_view_result_type<TOptions> {
+        using result_t = map_view<TOptions>;
 
-        impl::write_reference_map reference_map = {};
+        if (static_cast<impl::data_types>(m_data_type) != impl::data_types::map) {
+            return make_unexpected<result_t, read_error_code>(read_error_code::mismatching_type);
+        }
 
-        auto context = impl::write_context<TOptions>{
-            result,
-            reference_map
-        };
+        if (!m_has_value) {
+            return make_unexpected<result_t, read_error_code>(read_error_code::null_value);
+        }
 
-        context.map(value);
-        
-        if (auto error = context.error(); error) {
-            return make_unexpected<write_output_type, write_error_code>(error.value());
+        auto result = result_t{};
+        result.m_root = m_root;
+
+        auto input = m_input;
+        auto reader = impl::view_reader<TOptions>{ input };
+        auto key_data_type = impl::data_types::unspecified;
+        auto mapped_data_type = impl::data_types::unspecified;
+
+        if (auto error = reader.read_map(
+                key_data_type,
+                result.m_key_is_nullable,
+                mapped_data_type,
+                result.m_mapped_is_nullable,
+                result.m_element_count,
+                result.m_elements);
+            error.has_value())
+        {
+            return make_unexpected<result_t, read_error_code>(error.value());
         }
 
+        result.m_key_data_type = static_cast<uint8_t>(key_data_type);
+        result.m_mapped_data_type = static_cast<uint8_t>(mapped_data_type);
         return result;
     }
 
+    template<typename TOptions>
+    [[nodiscard]] auto view<TOptions>::read_value(read_input_type root, read_input_type input) -> view_result_type<TOptions> {
+        auto reader = impl::view_reader<TOptions>{ input };
+        auto data_type = impl::data_types::unspecified;
+        auto is_nullable = false;
 
-#if !defined(BLOPP_NO_FILESYSTEM)
+        if (auto error = reader.read_data_type(data_type, is_nullable); error.has_value()) {
+            return make_unexpected<view<TOptions>, read_error_code>(error.value());
+        }
 
-    template<typename T>
-    [[nodiscard]] auto write(const T& value, std::ostream& stream) -> write_void_result_type {
-        return  write<default_options, T>(value, stream);
-    } 
+        return read_element(root, input, static_cast<uint8_t>(data_type), is_nullable);
+    }
 
-    template<typename TOptions, typename T>
-    [[nodiscard]] auto write(const T& value, std::ostream& stream) -> write_void_result_type {
-        auto result = write<TOptions, T>(value);
-        if (!result) {
-            return make_unexpected<void, write_error_code>(result.error());
+    template<typename TOptions>
+    [[nodiscard]] auto view<TOptions>::read_element(
+        read_input_type root,
+        read_input_type input,
+        const uint8_t data_type,
+        const bool is_nullable) -> view_result_type<TOptions>
+    {
+        auto result = view<TOptions>{};
+        result.m_root = root;
+        result.m_data_type = data_type;
+        result.m_is_nullable = is_nullable;
+
+        auto reader = impl::view_reader<TOptions>{ input };
+
+        if (auto error = reader.read_nullable_value(root, static_cast<impl::data_types>(data_type), is_nullable, result.m_has_value); error.has_value()) {
+            return make_unexpected<view<TOptions>, read_error_code>(error.value());
         }
 
-        stream.write(reinterpret_cast<const char*>(result->data()), result->size());
-        return {};
+        result.m_input = input;
+        return result;
     }
 
+    template<typename TOptions>
     template<typename T>
-    [[nodiscard]] auto write(const T& value, const std::filesystem::path& path) -> write_void_result_type {
-        return write<default_options, T>(value, path);
+    [[nodiscard]] auto view<TOptions>::read_payload(T& value) const -> std::optional<read_error_code> {
+        auto input = m_input;
+        auto reference_map = impl::read_reference_map<TOptions>{};
+
+        auto context = impl::read_context<TOptions>{ input, m_root, 1, reference_map, true };
+        context.map_payload(value, impl::split_varint_value_flag(static_cast<impl::data_types>(m_data_type)).second);
+
+        return context.error();
     }
 
-    template<typename TOptions, typename T>
-    [[nodiscard]] auto write(const T& value, const std::filesystem::path& path) -> write_void_result_type {
-        std::ofstream stream(path, std::ofstream::binary);
-        if (!stream.is_open()) {
-            return make_unexpected<void, write_error_code>(write_error_code::cannot_open_file);
+    template<typename TOptions>
+    [[nodiscard]] auto object_view<TOptions>::at(const size_t index) const -> view_result_type<TOptions> {
+        if (index >= m_property_count) {
+            return make_unexpected<view<TOptions>, read_error_code>(read_error_code::out_of_range);
         }
 
-        return write<TOptions, T>(value, stream);
-    }
+        auto input = m_properties;
+        auto reader = impl::view_reader<TOptions>{ input };
 
-#endif
+        for (size_t i = 0; i < index; ++i) {
+            if (auto error = reader.skip_property(); error.has_value()) {
+                return make_unexpected<view<TOptions>, read_error_code>(error.value());
+            }
+        }
 
-    template<typename T>
-    [[nodiscard]] auto read(read_input_type input) -> read_result_type<T> {
-        return read<default_options, T>(input);
+        return view<TOptions>::read_value(m_root, input);
     }
 
-    template<typename TOptions, typename T>
-    [[nodiscard]] auto read(read_input_type input) -> read_result_type<T> {
-        auto result = read_result<T>{};
+    template<typename TOptions>
+    [[nodiscard]] auto list_view<TOptions>::at(const size_t index) const -> view_result_type<TOptions> {
+        if (index >= m_element_count) {
+            return make_unexpected<view<TOptions>, read_error_code>(read_error_code::out_of_range);
+        }
 
-        read_input_type input_remaining = input;
-        impl::read_reference_map reference_map = {};
-        
-        auto context = impl::read_context<TOptions>{ 
-            input_remaining,
-            input_remaining,
-            1,
-            reference_map
-        };
+        const auto element_data_type = static_cast<impl::data_types>(m_element_data_type);
+        const auto element_size = impl::view_reader<TOptions>::get_fundamental_size(element_data_type);
 
-        context.map(result.value);
+        if (element_size > 0 && m_element_is_nullable == false) {
+            if (index >= m_elements.size() / element_size) {
+                return make_unexpected<view<TOptions>, read_error_code>(read_error_code::insufficient_data);
+            }
 
-        if (auto error = context.error(); error) {
-            return make_unexpected<read_result<T>, read_error_code>(error.value());
+            return view<TOptions>::read_element(
+                m_root, m_elements.subspan(index * element_size), m_element_data_type, false);
         }
 
-        result.remaining = input_remaining;
-        return result;
-    }
+        if (!m_element_index.empty()) {
+            auto element_index = m_element_index.subspan(index * sizeof(impl::format_value_t<typename TOptions::list_offset_type>));
+            auto element_offset = size_t{ 0 };
+            if (auto error = impl::view_reader<TOptions>{ element_index }.read_list_element_offset(element_offset); error.has_value()) {
+                return make_unexpected<view<TOptions>, read_error_code>(error.value());
+            }
 
-#if !defined(BLOPP_NO_FILESYSTEM)
+            if (element_offset >= m_elements.size()) {
+                return make_unexpected<view<TOptions>, read_error_code>(read_error_code::bad_list_element_index);
+            }
 
-    template<typename T>
-    [[nodiscard]] auto read(std::istream& stream) -> read_result_type<T> {
-        return read<default_options, T>(stream);
-    }
+            return view<TOptions>::read_element(m_root, m_elements.subspan(element_offset), m_element_data_type, m_element_is_nullable);
+        }
 
-    template<typename TOptions, typename T>
-    [[nodiscard]] auto read(std::istream& stream) -> read_result_type<T> {
-        const auto streamStart = stream.tellg();
-        stream.seekg(0, std::istream::end);
-        const auto streamEnd = stream.tellg();
-        stream.seekg(streamStart, std::istream::beg);
-        const auto fileSize = streamEnd - streamStart;
+        auto input = m_elements;
+        auto reader = impl::view_reader<TOptions>{ input };
 
-        auto data = std::vector<uint8_t>{ };
-        data.resize(fileSize);
+        for (size_t i = 0; i < index; ++i) {
+            if (auto error = reader.skip_value(element_data_type, m_element_is_nullable); error.has_value()) {
+                return make_unexpected<view<TOptions>, read_error_code>(error.value());
+            }
+        }
 
-        stream.read(reinterpret_cast<char*>(data.data()), data.size());
+        return view<TOptions>::read_element(m_root, input, m_element_data_type, m_element_is_nullable);
+    }
 
-        return read<TOptions, T>(data);
+    template<typename TOptions>
+    [[nodiscard]] auto map_view<TOptions>::key(const size_t index) const -> view_result_type<TOptions> {
+        return element(index, false);
     }
 
-    template<typename T>
-    [[nodiscard]] auto read(const std::filesystem::path& path) -> read_result_type<T> {
-        return read<default_options, T>(path);
+    template<typename TOptions>
+    [[nodiscard]] auto map_view<TOptions>::value(const size_t index) const -> view_result_type<TOptions> {
+        return element(index, true);
     }
 
-    template<typename TOptions, typename T>
-    [[nodiscard]] auto read(const std::filesystem::path& path) -> read_result_type<T> {
-        std::ifstream stream(path, std::ios::binary);
-        if (!stream.is_open()) {
-            return make_unexpected<read_result<T>, read_error_code>(read_error_code::cannot_open_file);
+    template<typename TOptions>
+    template<typename TKey>
+    [[nodiscard]] auto map_view<TOptions>::find(const TKey& key) const -> view_result_type<TOptions> {
+        const auto key_data_type = static_cast<impl::data_types>(m_key_data_type);
+        const auto mapped_data_type = static_cast<impl::data_types>(m_mapped_data_type);
+
+        auto input = m_elements;
+        auto reader = impl::view_reader<TOptions>{ input };
+
+        for (size_t i = 0; i < m_element_count; ++i) {
+            auto key_view_result = view<TOptions>::read_element(m_root, input, m_key_data_type, m_key_is_nullable);
+            if (!key_view_result) {
+                return key_view_result;
+            }
+
+            auto key_result = key_view_result->template as<TKey>();
+            if (!key_result) {
+                return make_unexpected<view<TOptions>, read_error_code>(key_result.error());
+            }
+
+            if (auto error = reader.skip_value(key_data_type, m_key_is_nullable); error.has_value()) {
+                return make_unexpected<view<TOptions>, read_error_code>(error.value());
+            }
+
+            if (key_result.value() == key) {
+                return view<TOptions>::read_element(m_root, input, m_mapped_data_type, m_mapped_is_nullable);
+            }
+
+            if (auto error = reader.skip_value(mapped_data_type, m_mapped_is_nullable); error.has_value()) {
+                return make_unexpected<view<TOptions>, read_error_code>(error.value());
+            }
         }
 
-        return read<TOptions, T>(stream);
+        return make_unexpected<view<TOptions>, read_error_code>(read_error_code::out_of_range);
     }
 
-#endif
+    template<typename TOptions>
+    [[nodiscard]] auto map_view<TOptions>::element(const size_t index, const bool mapped) const -> view_result_type<TOptions> {
+        if (index >= m_element_count) {
+            return make_unexpected<view<TOptions>, read_error_code>(read_error_code::out_of_range);
+        }
+
+        const auto key_data_type = static_cast<impl::data_types>(m_key_data_type);
+        const auto mapped_data_type = static_cast<impl::data_types>(m_mapped_data_type);
+
+        auto input = m_elements;
+        auto reader = impl::view_reader<TOptions>{ input };
+
+        for (size_t i = 0; i < index; ++i) {
+            if (auto error = reader.skip_value(key_data_type, m_key_is_nullable); error.has_value()) {
+                return make_unexpected<view<TOptions>, read_error_code>(error.value());
+            }
+            if (auto error = reader.skip_value(mapped_data_type, m_mapped_is_nullable); error.has_value()) {
+                return make_unexpected<view<TOptions>, read_error_code>(error.value());
+            }
+        }
+
+        if (mapped == false) {
+            return view<TOptions>::read_element(m_root, input, m_key_data_type, m_key_is_nullable);
+        }
+
+        if (auto error = reader.skip_value(key_data_type, m_key_is_nullable); error.has_value()) {
+            return make_unexpected<view<TOptions>, read_error_code>(error.value());
+        }
+
+        return view<TOptions>::read_element(m_root, input, m_mapped_data_type, m_mapped_is_nullable);
+    }
 
 }
 
-#endif
\ No newline at end of file
+#endif
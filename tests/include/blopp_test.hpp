@@ -12,6 +12,24 @@ namespace blopp_test {
         std::cout << "\033[0;36m" << message << "\033[0;0m" << std::endl;
     }
 
+    // Copies input into buffer at the first offset where blopp can create aligned views into it.
+    template<typename T>
+    auto read_aligned(std::span<const uint8_t> input, std::vector<uint64_t>& buffer) -> blopp::read_result_type<T> {
+        buffer.assign((input.size() / sizeof(uint64_t)) + 2, uint64_t{ 0 });
+        auto* buffer_data = reinterpret_cast<uint8_t*>(buffer.data());
+
+        for (size_t offset = 0; offset < sizeof(uint64_t); offset++) {
+            std::copy(input.begin(), input.end(), buffer_data + offset);
+
+            auto result = blopp::read<T>(std::span<const uint8_t>{ buffer_data + offset, input.size() });
+            if (result || result.error() != blopp::read_error_code::misaligned_data) {
+                return result;
+            }
+        }
+
+        return blopp::read<T>(input);
+    }
+
 }
 
 #endif
\ No newline at end of file
@@ -1,6 +1,7 @@
 #ifndef BLOPP_TEST_BINARY_FORMAT_TYPES_HPP
 #define BLOPP_TEST_BINARY_FORMAT_TYPES_HPP
 
+#include "blopp.hpp"
 #include <stdint.h>
 #include <stddef.h>
 
@@ -32,6 +33,20 @@ namespace blopp_test {
         using format_size_type = uint64_t;
     };
 
+    // Counts and variant indices as varints, with offsets of fixed size.
+    struct varint_count_binary_format_types {
+        using string_offset_type = uint32_t;
+        using string_char_size_type = uint8_t;
+        using object_offset_type = uint32_t;
+        using object_property_count_type = uint16_t;
+        using list_offset_type = uint32_t;
+        using list_element_count_type = blopp::varint<uint32_t>;
+        using map_offset_type = uint32_t;
+        using map_element_count_type = blopp::varint<uint32_t>;
+        using variant_index_type = blopp::varint<uint8_t>;
+        using format_size_type = uint16_t;
+    };
+
     struct minimal_offset_options : minimal_offset_binary_format_types {
         static constexpr auto allow_object_excess_bytes = true;
         static constexpr auto allow_more_object_members = true;
@@ -42,6 +57,11 @@ namespace blopp_test {
         static constexpr auto allow_more_object_members = true;
     };
 
+    struct varint_count_options : varint_count_binary_format_types {
+        static constexpr auto allow_object_excess_bytes = true;
+        static constexpr auto allow_more_object_members = true;
+    };
+
 }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,158 @@
+#ifndef BLOPP_TEST_STORE_HPP
+#define BLOPP_TEST_STORE_HPP
+
+#include "blopp_test.hpp"
+#include <array>
+#include <list>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <variant>
+#include <vector>
+
+namespace blopp_test {
+
+    struct test_struct_vec3 {
+        float x, y, z;
+    };
+
+    struct test_struct_product {
+        uint32_t id = 0;
+        std::string name = {};
+        std::vector<int32_t> values = {};
+        std::list<int64_t> list_values = {};
+        std::vector<bool> flags = {};
+        std::array<uint8_t, 4> codes = {};
+        std::map<int32_t, std::u16string> tags = {};
+        test_struct_vec3 position = {};
+        std::optional<double> price = {};
+        std::variant<int32_t, std::string> variant = {};
+    };
+
+    struct test_struct_store {
+        std::string name = {};
+        std::vector<test_struct_product> products = {};
+        std::list<std::string> categories = {};
+        std::map<std::string, int32_t> stock = {};
+        std::shared_ptr<test_struct_product> featured_1 = {};
+        std::shared_ptr<test_struct_product> featured_2 = {};
+        std::unique_ptr<std::string> description = {};
+    };
+
+    inline bool operator == (const test_struct_vec3& lhs, const test_struct_vec3& rhs) {
+        return lhs.x == rhs.x && lhs.y == rhs.y && lhs.z == rhs.z;
+    }
+
+    inline bool operator == (const test_struct_product& lhs, const test_struct_product& rhs) {
+        return
+            lhs.id == rhs.id &&
+            lhs.name == rhs.name &&
+            lhs.values == rhs.values &&
+            lhs.list_values == rhs.list_values &&
+            lhs.flags == rhs.flags &&
+            lhs.codes == rhs.codes &&
+            lhs.tags == rhs.tags &&
+            lhs.position == rhs.position &&
+            lhs.price == rhs.price &&
+            lhs.variant == rhs.variant;
+    }
+
+    // Store of product_count products, of growing sizes, with values varying by seed.
+    // Both featured products share the same value.
+    inline test_struct_store create_store(const uint32_t product_count = 20, const uint32_t seed = 0) {
+        auto result = test_struct_store{
+            .name = "Fruit store " + std::to_string(seed),
+            .products = {},
+            .categories = { "Fruit", "Vegetables " + std::to_string(seed) },
+            .stock = { { "apple", 10 }, { "banana", 20 }, { "cherry", static_cast<int32_t>(30 + seed) } },
+            .featured_1 = {},
+            .featured_2 = {},
+            .description = std::make_unique<std::string>("Description of a store " + std::to_string(seed))
+        };
+
+        for (uint32_t i = 0; i < product_count; i++) {
+            result.products.push_back(test_struct_product{
+                .id = i + seed,
+                .name = "Product " + std::to_string(i + seed),
+                .values = std::vector<int32_t>(i, static_cast<int32_t>(i + seed)),
+                .list_values = std::list<int64_t>(i % 5, static_cast<int64_t>(i)),
+                .flags = std::vector<bool>(i, (i % 2) == 0),
+                .codes = { 1, 2, 3, static_cast<uint8_t>(i) },
+                .tags = { { 1, u"one" }, { static_cast<int32_t>(i), u"value" } },
+                .position = { 1.0f, 2.0f, static_cast<float>(i) },
+                .price = (i % 2 == 0) ? std::optional<double>{ i * 1.5 } : std::nullopt,
+                .variant = (i % 3 == 0) ?
+                    std::variant<int32_t, std::string>{ "Variant " + std::to_string(seed) } :
+                    std::variant<int32_t, std::string>{ static_cast<int32_t>(i) }
+            });
+        }
+
+        if (!result.products.empty()) {
+            result.featured_1 = std::make_shared<test_struct_product>(result.products.at(product_count / 2));
+            result.featured_2 = result.featured_1;
+        }
+
+        return result;
+    }
+
+    // Expects output to equal input, with both featured products sharing a value.
+    inline void expect_store_eq(const test_struct_store& output, const test_struct_store& input) {
+        EXPECT_EQ(output.name, input.name);
+        EXPECT_EQ(output.products, input.products);
+        EXPECT_EQ(output.categories, input.categories);
+        EXPECT_EQ(output.stock, input.stock);
+
+        ASSERT_EQ(output.featured_1 == nullptr, input.featured_1 == nullptr);
+        if (input.featured_1 != nullptr) {
+            EXPECT_EQ(*output.featured_1, *input.featured_1);
+        }
+        EXPECT_EQ(output.featured_1, output.featured_2);
+
+        ASSERT_EQ(output.description == nullptr, input.description == nullptr);
+        if (input.description != nullptr) {
+            EXPECT_EQ(*output.description, *input.description);
+        }
+    }
+
+}
+
+template<>
+struct blopp::object<blopp_test::test_struct_vec3> {
+    static auto format(auto& context, auto& value) {
+        context.format(value.x, value.y, value.z);
+    }
+};
+
+template<>
+struct blopp::object<blopp_test::test_struct_product> {
+    static auto map(auto& context, auto& value) {
+        context.map(
+            value.id,
+            value.name,
+            value.values,
+            value.list_values,
+            value.flags,
+            value.codes,
+            value.tags,
+            value.position,
+            value.price,
+            value.variant);
+    }
+};
+
+template<>
+struct blopp::object<blopp_test::test_struct_store> {
+    static auto map(auto& context, auto& value) {
+        context.map(
+            value.name,
+            value.products,
+            value.categories,
+            value.stock,
+            value.featured_1,
+            value.featured_2,
+            value.description);
+    }
+};
+
+#endif
@@ -0,0 +1,240 @@
+#include "blopp_test.hpp"
+
+namespace {
+    struct test_struct_vec3 {
+        float x, y, z;
+    };
+
+    struct test_struct_product {
+        uint32_t id;
+        std::string name;
+        std::vector<int32_t> values;
+        std::optional<test_struct_vec3> position;
+    };
+}
+
+template<>
+struct blopp::object<test_struct_vec3> {
+    static auto format(auto& context, auto& value) {
+        context.format(value.x, value.y, value.z);
+    }
+};
+
+template<>
+struct blopp::object<test_struct_product> {
+    static auto map(auto& context, auto& value) {
+        context.map(
+            value.id,
+            value.name,
+            value.values,
+            value.position);
+    }
+};
+
+namespace {
+    test_struct_product create_product(const uint32_t id) {
+        return test_struct_product{
+            .id = id,
+            .name = "Product " + std::to_string(id),
+            .values = std::vector<int32_t>(id, static_cast<int32_t>(id)),
+            .position = (id % 2 == 0) ? std::optional<test_struct_vec3>{ test_struct_vec3{ 1.0f, 2.0f, 3.0f } } : std::nullopt
+        };
+    }
+
+    template<typename T>
+    void expect_decoded_in_chunks(const T& input) {
+        auto write_result = blopp::write(input);
+        ASSERT_TRUE(write_result);
+
+        const auto data = std::span<const uint8_t>{ *write_result };
+
+        for (const auto chunk_size : { size_t{ 1 }, size_t{ 3 }, size_t{ 16 }, size_t{ 1000 } }) {
+            auto decoder = blopp::decoder<T>{};
+
+            for (size_t position = 0; position < data.size(); position += chunk_size) {
+                const auto chunk = data.subspan(position, std::min(chunk_size, data.size() - position));
+
+                auto push_result = decoder.push(chunk);
+                ASSERT_TRUE(push_result);
+                EXPECT_EQ(push_result->consumed_size, chunk.size());
+
+                const auto expected_status = position + chunk.size() == data.size() ?
+                    blopp::decode_status::complete :
+                    blopp::decode_status::need_more_data;
+
+                EXPECT_EQ(push_result->status, expected_status);
+                EXPECT_EQ(decoder.status(), expected_status);
+            }
+
+            EXPECT_EQ(decoder.value(), input);
+        }
+    }
+
+    TEST(decoder, ok_fundamentals) {
+        expect_decoded_in_chunks(int32_t{ 123 });
+        expect_decoded_in_chunks(double{ 1.5 });
+        expect_decoded_in_chunks(std::optional<int64_t>{});
+        expect_decoded_in_chunks(std::optional<int64_t>{ 123 });
+    }
+
+    TEST(decoder, ok_string) {
+        expect_decoded_in_chunks(std::string{ "Hello world" });
+    }
+
+    TEST(decoder, ok_containers) {
+        expect_decoded_in_chunks(std::vector<std::string>(size_t{ 10 }, std::string{ "Hello world" }));
+        expect_decoded_in_chunks(std::map<int32_t, std::string>{ { 1, "one" }, { 2, "two" } });
+    }
+
+    TEST(decoder, ok_variant) {
+        using variant_t = std::variant<int32_t, std::variant<std::string, uint8_t>>;
+        expect_decoded_in_chunks(variant_t{ std::variant<std::string, uint8_t>{ std::string{ "Hello world" } } });
+    }
+
+    TEST(decoder, ok_object) {
+        auto decoder = blopp::decoder<test_struct_product>{};
+
+        auto write_result = blopp::write(create_product(10));
+        ASSERT_TRUE(write_result);
+
+        const auto data = std::span<const uint8_t>{ *write_result };
+
+        auto push_result = decoder.push(data.first(5));
+        ASSERT_TRUE(push_result);
+        EXPECT_EQ(push_result->status, blopp::decode_status::need_more_data);
+
+        push_result = decoder.push(data.subspan(5));
+        ASSERT_TRUE(push_result);
+        EXPECT_EQ(push_result->status, blopp::decode_status::complete);
+
+        auto& output = decoder.value();
+        EXPECT_EQ(output.id, uint32_t{ 10 });
+        EXPECT_STREQ(output.name.c_str(), "Product 10");
+        EXPECT_EQ(output.values, std::vector<int32_t>(size_t{ 10 }, int32_t{ 10 }));
+        ASSERT_TRUE(output.position.has_value());
+        EXPECT_EQ(output.position->y, 2.0f);
+    }
+
+    TEST(decoder, ok_message_sequence) {
+        auto data = std::vector<uint8_t>{};
+        for (uint32_t i = 0; i < 20; i++) {
+            auto write_result = blopp::write(create_product(i), data);
+            ASSERT_TRUE(write_result);
+        }
+
+        auto decoder = blopp::decoder<test_struct_product>{};
+        auto output = std::vector<test_struct_product>{};
+
+        const auto chunk_size = size_t{ 37 };
+        for (size_t position = 0; position < data.size(); position += chunk_size) {
+            auto chunk = std::span<const uint8_t>{ data }.subspan(position, std::min(chunk_size, data.size() - position));
+
+            while (!chunk.empty()) {
+                auto push_result = decoder.push(chunk);
+                ASSERT_TRUE(push_result);
+
+                chunk = chunk.subspan(push_result->consumed_size);
+
+                if (push_result->status == blopp::decode_status::complete) {
+                    output.push_back(std::move(decoder.value()));
+                    decoder.reset();
+                }
+            }
+        }
+
+        ASSERT_EQ(output.size(), size_t{ 20 });
+        for (uint32_t i = 0; i < 20; i++) {
+            EXPECT_EQ(output.at(i).id, i);
+            EXPECT_EQ(output.at(i).values.size(), size_t{ i });
+        }
+    }
+
+    TEST(decoder, ok_single_chunk_is_not_copied) {
+        auto write_result = blopp::write(std::string{ "Hello world" });
+        ASSERT_TRUE(write_result);
+
+        auto data = *write_result;
+        data.push_back(uint8_t{ 0xCD });
+
+        auto decoder = blopp::decoder<std::string_view>{};
+
+        auto push_result = decoder.push(data);
+        ASSERT_TRUE(push_result);
+        EXPECT_EQ(push_result->status, blopp::decode_status::complete);
+        EXPECT_EQ(push_result->consumed_size, write_result->size());
+
+        EXPECT_EQ(decoder.value(), std::string_view{ "Hello world" });
+        EXPECT_GE(reinterpret_cast<const uint8_t*>(decoder.value().data()), data.data());
+        EXPECT_LT(reinterpret_cast<const uint8_t*>(decoder.value().data()), data.data() + data.size());
+    }
+
+    TEST(decoder, fail_bad_data_type) {
+        auto decoder = blopp::decoder<int32_t>{};
+
+        const auto data = std::array<uint8_t, 4>{ 0x7F, 1, 2, 3 };
+
+        auto push_result = decoder.push(data);
+        ASSERT_FALSE(push_result);
+        EXPECT_EQ(push_result.error(), blopp::read_error_code::bad_data_type);
+
+        push_result = decoder.push(data);
+        ASSERT_FALSE(push_result);
+        EXPECT_EQ(push_result.error(), blopp::read_error_code::bad_data_type);
+    }
+
+    TEST(decoder, ok_max_message_size) {
+        auto write_result = blopp::write(std::string{ "Hello world" });
+        ASSERT_TRUE(write_result);
+
+        auto decoder = blopp::decoder<std::string>{ write_result->size() };
+
+        auto push_result = decoder.push(*write_result);
+        ASSERT_TRUE(push_result);
+        EXPECT_EQ(push_result->status, blopp::decode_status::complete);
+        EXPECT_EQ(decoder.value(), "Hello world");
+    }
+
+    TEST(decoder, fail_max_message_size_exceeded) {
+        auto write_result = blopp::write(std::string{ "Hello world" });
+        ASSERT_TRUE(write_result);
+
+        auto decoder = blopp::decoder<std::string>{ write_result->size() - 1 };
+
+        auto push_result = decoder.push(std::span{ *write_result }.first(3));
+        ASSERT_TRUE(push_result);
+        EXPECT_EQ(push_result->status, blopp::decode_status::need_more_data);
+
+        push_result = decoder.push(std::span{ *write_result }.subspan(3));
+        ASSERT_FALSE(push_result);
+        EXPECT_EQ(push_result.error(), blopp::read_error_code::max_message_size_exceeded);
+    }
+
+    TEST(decoder, fail_forged_message_size) {
+        auto decoder = blopp::decoder<std::vector<int32_t>>{};
+
+        // List with an offset of 2^63 bytes.
+        auto data = std::array<uint8_t, 1 + sizeof(uint64_t)>{};
+        data[0] = static_cast<uint8_t>(blopp::impl::data_types::list);
+        const auto forged_offset = uint64_t{ 1 } << 63;
+        std::memcpy(data.data() + 1, &forged_offset, sizeof(forged_offset));
+
+        auto push_result = decoder.push(data);
+        ASSERT_FALSE(push_result);
+        EXPECT_EQ(push_result.error(), blopp::read_error_code::max_message_size_exceeded);
+    }
+
+    TEST(decoder, fail_mismatching_type) {
+        auto write_result = blopp::write(std::string{ "Hello world" });
+        ASSERT_TRUE(write_result);
+
+        auto decoder = blopp::decoder<std::vector<int32_t>>{};
+
+        auto push_result = decoder.push(std::span{ *write_result }.first(3));
+        ASSERT_TRUE(push_result);
+        EXPECT_EQ(push_result->status, blopp::decode_status::need_more_data);
+
+        push_result = decoder.push(std::span{ *write_result }.subspan(3));
+        ASSERT_FALSE(push_result);
+        EXPECT_EQ(push_result.error(), blopp::read_error_code::mismatching_type);
+    }
+}
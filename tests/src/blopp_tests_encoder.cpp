@@ -0,0 +1,246 @@
+#include "blopp_test.hpp"
+#include "blopp_test_binary_format_types.hpp"
+#include "blopp_test_store.hpp"
+
+namespace {
+    using blopp_test::test_struct_store;
+
+    struct test_struct_counted {
+        inline static size_t map_count = 0;
+
+        uint32_t id;
+    };
+
+    struct test_struct_containers {
+        std::list<int32_t> values;
+        std::vector<std::string> names;
+        std::map<int32_t, std::string> names_by_id;
+        std::vector<std::vector<std::shared_ptr<int32_t>>> shared_values;
+    };
+
+    struct test_index_options : blopp::default_options {
+        static constexpr auto list_element_index = true;
+    };
+
+    struct test_varint_integers_options : blopp::varint_default_options {
+        static constexpr auto varint_integers = true;
+    };
+
+    static_assert(std::is_constructible_v<blopp::encoder<std::string>, const std::string&>);
+    static_assert(!std::is_constructible_v<blopp::encoder<std::string>, std::string>,
+        "Encoders of temporaries would refer to destroyed values.");
+}
+
+template<>
+struct blopp::object<test_struct_containers> {
+    static auto map(auto& context, auto& value) {
+        context.map(
+            value.values,
+            value.names,
+            value.names_by_id,
+            value.shared_values);
+    }
+};
+
+template<>
+struct blopp::object<test_struct_counted> {
+    static auto map(auto& context, auto& value) {
+        ++test_struct_counted::map_count;
+        context.map(value.id);
+    }
+};
+
+namespace {
+    test_struct_containers create_containers() {
+        auto result = test_struct_containers{};
+
+        auto shared_values = std::vector<std::shared_ptr<int32_t>>{};
+        for (int32_t i = 0; i < 50; i++) {
+            shared_values.push_back(std::make_shared<int32_t>(i));
+        }
+
+        for (int32_t i = 0; i < 1000; i++) {
+            result.values.push_back(i * 1000);
+            result.names.push_back("Name " + std::to_string(i));
+            result.names_by_id.emplace(i, "Name " + std::to_string(i));
+        }
+
+        // Shared values are defined by earlier lists and referenced by later lists, skipped by most windows.
+        for (size_t i = 0; i < 300; i++) {
+            result.shared_values.push_back({ shared_values.at(i % 50), shared_values.at((i * 7) % 50), std::make_shared<int32_t>(-1) });
+        }
+
+        return result;
+    }
+
+    template<typename TOptions, typename T>
+    std::vector<uint8_t> encode_in_windows(const T& value, const size_t window_size) {
+        auto encoder = blopp::encoder<T, TOptions>{ value };
+        auto window = std::vector<uint8_t>(window_size);
+        auto result = std::vector<uint8_t>{};
+
+        while (encoder.status() != blopp::encode_status::complete) {
+            auto encode_result = encoder.write(window);
+            EXPECT_TRUE(encode_result);
+            if (!encode_result) {
+                break;
+            }
+
+            result.insert(result.end(), window.begin(), window.begin() + encode_result->written_size);
+
+            if (encode_result->status == blopp::encode_status::suspended) {
+                EXPECT_EQ(encode_result->written_size, window_size);
+            }
+        }
+
+        return result;
+    }
+
+    TEST(encoder, ok_windows) {
+        const auto input = blopp_test::create_store(50);
+
+        auto write_result = blopp::write(input);
+        ASSERT_TRUE(write_result);
+
+        for (const auto window_size : { size_t{ 1 }, size_t{ 7 }, size_t{ 64 }, size_t{ 1000 }, size_t{ 1000000 } }) {
+            EXPECT_EQ((encode_in_windows<blopp::default_options>(input, window_size)), *write_result);
+        }
+    }
+
+    TEST(encoder, ok_windows_compact) {
+        const auto input = blopp_test::create_store(50);
+
+        auto write_result = blopp::write<blopp::compact_default_options>(input);
+        ASSERT_TRUE(write_result);
+
+        EXPECT_EQ((encode_in_windows<blopp::compact_default_options>(input, size_t{ 13 })), *write_result);
+
+        auto read_result = blopp::read<blopp::compact_default_options, test_struct_store>(
+            encode_in_windows<blopp::compact_default_options>(input, size_t{ 13 }));
+        ASSERT_TRUE(read_result);
+        EXPECT_EQ(read_result->value.featured_1, read_result->value.featured_2);
+    }
+
+    TEST(encoder, ok_fundamental) {
+        auto write_result = blopp::write(int64_t{ 123 });
+        ASSERT_TRUE(write_result);
+
+        EXPECT_EQ((encode_in_windows<blopp::default_options>(int64_t{ 123 }, size_t{ 4 })), *write_result);
+    }
+
+    TEST(encoder, ok_complete) {
+        const auto input = std::string{ "Hello world" };
+
+        auto encoder = blopp::encoder<std::string>{ input };
+        auto window = std::array<uint8_t, 256>{};
+
+        auto encode_result = encoder.write(window);
+        ASSERT_TRUE(encode_result);
+        EXPECT_EQ(encode_result->status, blopp::encode_status::complete);
+        EXPECT_EQ(encode_result->written_size, size_t{ 1 + 8 + 1 + 11 });
+
+        encode_result = encoder.write(window);
+        ASSERT_TRUE(encode_result);
+        EXPECT_EQ(encode_result->status, blopp::encode_status::complete);
+        EXPECT_EQ(encode_result->written_size, size_t{ 0 });
+    }
+
+    TEST(encoder, ok_skips_blocks_outside_window) {
+        const auto input = std::vector<test_struct_counted>(size_t{ 1000 }, test_struct_counted{ .id = 1 });
+
+        auto encoder = blopp::encoder<std::vector<test_struct_counted>>{ input };
+        auto window = std::array<uint8_t, 64>{};
+
+        test_struct_counted::map_count = 0;
+        auto encode_result = encoder.write(window);
+        ASSERT_TRUE(encode_result);
+
+        // Planning writes all objects once, while the first window only writes the few objects in it.
+        EXPECT_LT(test_struct_counted::map_count, size_t{ 1000 + 10 });
+
+        while (encoder.status() != blopp::encode_status::complete) {
+            test_struct_counted::map_count = 0;
+            encode_result = encoder.write(window);
+            ASSERT_TRUE(encode_result);
+            EXPECT_LT(test_struct_counted::map_count, size_t{ 10 });
+        }
+    }
+
+    template<typename TOptions>
+    void test_windows_of_containers() {
+        const auto input = create_containers();
+
+        auto write_result = blopp::write<TOptions>(input);
+        ASSERT_TRUE(write_result);
+
+        for (const auto window_size : { size_t{ 1 }, size_t{ 13 }, size_t{ 256 }, size_t{ 1000000 } }) {
+            EXPECT_EQ((encode_in_windows<TOptions>(input, window_size)), *write_result);
+        }
+
+        auto read_result = blopp::read<TOptions, test_struct_containers>(encode_in_windows<TOptions>(input, size_t{ 13 }));
+        ASSERT_TRUE(read_result);
+        EXPECT_EQ(read_result->value.shared_values.at(0).at(0), read_result->value.shared_values.at(50).at(0));
+    }
+
+    TEST(encoder, ok_windows_of_containers) {
+        test_windows_of_containers<blopp::default_options>();
+    }
+
+    TEST(encoder, ok_windows_of_containers_indexed) {
+        test_windows_of_containers<test_index_options>();
+    }
+
+    TEST(encoder, ok_windows_of_containers_varint) {
+        test_windows_of_containers<blopp::varint_default_options>();
+    }
+
+    TEST(encoder, ok_windows_of_containers_varint_integers) {
+        test_windows_of_containers<test_varint_integers_options>();
+    }
+
+    TEST(encoder, ok_skips_shared_values_outside_window) {
+        auto input = std::vector<std::shared_ptr<test_struct_counted>>{};
+        for (uint32_t i = 0; i < 1000; i++) {
+            input.push_back(std::make_shared<test_struct_counted>(test_struct_counted{ .id = i }));
+        }
+        for (uint32_t i = 0; i < 1000; i++) {
+            input.push_back(input.at(i));
+        }
+
+        auto write_result = blopp::write(input);
+        ASSERT_TRUE(write_result);
+
+        auto encoder = blopp::encoder<std::vector<std::shared_ptr<test_struct_counted>>>{ input };
+        auto window = std::array<uint8_t, 64>{};
+        auto output = std::vector<uint8_t>{};
+
+        while (encoder.status() != blopp::encode_status::complete) {
+            test_struct_counted::map_count = 0;
+            auto encode_result = encoder.write(window);
+            ASSERT_TRUE(encode_result);
+            output.insert(output.end(), window.begin(), window.begin() + encode_result->written_size);
+
+            // Only the first call plans, mapping all objects once.
+            if (output.size() > window.size()) {
+                EXPECT_LT(test_struct_counted::map_count, size_t{ 10 });
+            }
+        }
+
+        EXPECT_EQ(output, *write_result);
+    }
+
+    TEST(encoder, fail_string_offset_overflow) {
+        const auto input = std::string(size_t{ 255 }, 'A');
+
+        auto encoder = blopp::encoder<std::string, blopp_test::minimal_offset_options>{ input };
+        auto window = std::array<uint8_t, 64>{};
+
+        auto encode_result = encoder.write(window);
+        ASSERT_FALSE(encode_result);
+        EXPECT_EQ(encode_result.error(), blopp::write_error_code::string_offset_overflow);
+
+        encode_result = encoder.write(window);
+        ASSERT_FALSE(encode_result);
+        EXPECT_EQ(encode_result.error(), blopp::write_error_code::string_offset_overflow);
+    }
+}
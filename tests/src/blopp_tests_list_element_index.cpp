@@ -0,0 +1,184 @@
+#include "blopp_test.hpp"
+
+namespace {
+    struct test_struct_product {
+        int32_t id = 0;
+        std::string name = {};
+        std::vector<int32_t> values = {};
+    };
+
+    bool operator == (const test_struct_product& lhs, const test_struct_product& rhs) {
+        return lhs.id == rhs.id && lhs.name == rhs.name && lhs.values == rhs.values;
+    }
+
+    struct test_index_options : blopp::default_options {
+        static constexpr auto list_element_index = true;
+    };
+
+    struct test_parallel_index_options : test_index_options {
+        static constexpr size_t parallel_write_chunk_size = 4;
+    };
+
+    auto make_test_products(const int32_t count) -> std::vector<test_struct_product> {
+        auto products = std::vector<test_struct_product>{};
+        for (int32_t i = 0; i < count; ++i) {
+            products.push_back(test_struct_product{
+                .id = i,
+                .name = std::string(static_cast<size_t>(i % 5), 'a'),
+                .values = std::vector<int32_t>(static_cast<size_t>(i % 3), i)
+            });
+        }
+        return products;
+    }
+}
+
+template<>
+struct blopp::object<test_struct_product> {
+    static auto map(auto& context, auto& value) {
+        context.map(value.id, value.name, value.values);
+    }
+};
+
+namespace {
+    TEST(list_element_index, ok_write_read) {
+        const auto input = make_test_products(20);
+
+        auto write_result = blopp::write<test_index_options>(input);
+        ASSERT_TRUE(write_result);
+
+        auto serial_write_result = blopp::write(input);
+        ASSERT_TRUE(serial_write_result);
+        EXPECT_EQ(write_result->size(), serial_write_result->size() + (input.size() * sizeof(uint64_t)));
+
+        // Lists with an element index are read regardless of options.
+        auto read_result = blopp::read<std::vector<test_struct_product>>(*write_result);
+        ASSERT_TRUE(read_result);
+        EXPECT_EQ(read_result->value, input);
+
+        auto verify_result = blopp::verify<std::vector<test_struct_product>>(*write_result);
+        EXPECT_TRUE(verify_result);
+
+        auto serialized_size_result = blopp::serialized_size<test_index_options>(input);
+        ASSERT_TRUE(serialized_size_result);
+        EXPECT_EQ(*serialized_size_result, write_result->size());
+    }
+
+    TEST(list_element_index, ok_encoder) {
+        const auto input = make_test_products(20);
+
+        auto write_result = blopp::write<test_index_options>(input);
+        ASSERT_TRUE(write_result);
+
+        auto encoder = blopp::encoder<std::vector<test_struct_product>, test_index_options>{ input };
+        auto window = std::vector<uint8_t>(7);
+        auto encoded = std::vector<uint8_t>{};
+
+        while (encoder.status() != blopp::encode_status::complete) {
+            auto encode_result = encoder.write(window);
+            ASSERT_TRUE(encode_result);
+            encoded.insert(encoded.end(), window.begin(), window.begin() + static_cast<std::ptrdiff_t>(encode_result->written_size));
+        }
+
+        EXPECT_EQ(encoded, *write_result);
+    }
+
+    TEST(list_element_index, ok_fixed_size_elements_without_index) {
+        const auto input = std::vector<int32_t>{ 1, 2, 3, 4 };
+
+        auto write_result = blopp::write<test_index_options>(input);
+        ASSERT_TRUE(write_result);
+
+        auto serial_write_result = blopp::write(input);
+        ASSERT_TRUE(serial_write_result);
+        EXPECT_EQ(*write_result, *serial_write_result);
+    }
+
+    TEST(list_element_index, ok_nested_lists) {
+        const auto input = std::list<std::vector<std::string>>{ { "a", "bc" }, {}, { "def" } };
+
+        auto write_result = blopp::write<test_index_options>(input);
+        ASSERT_TRUE(write_result);
+
+        auto read_result = blopp::read<std::list<std::vector<std::string>>>(*write_result);
+        ASSERT_TRUE(read_result);
+        EXPECT_EQ(read_result->value, input);
+
+        auto verify_result = blopp::verify<std::list<std::vector<std::string>>>(*write_result);
+        EXPECT_TRUE(verify_result);
+    }
+
+    TEST(list_element_index, ok_parallel_write) {
+        const auto input = make_test_products(50);
+
+        auto write_result = blopp::write<test_index_options>(input);
+        ASSERT_TRUE(write_result);
+
+        auto parallel_write_result = blopp::write<test_parallel_index_options>(input);
+        ASSERT_TRUE(parallel_write_result);
+        EXPECT_EQ(*parallel_write_result, *write_result);
+    }
+
+    TEST(list_element_index, ok_view_at) {
+        const auto input = make_test_products(20);
+
+        auto write_result = blopp::write<test_index_options>(input);
+        ASSERT_TRUE(write_result);
+
+        auto list_view = blopp::make_view(*write_result).value().as_list();
+        ASSERT_TRUE(list_view);
+        ASSERT_EQ(list_view->size(), size_t{ 20 });
+
+        for (const auto index : { 19, 0, 7, 13 }) {
+            auto product_view = list_view->at(static_cast<size_t>(index)).value().as_object();
+            ASSERT_TRUE(product_view);
+
+            auto id = product_view->at(0).value().as<int32_t>();
+            ASSERT_TRUE(id);
+            EXPECT_EQ(*id, index);
+
+            auto name = product_view->at(1).value().as<std::string>();
+            ASSERT_TRUE(name);
+            EXPECT_EQ(*name, input[static_cast<size_t>(index)].name);
+        }
+
+        auto out_of_range_view = list_view->at(20);
+        ASSERT_FALSE(out_of_range_view);
+        EXPECT_EQ(out_of_range_view.error(), blopp::read_error_code::out_of_range);
+    }
+
+    TEST(list_element_index, fail_bad_element_offset) {
+        const auto input = make_test_products(20);
+
+        auto write_result = blopp::write<test_index_options>(input);
+        ASSERT_TRUE(write_result);
+
+        // The element index ends the root list, and its last offset is the one of the last element.
+        write_result->at(write_result->size() - sizeof(uint64_t)) += 1;
+
+        auto verify_result = blopp::verify<std::vector<test_struct_product>>(*write_result);
+        ASSERT_FALSE(verify_result);
+        EXPECT_EQ(verify_result.error(), blopp::read_error_code::bad_list_element_index);
+
+        // Reads don't use the index.
+        auto read_result = blopp::read<std::vector<test_struct_product>>(*write_result);
+        ASSERT_TRUE(read_result);
+        EXPECT_EQ(read_result->value, input);
+    }
+
+    TEST(list_element_index, fail_element_index_out_of_bounds) {
+        const auto input = make_test_products(2);
+
+        auto write_result = blopp::write<test_index_options>(input);
+        ASSERT_TRUE(write_result);
+
+        const auto element_offset = uint64_t{ 1000 };
+        std::memcpy(write_result->data() + write_result->size() - sizeof(uint64_t), &element_offset, sizeof(element_offset));
+
+        auto list_view = blopp::make_view(*write_result).value().as_list();
+        ASSERT_TRUE(list_view);
+
+        auto element_view = list_view->at(1);
+        ASSERT_FALSE(element_view);
+        EXPECT_EQ(element_view.error(), blopp::read_error_code::bad_list_element_index);
+    }
+}
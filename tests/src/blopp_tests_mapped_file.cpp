@@ -0,0 +1,232 @@
+#include "blopp_test.hpp"
+#include "blopp_test_binary_format_types.hpp"
+#include <thread>
+
+#if defined(BLOPP_HAS_MEMORY_MAPPING)
+
+namespace {
+    struct test_struct_product {
+        uint64_t id = 0;
+        std::string name = {};
+        std::vector<int32_t> values = {};
+    };
+}
+
+template<>
+struct blopp::object<test_struct_product> {
+    static auto map(auto& context, auto& value) {
+        context.map(
+            value.id,
+            value.name,
+            value.values);
+    }
+};
+
+namespace {
+    std::filesystem::path create_test_file(const std::filesystem::path& path, std::span<const uint8_t> data) {
+        if (std::filesystem::exists(path)) {
+            std::filesystem::remove(path);
+        }
+
+        auto stream = std::ofstream{ path, std::ofstream::binary };
+        stream.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+        return path;
+    }
+
+    TEST(mapped_file, fail_cannot_open_file) {
+        const auto path = std::filesystem::path{ "this_path/does/not/exist/or/does/it" };
+
+        auto mapped_file_result = blopp::mapped_file::open(path);
+        ASSERT_FALSE(mapped_file_result);
+        EXPECT_EQ(mapped_file_result.error(), blopp::read_error_code::cannot_open_file);
+
+        auto read_result = blopp::read<int32_t>(path);
+        ASSERT_FALSE(read_result);
+        EXPECT_EQ(read_result.error(), blopp::read_error_code::cannot_open_file);
+    }
+
+    TEST(mapped_file, ok_empty_file) {
+        const auto path = create_test_file("mapped_file_blopp_test_file_1.bin", {});
+
+        auto mapped_file_result = blopp::mapped_file::open(path);
+        ASSERT_TRUE(mapped_file_result);
+        EXPECT_EQ(mapped_file_result->size(), size_t{ 0 });
+        EXPECT_TRUE(mapped_file_result->data().empty());
+
+        auto read_result = blopp::read<int32_t>(mapped_file_result->data());
+        ASSERT_FALSE(read_result);
+        EXPECT_EQ(read_result.error(), blopp::read_error_code::insufficient_data);
+    }
+
+    TEST(mapped_file, ok_read_mapped_file) {
+        const auto input = test_struct_product{
+            .id = 123,
+            .name = "Apple",
+            .values = std::vector<int32_t>(size_t{ 10000 }, int32_t{ 456 })
+        };
+
+        auto write_result = blopp::write(input);
+        ASSERT_TRUE(write_result);
+
+        const auto path = create_test_file("mapped_file_blopp_test_file_2.bin", *write_result);
+
+        auto mapped_file_result = blopp::mapped_file::open(path, blopp::mapped_file_advice::will_need);
+        ASSERT_TRUE(mapped_file_result);
+        EXPECT_TRUE(mapped_file_result->advise(blopp::mapped_file_advice::random));
+
+        auto mapped_file = std::move(mapped_file_result.value());
+        ASSERT_EQ(mapped_file.size(), write_result->size());
+        EXPECT_TRUE(std::equal(write_result->begin(), write_result->end(), mapped_file.data().begin()));
+
+        auto read_result = blopp::read<test_struct_product>(mapped_file.data());
+        ASSERT_TRUE(read_result);
+
+        auto& output = read_result->value;
+        EXPECT_EQ(output.id, input.id);
+        EXPECT_STREQ(output.name.c_str(), input.name.c_str());
+        EXPECT_EQ(output.values, input.values);
+    }
+
+    TEST(mapped_file, ok_read_path) {
+        const auto input = test_struct_product{
+            .id = 123,
+            .name = "Apple",
+            .values = { 1, 2, 3 }
+        };
+
+        auto write_result = blopp::write(input);
+        ASSERT_TRUE(write_result);
+
+        const auto path = create_test_file("mapped_file_blopp_test_file_3.bin", *write_result);
+
+        auto read_result = blopp::read<test_struct_product>(path);
+        ASSERT_TRUE(read_result);
+        EXPECT_TRUE(read_result->remaining.empty());
+
+        auto& output = read_result->value;
+        EXPECT_EQ(output.id, input.id);
+        EXPECT_STREQ(output.name.c_str(), input.name.c_str());
+        EXPECT_EQ(output.values, input.values);
+    }
+
+    TEST(mapped_file, ok_read_path_of_pipe) {
+        const auto input = test_struct_product{
+            .id = 123,
+            .name = "Apple",
+            .values = { 1, 2, 3 }
+        };
+
+        auto write_result = blopp::write(input);
+        ASSERT_TRUE(write_result);
+
+        const auto path = std::filesystem::path{ "mapped_file_blopp_test_pipe" };
+        std::filesystem::remove(path);
+        ASSERT_EQ(::mkfifo(path.c_str(), 0600), 0);
+
+        // Opening a pipe blocks until it's opened for both reading and writing.
+        auto writer = std::thread{ [&]() {
+            auto stream = std::ofstream{ path, std::ofstream::binary };
+            stream.write(reinterpret_cast<const char*>(write_result->data()), static_cast<std::streamsize>(write_result->size()));
+        } };
+
+        auto read_result = blopp::read<test_struct_product>(path);
+        writer.join();
+        std::filesystem::remove(path);
+
+        ASSERT_TRUE(read_result);
+
+        auto& output = read_result->value;
+        EXPECT_EQ(output.id, input.id);
+        EXPECT_STREQ(output.name.c_str(), input.name.c_str());
+        EXPECT_EQ(output.values, input.values);
+    }
+
+    TEST(mapped_file, ok_mapped_file_output_sink) {
+        const auto input = test_struct_product{
+            .id = 123,
+            .name = "Apple",
+            .values = std::vector<int32_t>(size_t{ 10000 }, int32_t{ 456 })
+        };
+
+        auto write_result = blopp::write(input);
+        ASSERT_TRUE(write_result);
+
+        const auto path = std::filesystem::path{ "mapped_file_blopp_test_file_4.bin" };
+
+        {
+            auto output_sink_result = blopp::mapped_file_output_sink::open(path, size_t{ 4096 });
+            ASSERT_TRUE(output_sink_result);
+
+            auto output_sink = std::move(output_sink_result.value());
+
+            auto write_sink_result = blopp::write(input, output_sink);
+            ASSERT_TRUE(write_sink_result);
+            EXPECT_EQ(output_sink.position(), write_result->size());
+            EXPECT_TRUE(output_sink.finish());
+        }
+
+        ASSERT_EQ(std::filesystem::file_size(path), write_result->size());
+
+        auto mapped_file_result = blopp::mapped_file::open(path);
+        ASSERT_TRUE(mapped_file_result);
+        EXPECT_TRUE(std::equal(write_result->begin(), write_result->end(), mapped_file_result->data().begin()));
+    }
+
+    TEST(mapped_file, ok_mapped_file_output_sink_small_allocation) {
+        const auto path = std::filesystem::path{ "mapped_file_blopp_test_file_8.bin" };
+
+        auto output_sink_result = blopp::mapped_file_output_sink::open(path);
+        ASSERT_TRUE(output_sink_result);
+
+        // Small values only allocate the page they are written into.
+        auto write_sink_result = blopp::write(std::string{ "Hello world" }, output_sink_result.value());
+        ASSERT_TRUE(write_sink_result);
+        EXPECT_EQ(std::filesystem::file_size(path), uintmax_t{ blopp::mapped_file_output_sink::page_size });
+
+        const auto position = output_sink_result->position();
+        EXPECT_TRUE(output_sink_result->finish());
+        EXPECT_EQ(std::filesystem::file_size(path), uintmax_t{ position });
+    }
+
+    TEST(mapped_file, ok_mapped_file_output_sink_discard) {
+        const auto path = std::filesystem::path{ "mapped_file_blopp_test_file_5.bin" };
+
+        auto output_sink_result = blopp::mapped_file_output_sink::open(path);
+        ASSERT_TRUE(output_sink_result);
+
+        auto write_sink_result = blopp::write(std::string{ "Hello world" }, output_sink_result.value());
+        ASSERT_TRUE(write_sink_result);
+        EXPECT_TRUE(output_sink_result->discard());
+
+        EXPECT_EQ(std::filesystem::file_size(path), uintmax_t{ 0 });
+    }
+
+    TEST(mapped_file, ok_write_path) {
+        const auto input = std::vector<std::string>(size_t{ 100 }, std::string{ "Hello world" });
+
+        auto write_result = blopp::write(input);
+        ASSERT_TRUE(write_result);
+
+        const auto path = std::filesystem::path{ "mapped_file_blopp_test_file_6.bin" };
+
+        auto write_path_result = blopp::write(input, path);
+        ASSERT_TRUE(write_path_result);
+        ASSERT_EQ(std::filesystem::file_size(path), write_result->size());
+
+        auto read_result = blopp::read<std::vector<std::string>>(path);
+        ASSERT_TRUE(read_result);
+        EXPECT_EQ(read_result->value, input);
+    }
+
+    TEST(mapped_file, fail_write_path_discards_file) {
+        const auto path = std::filesystem::path{ "mapped_file_blopp_test_file_7.bin" };
+
+        auto write_path_result = blopp::write<blopp_test::minimal_offset_options>(std::string(size_t{ 255 }, 'A'), path);
+        ASSERT_FALSE(write_path_result);
+        EXPECT_EQ(write_path_result.error(), blopp::write_error_code::string_offset_overflow);
+
+        EXPECT_EQ(std::filesystem::file_size(path), uintmax_t{ 0 });
+    }
+}
+
+#endif
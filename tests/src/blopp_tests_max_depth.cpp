@@ -0,0 +1,165 @@
+#include "blopp_test.hpp"
+
+namespace {
+    struct test_struct_node {
+        int32_t value = 0;
+        std::unique_ptr<test_struct_node> next = {};
+    };
+
+    struct test_struct_shared_chain {
+        std::shared_ptr<test_struct_node> chain = {};
+        std::optional<std::optional<std::shared_ptr<test_struct_node>>> nested_chain = {};
+    };
+
+    // Skips the chain, so the nested reference to it is read from the position of the chain.
+    struct test_struct_shared_chain_skip_chain {
+        std::optional<std::optional<std::shared_ptr<test_struct_node>>> nested_chain = {};
+    };
+
+    template<size_t Vmax_depth>
+    struct test_max_depth_options : blopp::default_options {
+        static constexpr auto max_depth = Vmax_depth;
+    };
+
+    using test_unlimited_depth_options = test_max_depth_options<std::numeric_limits<size_t>::max()>;
+
+    auto make_test_chain(const int32_t count) -> test_struct_node {
+        auto root = test_struct_node{ .value = 0 };
+        auto* node = &root;
+        for (int32_t i = 1; i < count; ++i) {
+            node->next = std::make_unique<test_struct_node>(test_struct_node{ .value = i });
+            node = node->next.get();
+        }
+        return root;
+    }
+
+    auto get_test_chain_length(const test_struct_node& root) -> int32_t {
+        auto length = int32_t{ 1 };
+        for (auto* node = root.next.get(); node != nullptr; node = node->next.get()) {
+            EXPECT_EQ(node->value, length);
+            ++length;
+        }
+        return length;
+    }
+}
+
+template<>
+struct blopp::object<test_struct_node> {
+    static auto map(auto& context, auto& value) {
+        context.map(value.value, value.next);
+    }
+};
+
+template<>
+struct blopp::object<test_struct_shared_chain> {
+    static auto map(auto& context, auto& value) {
+        context.map(value.chain, value.nested_chain);
+    }
+};
+
+template<>
+struct blopp::object<test_struct_shared_chain_skip_chain> {
+    static auto map(auto& context, auto& value) {
+        context.skip();
+        context.map(value.nested_chain);
+    }
+};
+
+namespace {
+    TEST(max_depth, ok_unlimited) {
+        const auto input = make_test_chain(1000);
+
+        auto write_result = blopp::write<test_unlimited_depth_options>(input);
+        ASSERT_TRUE(write_result);
+
+        auto read_result = blopp::read<test_unlimited_depth_options, test_struct_node>(*write_result);
+        ASSERT_TRUE(read_result);
+        EXPECT_EQ(get_test_chain_length(read_result->value), 1000);
+    }
+
+    TEST(max_depth, ok_unlimited_by_default) {
+        static_assert(blopp::impl::options_max_depth_v<blopp::default_options> == std::numeric_limits<size_t>::max());
+
+        const auto input = make_test_chain(1000);
+
+        auto write_result = blopp::write(input);
+        ASSERT_TRUE(write_result);
+
+        auto read_result = blopp::read<test_struct_node>(*write_result);
+        ASSERT_TRUE(read_result);
+        EXPECT_EQ(get_test_chain_length(read_result->value), 1000);
+
+        auto verify_result = blopp::verify<blopp::default_options, test_struct_node>(*write_result);
+        EXPECT_TRUE(verify_result);
+    }
+
+    TEST(max_depth, ok_within_max_depth) {
+        // Each node is nested by its object and unique_ptr, except the null unique_ptr of the last node.
+        const auto input = make_test_chain(10);
+
+        auto write_result = blopp::write<test_max_depth_options<19>>(input);
+        ASSERT_TRUE(write_result);
+
+        auto read_result = blopp::read<test_max_depth_options<19>, test_struct_node>(*write_result);
+        ASSERT_TRUE(read_result);
+        EXPECT_EQ(get_test_chain_length(read_result->value), 10);
+
+        auto verify_result = blopp::verify<test_max_depth_options<19>, test_struct_node>(*write_result);
+        EXPECT_TRUE(verify_result);
+    }
+
+    TEST(max_depth, fail_max_depth_exceeded) {
+        const auto input = make_test_chain(10);
+
+        auto write_result = blopp::write<test_max_depth_options<19>>(input);
+        ASSERT_TRUE(write_result);
+
+        auto write_result_18 = blopp::write<test_max_depth_options<18>>(input);
+        ASSERT_FALSE(write_result_18);
+        EXPECT_EQ(write_result_18.error(), blopp::write_error_code::max_depth_exceeded);
+
+        auto read_result = blopp::read<test_max_depth_options<18>, test_struct_node>(*write_result);
+        ASSERT_FALSE(read_result);
+        EXPECT_EQ(read_result.error(), blopp::read_error_code::max_depth_exceeded);
+
+        auto verify_result = blopp::verify<test_max_depth_options<18>, test_struct_node>(*write_result);
+        ASSERT_FALSE(verify_result);
+        EXPECT_EQ(verify_result.error(), blopp::read_error_code::max_depth_exceeded);
+    }
+
+    TEST(max_depth, fail_max_depth_exceeded_nested_lists) {
+        using nested_list_t = std::vector<std::vector<std::vector<int32_t>>>;
+        const auto input = nested_list_t{ { { 1, 2 }, { 3 } }, { { 4 } } };
+
+        auto write_result = blopp::write(input);
+        ASSERT_TRUE(write_result);
+
+        auto read_result_3 = blopp::read<test_max_depth_options<3>, nested_list_t>(*write_result);
+        ASSERT_TRUE(read_result_3);
+        EXPECT_EQ(read_result_3->value, input);
+
+        auto read_result_2 = blopp::read<test_max_depth_options<2>, nested_list_t>(*write_result);
+        ASSERT_FALSE(read_result_2);
+        EXPECT_EQ(read_result_2.error(), blopp::read_error_code::max_depth_exceeded);
+    }
+
+    TEST(max_depth, fail_max_depth_exceeded_referenced_value) {
+        auto input = test_struct_shared_chain{};
+        input.chain = std::make_shared<test_struct_node>(make_test_chain(10));
+        input.nested_chain = input.chain;
+
+        // The chain is read 2 levels deeper via the nested reference than via the chain itself.
+        auto write_result = blopp::write<test_max_depth_options<21>>(input);
+        ASSERT_TRUE(write_result);
+
+        auto read_result = blopp::read<test_max_depth_options<21>, test_struct_shared_chain>(*write_result);
+        ASSERT_TRUE(read_result);
+
+        auto read_skip_result_23 = blopp::read<test_max_depth_options<23>, test_struct_shared_chain_skip_chain>(*write_result);
+        ASSERT_TRUE(read_skip_result_23);
+
+        auto read_skip_result_22 = blopp::read<test_max_depth_options<22>, test_struct_shared_chain_skip_chain>(*write_result);
+        ASSERT_FALSE(read_skip_result_22);
+        EXPECT_EQ(read_skip_result_22.error(), blopp::read_error_code::max_depth_exceeded);
+    }
+}
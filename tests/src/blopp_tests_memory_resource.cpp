@@ -0,0 +1,221 @@
+#include "blopp_test.hpp"
+#include <memory_resource>
+
+namespace {
+    struct test_struct_product {
+        uint32_t id = 0;
+        std::pmr::string name = {};
+        std::pmr::vector<int32_t> values = {};
+    };
+
+    struct test_struct_store {
+        std::pmr::string name = {};
+        std::pmr::vector<test_struct_product> products = {};
+        std::pmr::list<std::pmr::string> categories = {};
+        std::pmr::map<int32_t, std::pmr::string> tags = {};
+        std::optional<std::pmr::u16string> comment = {};
+        std::shared_ptr<test_struct_product> featured_1 = {};
+        std::shared_ptr<test_struct_product> featured_2 = {};
+        blopp::pmr_unique_ptr<test_struct_product> cheapest = {};
+    };
+
+    // Counts allocations made from the wrapped memory resource.
+    class test_counting_memory_resource : public std::pmr::memory_resource {
+
+    public:
+
+        explicit test_counting_memory_resource(std::pmr::memory_resource* upstream) :
+            m_upstream{ upstream }
+        {}
+
+        size_t allocation_count = 0;
+
+    private:
+
+        void* do_allocate(const size_t bytes, const size_t alignment) override {
+            ++allocation_count;
+            return m_upstream->allocate(bytes, alignment);
+        }
+
+        void do_deallocate(void* pointer, const size_t bytes, const size_t alignment) override {
+            m_upstream->deallocate(pointer, bytes, alignment);
+        }
+
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+            return this == &other;
+        }
+
+        std::pmr::memory_resource* m_upstream;
+
+    };
+
+    // Replaces the default memory resource during a scope, to catch allocations not made from the memory resource of a read.
+    class test_default_resource_scope {
+
+    public:
+
+        explicit test_default_resource_scope(std::pmr::memory_resource* resource) :
+            m_previous{ std::pmr::set_default_resource(resource) }
+        {}
+
+        ~test_default_resource_scope() {
+            std::pmr::set_default_resource(m_previous);
+        }
+
+    private:
+
+        std::pmr::memory_resource* m_previous;
+
+    };
+}
+
+template<>
+struct blopp::object<test_struct_product> {
+    static auto map(auto& context, auto& value) {
+        context.map(
+            value.id,
+            value.name,
+            value.values);
+    }
+};
+
+template<>
+struct blopp::object<test_struct_store> {
+    static auto map(auto& context, auto& value) {
+        context.map(
+            value.name,
+            value.products,
+            value.categories,
+            value.tags,
+            value.comment,
+            value.featured_1,
+            value.featured_2,
+            value.cheapest);
+    }
+};
+
+namespace {
+    static_assert(blopp::impl::is_std_pmr_container_v<std::pmr::string>);
+    static_assert(blopp::impl::is_std_pmr_container_v<std::pmr::vector<int32_t>>);
+    static_assert(blopp::impl::is_std_pmr_container_v<std::pmr::map<int32_t, int32_t>>);
+    static_assert(!blopp::impl::is_std_pmr_container_v<std::string>);
+    static_assert(!blopp::impl::is_std_pmr_container_v<std::array<int32_t, 4>>);
+
+    test_struct_store create_store() {
+        auto result = test_struct_store{};
+        result.name = "Fruit store with a name longer than a small string";
+        result.categories = { "Fruit", "Vegetables" };
+        result.tags = { { 1, "one" }, { 2, "two" } };
+        result.comment = u"Comment of a store with a name longer than a small string";
+
+        for (uint32_t i = 0; i < 20; i++) {
+            auto product = test_struct_product{};
+            product.id = i;
+            product.name = "Product with a name longer than a small string " + std::to_string(i);
+            product.values = std::pmr::vector<int32_t>(i, static_cast<int32_t>(i));
+            result.products.push_back(std::move(product));
+        }
+
+        result.featured_1 = std::make_shared<test_struct_product>(result.products.at(10));
+        result.featured_2 = result.featured_1;
+        result.cheapest = blopp::pmr_unique_ptr<test_struct_product>{ new test_struct_product{ result.products.at(3) } };
+
+        return result;
+    }
+
+    void expect_equal(const test_struct_product& output, const test_struct_product& input) {
+        EXPECT_EQ(output.id, input.id);
+        EXPECT_EQ(output.name, input.name);
+        EXPECT_EQ(output.values, input.values);
+    }
+
+    void expect_equal(const test_struct_store& output, const test_struct_store& input) {
+        EXPECT_EQ(output.name, input.name);
+        EXPECT_EQ(output.categories, input.categories);
+        EXPECT_EQ(output.tags, input.tags);
+        EXPECT_EQ(output.comment, input.comment);
+
+        ASSERT_EQ(output.products.size(), input.products.size());
+        for (size_t i = 0; i < input.products.size(); i++) {
+            expect_equal(output.products.at(i), input.products.at(i));
+        }
+
+        ASSERT_TRUE(output.featured_1);
+        expect_equal(*output.featured_1, *input.featured_1);
+        EXPECT_EQ(output.featured_1, output.featured_2);
+        ASSERT_TRUE(output.cheapest);
+        expect_equal(*output.cheapest, *input.cheapest);
+    }
+
+    TEST(memory_resource, ok_read) {
+        const auto input = create_store();
+
+        auto write_result = blopp::write(input);
+        ASSERT_TRUE(write_result);
+
+        auto memory_resource = test_counting_memory_resource{ std::pmr::new_delete_resource() };
+
+        auto read_result = blopp::read<test_struct_store>(*write_result, &memory_resource);
+        ASSERT_TRUE(read_result);
+        EXPECT_GT(memory_resource.allocation_count, size_t{ 0 });
+
+        auto& output = read_result->value;
+        expect_equal(output, input);
+
+        EXPECT_EQ(output.name.get_allocator().resource(), &memory_resource);
+        EXPECT_EQ(output.products.get_allocator().resource(), &memory_resource);
+        EXPECT_EQ(output.products.at(1).name.get_allocator().resource(), &memory_resource);
+        EXPECT_EQ(output.products.at(1).values.get_allocator().resource(), &memory_resource);
+        EXPECT_EQ(output.categories.front().get_allocator().resource(), &memory_resource);
+        EXPECT_EQ(output.tags.at(1).get_allocator().resource(), &memory_resource);
+        EXPECT_EQ(output.comment->get_allocator().resource(), &memory_resource);
+        EXPECT_EQ(output.featured_1->name.get_allocator().resource(), &memory_resource);
+        EXPECT_EQ(output.cheapest.get_deleter().memory_resource, &memory_resource);
+        EXPECT_EQ(output.cheapest->name.get_allocator().resource(), &memory_resource);
+    }
+
+    TEST(memory_resource, ok_read_monotonic_buffer) {
+        const auto input = create_store();
+
+        auto write_result = blopp::write(input);
+        ASSERT_TRUE(write_result);
+
+        auto buffer = std::vector<std::byte>(size_t{ 65536 });
+        auto memory_resource = std::pmr::monotonic_buffer_resource{
+            buffer.data(), buffer.size(), std::pmr::null_memory_resource() };
+
+        // Every allocation must come from the buffer, as the default resource fails all allocations.
+        auto default_resource_scope = test_default_resource_scope{ std::pmr::null_memory_resource() };
+
+        auto read_result = blopp::read<test_struct_store>(*write_result, &memory_resource);
+        ASSERT_TRUE(read_result);
+        expect_equal(read_result->value, input);
+    }
+
+    TEST(memory_resource, ok_read_default_resource) {
+        const auto input = create_store();
+
+        auto write_result = blopp::write(input);
+        ASSERT_TRUE(write_result);
+
+        auto read_result = blopp::read<test_struct_store>(*write_result);
+        ASSERT_TRUE(read_result);
+
+        auto& output = read_result->value;
+        expect_equal(output, input);
+        EXPECT_EQ(output.name.get_allocator().resource(), std::pmr::get_default_resource());
+        EXPECT_EQ(output.cheapest.get_deleter().memory_resource, std::pmr::get_default_resource());
+    }
+
+    TEST(memory_resource, fail_insufficient_data) {
+        auto write_result = blopp::write(create_store());
+        ASSERT_TRUE(write_result);
+
+        auto memory_resource = std::pmr::monotonic_buffer_resource{};
+
+        auto read_result = blopp::read<test_struct_store>(
+            std::span{ *write_result }.first(write_result->size() - 1), &memory_resource);
+        ASSERT_FALSE(read_result);
+        EXPECT_EQ(read_result.error(), blopp::read_error_code::insufficient_data);
+    }
+}
@@ -0,0 +1,171 @@
+#include "blopp_test.hpp"
+#include <memory_resource>
+
+namespace {
+    struct test_struct_product {
+        uint32_t id;
+        std::string name;
+        std::vector<int32_t> values;
+    };
+
+    // Keeps output in fixed size pages, to verify that blopp works with any output sink.
+    class test_paged_output_sink {
+
+    public:
+
+        static constexpr size_t page_size = 4;
+
+        size_t position() const {
+            return m_position;
+        }
+
+        void append(const uint8_t value) {
+            if (m_position % page_size == 0) {
+                m_pages.emplace_back();
+            }
+            m_pages.back().at(m_position % page_size) = value;
+            ++m_position;
+        }
+
+        void append(const uint8_t* data, const size_t size) {
+            for (size_t i = 0; i < size; i++) {
+                append(data[i]);
+            }
+        }
+
+        size_t reserve(const size_t size) {
+            const auto position = m_position;
+            for (size_t i = 0; i < size; i++) {
+                append(uint8_t{ 0 });
+            }
+            return position;
+        }
+
+        void patch(const size_t position, const uint8_t* data, const size_t size) {
+            for (size_t i = 0; i < size; i++) {
+                m_pages.at((position + i) / page_size).at((position + i) % page_size) = data[i];
+            }
+        }
+
+        std::optional<blopp::write_error_code> error() const {
+            return {};
+        }
+
+        std::vector<uint8_t> to_vector() const {
+            auto result = std::vector<uint8_t>{};
+            for (const auto& page : m_pages) {
+                result.insert(result.end(), page.begin(), page.end());
+            }
+            result.resize(m_position);
+            return result;
+        }
+
+    private:
+
+        std::vector<std::array<uint8_t, page_size>> m_pages;
+        size_t m_position = 0;
+
+    };
+}
+
+template<>
+struct blopp::object<test_struct_product> {
+    static auto map(auto& context, auto& value) {
+        context.map(
+            value.id,
+            value.name,
+            value.values);
+    }
+};
+
+namespace {
+    static_assert(blopp::output_sink<blopp::vector_output_sink<>>);
+    static_assert(blopp::output_sink<blopp::pmr_vector_output_sink>);
+    static_assert(blopp::output_sink<blopp::span_output_sink>);
+    static_assert(blopp::output_sink<blopp::counting_output_sink>);
+    static_assert(blopp::output_sink<test_paged_output_sink>);
+    static_assert(!blopp::output_sink<std::vector<uint8_t>>);
+
+    const auto test_product = test_struct_product{
+        .id = 123,
+        .name = "Apple",
+        .values = { 1, 2, 3, 4 }
+    };
+
+    TEST(output_sink, ok_vector_output_sink) {
+        auto write_result = blopp::write(test_product);
+        ASSERT_TRUE(write_result);
+
+        auto output = std::vector<uint8_t>{};
+        auto output_sink = blopp::vector_output_sink{ output };
+
+        auto write_sink_result = blopp::write(test_product, output_sink);
+        ASSERT_TRUE(write_sink_result);
+        EXPECT_EQ(output_sink.position(), write_result->size());
+        EXPECT_EQ(output, *write_result);
+    }
+
+    TEST(output_sink, ok_pmr_vector_output_sink) {
+        auto write_result = blopp::write(test_product);
+        ASSERT_TRUE(write_result);
+
+        auto buffer = std::array<std::byte, 1024>{};
+        auto memory_resource = std::pmr::monotonic_buffer_resource{ buffer.data(), buffer.size(), std::pmr::null_memory_resource() };
+
+        auto output = std::pmr::vector<uint8_t>{ &memory_resource };
+        auto output_sink = blopp::pmr_vector_output_sink{ output };
+
+        auto write_sink_result = blopp::write(test_product, output_sink);
+        ASSERT_TRUE(write_sink_result);
+        ASSERT_EQ(output.size(), write_result->size());
+        EXPECT_TRUE(std::equal(output.begin(), output.end(), write_result->begin()));
+
+        auto read_result = blopp::read<test_struct_product>(std::span{ output.data(), output.size() });
+        ASSERT_TRUE(read_result);
+        EXPECT_EQ(read_result->value.values, test_product.values);
+    }
+
+    TEST(output_sink, ok_span_output_sink) {
+        auto write_result = blopp::write(test_product);
+        ASSERT_TRUE(write_result);
+
+        auto buffer = std::vector<uint8_t>(write_result->size());
+        auto output_sink = blopp::span_output_sink{ buffer };
+
+        auto write_sink_result = blopp::write(test_product, output_sink);
+        ASSERT_TRUE(write_sink_result);
+        EXPECT_EQ(output_sink.position(), write_result->size());
+        EXPECT_EQ(buffer, *write_result);
+    }
+
+    TEST(output_sink, ok_counting_output_sink) {
+        auto write_result = blopp::write(test_product);
+        ASSERT_TRUE(write_result);
+
+        auto output_sink = blopp::counting_output_sink{};
+
+        auto write_sink_result = blopp::write(test_product, output_sink);
+        ASSERT_TRUE(write_sink_result);
+        EXPECT_EQ(output_sink.position(), write_result->size());
+    }
+
+    TEST(output_sink, ok_custom_output_sink) {
+        auto write_result = blopp::write<blopp::compact_default_options>(test_product);
+        ASSERT_TRUE(write_result);
+
+        auto output_sink = test_paged_output_sink{};
+
+        auto write_sink_result = blopp::write<blopp::compact_default_options>(test_product, output_sink);
+        ASSERT_TRUE(write_sink_result);
+        EXPECT_EQ(output_sink.to_vector(), *write_result);
+    }
+
+    TEST(output_sink, fail_span_output_sink_insufficient_buffer) {
+        auto buffer = std::array<uint8_t, 8>{};
+        auto output_sink = blopp::span_output_sink{ buffer };
+
+        auto write_sink_result = blopp::write(test_product, output_sink);
+        ASSERT_FALSE(write_sink_result);
+        EXPECT_EQ(write_sink_result.error(), blopp::write_error_code::insufficient_buffer);
+    }
+}
@@ -0,0 +1,354 @@
+#include "blopp_test.hpp"
+
+namespace {
+    struct test_struct_item {
+        int32_t id = 0;
+        std::string name = {};
+        std::shared_ptr<std::string> tag = {};
+        std::vector<int32_t> values = {};
+    };
+
+    bool operator == (const test_struct_item& lhs, const test_struct_item& rhs) {
+        return 
+            lhs.id == rhs.id &&
+            lhs.name == rhs.name &&
+            (lhs.tag == nullptr) == (rhs.tag == nullptr) &&
+            (lhs.tag == nullptr || *lhs.tag == *rhs.tag) &&
+            lhs.values == rhs.values;
+    }
+
+    struct test_struct_catalog {
+        std::shared_ptr<std::string> default_tag = {};
+        std::vector<test_struct_item> items = {};
+        std::map<int32_t, test_struct_item> items_by_id = {};
+        std::list<std::shared_ptr<std::string>> tags = {};
+    };
+
+    // Counts the values mapped, to check that elements are read once.
+    struct test_struct_counted {
+        int32_t value = 0;
+        static inline size_t map_count = 0;
+    };
+
+    // Runs tasks on threads of its own, regardless of the hardware thread count.
+    struct test_thread_pool_executor {
+        static void run(const size_t task_count, const std::function<void(size_t)>& task) {
+            static auto thread_pool = blopp::thread_pool_executor{ 3 };
+            thread_pool.run_tasks(task_count, task);
+        }
+    };
+
+    // Runs tasks in reverse order on the calling thread, to read chunks out of order.
+    struct test_reverse_executor {
+        static void run(const size_t task_count, const std::function<void(size_t)>& task) {
+            for (size_t i = task_count; i > 0; --i) {
+                task(i - 1);
+            }
+        }
+    };
+
+    template<typename TExecutor>
+    struct test_parallel_options : blopp::default_options {
+        static constexpr size_t parallel_read_chunk_size = 8;
+        using read_executor = TExecutor;
+    };
+
+    struct test_parallel_trusted_options : test_parallel_options<test_thread_pool_executor> {
+        static constexpr auto trusted_input = true;
+    };
+
+    // Reads every element in a chunk of its own, last chunk first, so references to earlier elements are deferred.
+    struct test_single_element_chunk_options : blopp::default_options {
+        static constexpr size_t parallel_read_chunk_size = 1;
+        using read_executor = test_reverse_executor;
+    };
+
+    struct test_index_options : blopp::default_options {
+        static constexpr auto list_element_index = true;
+    };
+
+    auto make_test_catalog(const int32_t item_count) -> test_struct_catalog {
+        auto catalog = test_struct_catalog{};
+        catalog.default_tag = std::make_shared<std::string>("default");
+
+        // Tags are shared by items of different chunks, and by items and the default tag read before them.
+        auto tags = std::vector<std::shared_ptr<std::string>>{};
+        for (int32_t i = 0; i < 5; ++i) {
+            tags.push_back(std::make_shared<std::string>("tag_" + std::to_string(i)));
+        }
+
+        for (int32_t i = 0; i < item_count; ++i) {
+            auto item = test_struct_item{
+                .id = i,
+                .name = "item_" + std::to_string(i),
+                .tag = i % 7 == 0 ? catalog.default_tag : i % 3 == 0 ? nullptr : tags[static_cast<size_t>(i) % tags.size()],
+                .values = std::vector<int32_t>(static_cast<size_t>(i % 4), i)
+            };
+            catalog.items_by_id.emplace(i, item);
+            catalog.items.push_back(std::move(item));
+        }
+
+        catalog.tags.assign(tags.begin(), tags.end());
+        catalog.tags.insert(catalog.tags.end(), tags.begin(), tags.end());
+
+        return catalog;
+    }
+
+    void expect_equal_catalogs(const test_struct_catalog& lhs, const test_struct_catalog& rhs) {
+        ASSERT_NE(lhs.default_tag, nullptr);
+        EXPECT_EQ(*lhs.default_tag, *rhs.default_tag);
+        EXPECT_EQ(lhs.items, rhs.items);
+        EXPECT_EQ(lhs.items_by_id, rhs.items_by_id);
+        ASSERT_EQ(lhs.tags.size(), rhs.tags.size());
+    }
+
+    // Values shared by the input are shared by the output as well.
+    void expect_shared_values(const test_struct_catalog& catalog) {
+        auto tags = std::map<std::string, std::shared_ptr<std::string>>{ { *catalog.default_tag, catalog.default_tag } };
+
+        for (const auto& item : catalog.items) {
+            if (item.tag != nullptr) {
+                const auto& tag = tags.emplace(*item.tag, item.tag).first->second;
+                EXPECT_EQ(item.tag, tag) << item.id;
+            }
+
+            EXPECT_EQ(catalog.items_by_id.at(item.id).tag, item.tag) << item.id;
+        }
+
+        ASSERT_EQ(catalog.tags.size(), size_t{ 10 });
+        auto first_it = catalog.tags.begin();
+        auto second_it = std::next(catalog.tags.begin(), 5);
+        for (size_t i = 0; i < 5; ++i, ++first_it, ++second_it) {
+            EXPECT_EQ(*first_it, *second_it);
+            if (const auto it = tags.find(**first_it); it != tags.end()) {
+                EXPECT_EQ(*first_it, it->second);
+            }
+        }
+    }
+}
+
+template<>
+struct blopp::object<test_struct_item> {
+    static auto map(auto& context, auto& value) {
+        context.map(value.id, value.name, value.tag, value.values);
+    }
+};
+
+template<>
+struct blopp::object<test_struct_counted> {
+    static auto map(auto& context, auto& value) {
+        ++test_struct_counted::map_count;
+        context.map(value.value);
+    }
+};
+
+template<>
+struct blopp::object<test_struct_catalog> {
+    static auto map(auto& context, auto& value) {
+        context.map(value.default_tag, value.items, value.items_by_id, value.tags);
+    }
+};
+
+namespace {
+    template<typename TReadOptions, typename TWriteOptions = blopp::default_options>
+    void test_parallel_read(const int32_t item_count) {
+        const auto input = make_test_catalog(item_count);
+
+        auto write_result = blopp::write<TWriteOptions>(input);
+        ASSERT_TRUE(write_result);
+
+        auto read_result = blopp::read<TReadOptions, test_struct_catalog>(*write_result);
+        ASSERT_TRUE(read_result);
+        EXPECT_TRUE(read_result->remaining.empty());
+
+        expect_equal_catalogs(read_result->value, input);
+        expect_shared_values(read_result->value);
+    }
+
+    TEST(parallel_read, ok_thread_pool) {
+        for (const auto item_count : { 0, 1, 15, 16, 17, 100, 1000 }) {
+            test_parallel_read<test_parallel_options<test_thread_pool_executor>>(item_count);
+        }
+    }
+
+    TEST(parallel_read, ok_out_of_order) {
+        test_parallel_read<test_parallel_options<test_reverse_executor>>(100);
+    }
+
+    TEST(parallel_read, ok_trusted_input) {
+        test_parallel_read<test_parallel_trusted_options>(100);
+    }
+
+    TEST(parallel_read, ok_element_index) {
+        test_parallel_read<test_parallel_options<test_reverse_executor>, test_index_options>(100);
+    }
+
+    TEST(parallel_read, ok_read_into) {
+        const auto input = make_test_catalog(100);
+
+        auto write_result = blopp::write(input);
+        ASSERT_TRUE(write_result);
+
+        auto output = make_test_catalog(30);
+        auto read_result = blopp::read_into<test_parallel_options<test_thread_pool_executor>>(*write_result, output);
+        ASSERT_TRUE(read_result);
+        EXPECT_TRUE(read_result->empty());
+
+        expect_equal_catalogs(output, input);
+        expect_shared_values(output);
+    }
+
+    TEST(parallel_read, ok_references_in_nested_maps) {
+        auto shared_value = std::make_shared<int32_t>(123);
+
+        auto input = std::vector<std::map<int32_t, std::shared_ptr<int32_t>>>(size_t{ 4 });
+        input.at(0).emplace(1, shared_value);
+        input.at(1).emplace(2, std::make_shared<int32_t>(456));
+        input.at(3).emplace(3, shared_value);
+        input.at(3).emplace(4, nullptr);
+
+        auto write_result = blopp::write(input);
+        ASSERT_TRUE(write_result);
+
+        auto read_result = blopp::read<test_single_element_chunk_options, std::vector<std::map<int32_t, std::shared_ptr<int32_t>>>>(*write_result);
+        ASSERT_TRUE(read_result);
+
+        auto& output = read_result->value;
+        ASSERT_EQ(output.size(), size_t{ 4 });
+        ASSERT_NE(output.at(0).at(1), nullptr);
+        EXPECT_EQ(*output.at(0).at(1), int32_t{ 123 });
+        EXPECT_EQ(*output.at(1).at(2), int32_t{ 456 });
+        EXPECT_EQ(output.at(3).at(3), output.at(0).at(1));
+        EXPECT_EQ(output.at(3).at(4), nullptr);
+
+        // Maps of existing values reuse their nodes.
+        auto read_into_result = blopp::read_into<test_single_element_chunk_options>(*write_result, output);
+        ASSERT_TRUE(read_into_result);
+        EXPECT_EQ(output.at(3).at(3), output.at(0).at(1));
+        EXPECT_EQ(*output.at(3).at(3), int32_t{ 123 });
+    }
+
+    TEST(parallel_read, ok_references_in_nested_map_keys) {
+        using map_t = std::map<std::shared_ptr<int32_t>, test_struct_counted>;
+
+        auto shared_values = std::vector<std::shared_ptr<int32_t>>{};
+        for (int32_t i = 0; i < 4; ++i) {
+            shared_values.push_back(std::make_shared<int32_t>(i));
+        }
+
+        // Keys referencing values of earlier elements, ordered among keys defined by the element itself.
+        auto input = std::vector<map_t>(size_t{ 4 });
+        input.at(0).emplace(shared_values.at(0), test_struct_counted{ 1 });
+        input.at(0).emplace(shared_values.at(1), test_struct_counted{ 2 });
+        input.at(3).emplace(shared_values.at(2), test_struct_counted{ 3 });
+        input.at(3).emplace(shared_values.at(0), test_struct_counted{ 4 });
+        input.at(3).emplace(shared_values.at(3), test_struct_counted{ 5 });
+        input.at(3).emplace(shared_values.at(1), test_struct_counted{ 6 });
+
+        auto write_result = blopp::write(input);
+        ASSERT_TRUE(write_result);
+
+        auto expect_output_eq_input = [&](const std::vector<map_t>& output) {
+            ASSERT_EQ(output.size(), size_t{ 4 });
+            ASSERT_EQ(output.at(0).size(), size_t{ 2 });
+            ASSERT_EQ(output.at(3).size(), size_t{ 4 });
+
+            auto output_0 = std::map<int32_t, std::shared_ptr<int32_t>>{};
+            for (const auto& [key, mapped_value] : output.at(0)) {
+                output_0.emplace(mapped_value.value, key);
+            }
+
+            auto output_3 = std::map<int32_t, std::shared_ptr<int32_t>>{};
+            for (const auto& [key, mapped_value] : output.at(3)) {
+                ASSERT_NE(key, nullptr);
+                output_3.emplace(mapped_value.value, key);
+            }
+
+            EXPECT_EQ(*output_3.at(3), int32_t{ 2 });
+            EXPECT_EQ(output_3.at(4), output_0.at(1));
+            EXPECT_EQ(*output_3.at(5), int32_t{ 3 });
+            EXPECT_EQ(output_3.at(6), output_0.at(2));
+        };
+
+        // Elements are read once, with their references assigned after all chunks are read.
+        test_struct_counted::map_count = 0;
+        auto read_result = blopp::read<test_single_element_chunk_options, std::vector<map_t>>(*write_result);
+        ASSERT_TRUE(read_result);
+        EXPECT_EQ(test_struct_counted::map_count, size_t{ 6 });
+        expect_output_eq_input(read_result->value);
+
+        // Maps of existing values reuse their nodes.
+        auto& output = read_result->value;
+        test_struct_counted::map_count = 0;
+        auto read_into_result = blopp::read_into<test_single_element_chunk_options>(*write_result, output);
+        ASSERT_TRUE(read_into_result);
+        EXPECT_EQ(test_struct_counted::map_count, size_t{ 6 });
+        expect_output_eq_input(output);
+
+        auto thread_pool_read_result = blopp::read<test_parallel_options<test_thread_pool_executor>, std::vector<map_t>>(*write_result);
+        ASSERT_TRUE(thread_pool_read_result);
+    }
+
+    TEST(parallel_read, ok_references_in_nested_multimap_keys) {
+        using multimap_t = std::multimap<std::shared_ptr<int32_t>, int32_t>;
+
+        auto shared_value = std::make_shared<int32_t>(123);
+        auto other_value = std::make_shared<int32_t>(456);
+
+        auto input = std::vector<multimap_t>(size_t{ 4 });
+        input.at(0).emplace(shared_value, 1);
+        input.at(3).emplace(other_value, 2);
+        input.at(3).emplace(shared_value, 3);
+        input.at(3).emplace(shared_value, 4);
+        input.at(3).emplace(other_value, 5);
+
+        auto write_result = blopp::write(input);
+        ASSERT_TRUE(write_result);
+
+        auto read_result = blopp::read<test_single_element_chunk_options, std::vector<multimap_t>>(*write_result);
+        ASSERT_TRUE(read_result);
+
+        // Values of equal keys keep their order.
+        auto& output = read_result->value;
+        ASSERT_EQ(output.at(3).size(), size_t{ 4 });
+
+        const auto shared_key = output.at(0).begin()->first;
+        const auto [shared_begin, shared_end] = output.at(3).equal_range(shared_key);
+        EXPECT_EQ((std::vector<int32_t>{ shared_begin->second, std::next(shared_begin)->second }), (std::vector<int32_t>{ 3, 4 }));
+        EXPECT_EQ(std::distance(shared_begin, shared_end), 2);
+
+        const auto other_key = shared_begin == output.at(3).begin() ? std::prev(output.at(3).end())->first : output.at(3).begin()->first;
+        EXPECT_EQ(*other_key, int32_t{ 456 });
+        const auto [other_begin, other_end] = output.at(3).equal_range(other_key);
+        EXPECT_EQ((std::vector<int32_t>{ other_begin->second, std::next(other_begin)->second }), (std::vector<int32_t>{ 2, 5 }));
+    }
+
+    TEST(parallel_read, fail_insufficient_data) {
+        const auto input = make_test_catalog(100);
+
+        auto write_result = blopp::write(input);
+        ASSERT_TRUE(write_result);
+
+        for (const auto size : { size_t{ 100 }, write_result->size() / 2, write_result->size() - 1 }) {
+            const auto data = std::span{ write_result->data(), size };
+            auto serial_read_result = blopp::read<test_struct_catalog>(data);
+            auto read_result = blopp::read<test_parallel_options<test_reverse_executor>, test_struct_catalog>(data);
+            ASSERT_FALSE(serial_read_result);
+            ASSERT_FALSE(read_result);
+        }
+    }
+
+    TEST(parallel_read, fail_bad_element_offset) {
+        const auto input = make_test_catalog(100).items;
+
+        auto write_result = blopp::write<test_index_options>(input);
+        ASSERT_TRUE(write_result);
+
+        // The element index ends the list, and the offset of element 8 starts the second chunk.
+        write_result->at(write_result->size() - (100 - 8) * sizeof(uint64_t)) += 1;
+
+        auto read_result = blopp::read<test_parallel_options<test_reverse_executor>, std::vector<test_struct_item>>(*write_result);
+        ASSERT_FALSE(read_result);
+        EXPECT_EQ(read_result.error(), blopp::read_error_code::bad_list_element_index);
+    }
+}
@@ -0,0 +1,202 @@
+#include "blopp_test.hpp"
+#include <atomic>
+#include <sstream>
+
+namespace {
+    struct test_struct_item {
+        int32_t id = 0;
+        std::string name = {};
+        std::shared_ptr<std::string> tag = {};
+        std::vector<int32_t> values = {};
+    };
+
+    struct test_struct_catalog {
+        std::shared_ptr<std::string> default_tag = {};
+        std::vector<test_struct_item> items = {};
+        std::map<int32_t, test_struct_item> items_by_id = {};
+        std::list<std::shared_ptr<std::string>> tags = {};
+    };
+
+    struct test_struct_failing_item {
+        int32_t id = 0;
+    };
+
+    struct test_parallel_options : blopp::default_options {
+        static constexpr size_t parallel_write_chunk_size = 8;
+    };
+
+    // Runs tasks in reverse order on the calling thread, to write chunks out of order.
+    struct test_reverse_executor {
+        static inline std::atomic<size_t> run_count = 0;
+
+        static void run(const size_t task_count, const std::function<void(size_t)>& task) {
+            ++run_count;
+            for (size_t i = task_count; i > 0; --i) {
+                task(i - 1);
+            }
+        }
+    };
+
+    struct test_reverse_executor_options : test_parallel_options {
+        using write_executor = test_reverse_executor;
+    };
+
+    // Runs tasks on threads of its own, regardless of the hardware thread count.
+    struct test_thread_pool_executor {
+        static void run(const size_t task_count, const std::function<void(size_t)>& task) {
+            static auto thread_pool = blopp::thread_pool_executor{ 3 };
+            thread_pool.run_tasks(task_count, task);
+        }
+    };
+
+    struct test_thread_pool_executor_options : test_parallel_options {
+        using write_executor = test_thread_pool_executor;
+    };
+
+    auto make_test_catalog(const int32_t item_count) -> test_struct_catalog {
+        auto catalog = test_struct_catalog{};
+        catalog.default_tag = std::make_shared<std::string>("default");
+
+        // Tags are shared by items of different chunks, and by items and the default tag written before them.
+        auto tags = std::vector<std::shared_ptr<std::string>>{};
+        for (int32_t i = 0; i < 5; ++i) {
+            tags.push_back(std::make_shared<std::string>("tag_" + std::to_string(i)));
+        }
+
+        for (int32_t i = 0; i < item_count; ++i) {
+            auto item = test_struct_item{
+                .id = i,
+                .name = "item_" + std::to_string(i),
+                .tag = i % 7 == 0 ? catalog.default_tag : i % 3 == 0 ? nullptr : tags[static_cast<size_t>(i) % tags.size()],
+                .values = std::vector<int32_t>(static_cast<size_t>(i % 4), i)
+            };
+            catalog.items_by_id.emplace(i, item);
+            catalog.items.push_back(std::move(item));
+        }
+
+        // Tags only referenced within the same chunk.
+        for (int32_t i = 0; i < item_count; ++i) {
+            auto tag = std::make_shared<std::string>("list_tag_" + std::to_string(i / 2));
+            catalog.tags.push_back(tag);
+            if (i % 2 == 0) {
+                catalog.tags.push_back(tag);
+                ++i;
+            }
+        }
+
+        return catalog;
+    }
+}
+
+template<>
+struct blopp::object<test_struct_item> {
+    static auto map(auto& context, auto& value) {
+        context.map(value.id, value.name, value.tag, value.values);
+    }
+};
+
+template<>
+struct blopp::object<test_struct_failing_item> {
+    static auto map(auto& context, auto& value) -> bool {
+        return context.map(value.id) && value.id != 90;
+    }
+};
+
+template<>
+struct blopp::object<test_struct_catalog> {
+    static auto map(auto& context, auto& value) {
+        context.map(value.default_tag, value.items, value.items_by_id, value.tags);
+    }
+};
+
+namespace {
+    TEST(parallel_write, ok_equals_serial_write) {
+        for (const auto item_count : { 0, 1, 15, 16, 17, 100, 1000 }) {
+            const auto input = make_test_catalog(item_count);
+
+            auto serial_result = blopp::write(input);
+            ASSERT_TRUE(serial_result);
+
+            auto parallel_result = blopp::write<test_parallel_options>(input);
+            ASSERT_TRUE(parallel_result);
+
+            EXPECT_EQ(*parallel_result, *serial_result) << "item count: " << item_count;
+        }
+    }
+
+    TEST(parallel_write, ok_equals_serial_write_out_of_order) {
+        const auto input = make_test_catalog(100);
+
+        auto serial_result = blopp::write(input);
+        ASSERT_TRUE(serial_result);
+
+        const auto run_count = test_reverse_executor::run_count.load();
+        auto parallel_result = blopp::write<test_reverse_executor_options>(input);
+        ASSERT_TRUE(parallel_result);
+        EXPECT_GT(test_reverse_executor::run_count.load(), run_count);
+
+        EXPECT_EQ(*parallel_result, *serial_result);
+    }
+
+    TEST(parallel_write, ok_equals_serial_write_thread_pool) {
+        const auto input = make_test_catalog(1000);
+
+        auto serial_result = blopp::write(input);
+        ASSERT_TRUE(serial_result);
+
+        for (size_t i = 0; i < 10; ++i) {
+            auto parallel_result = blopp::write<test_thread_pool_executor_options>(input);
+            ASSERT_TRUE(parallel_result);
+            EXPECT_EQ(*parallel_result, *serial_result);
+        }
+    }
+
+    TEST(parallel_write, ok_read_shared_references) {
+        const auto input = make_test_catalog(100);
+
+        auto write_result = blopp::write<test_parallel_options>(input);
+        ASSERT_TRUE(write_result);
+
+        auto read_result = blopp::read<test_struct_catalog>(*write_result);
+        ASSERT_TRUE(read_result);
+
+        const auto& output = read_result->value;
+        ASSERT_EQ(output.items.size(), size_t{ 100 });
+        EXPECT_EQ(output.items[0].tag, output.default_tag);
+        EXPECT_EQ(output.items[70].tag, output.default_tag);
+        EXPECT_EQ(output.items[1].tag, output.items[76].tag);
+        ASSERT_NE(output.items[1].tag, nullptr);
+        EXPECT_EQ(*output.items[1].tag, "tag_1");
+        EXPECT_EQ(output.items[3].tag, nullptr);
+        EXPECT_EQ(output.items_by_id.at(71).tag, output.items[1].tag);
+
+        ASSERT_EQ(output.tags.size(), size_t{ 100 });
+        EXPECT_EQ(output.tags.front(), *std::next(output.tags.begin()));
+        EXPECT_EQ(*output.tags.back(), "list_tag_49");
+    }
+
+    TEST(parallel_write, ok_write_to_stream) {
+        const auto input = make_test_catalog(100);
+
+        auto serial_result = blopp::write(input);
+        ASSERT_TRUE(serial_result);
+
+        auto stream = std::stringstream{};
+        auto stream_result = blopp::write<test_parallel_options>(input, stream);
+        ASSERT_TRUE(stream_result);
+
+        const auto stream_data = stream.str();
+        EXPECT_EQ(blopp::write_output_type(stream_data.begin(), stream_data.end()), *serial_result);
+    }
+
+    TEST(parallel_write, fail_chunk_error) {
+        auto input = std::vector<test_struct_failing_item>(100);
+        for (size_t i = 0; i < input.size(); ++i) {
+            input[i].id = static_cast<int32_t>(i);
+        }
+
+        auto write_result = blopp::write<test_parallel_options>(input);
+        ASSERT_FALSE(write_result);
+        EXPECT_EQ(write_result.error(), blopp::write_error_code::user_defined_failure);
+    }
+}
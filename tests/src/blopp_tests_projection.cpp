@@ -0,0 +1,244 @@
+#include "blopp_test.hpp"
+
+namespace {
+    struct strict_options : blopp::default_binary_format_types {
+        static constexpr auto allow_object_excess_bytes = false;
+        static constexpr auto allow_more_object_members = false;
+    };
+
+    struct test_struct_product {
+        uint32_t id;
+        std::string name;
+        std::vector<int32_t> values;
+        std::map<int32_t, std::string> tags;
+        double price;
+        std::u16string description;
+    };
+
+    struct test_struct_product_price {
+        uint32_t id;
+        double price;
+    };
+
+    struct test_struct_product_skip_all {
+        uint32_t id;
+    };
+
+    struct test_struct_product_skip_too_many {
+        uint32_t id;
+        double price;
+    };
+
+    struct test_struct_shared_tags {
+        std::shared_ptr<std::string> default_tag;
+        std::vector<std::shared_ptr<std::string>> tags;
+    };
+
+    struct test_struct_shared_tags_skip_default {
+        std::vector<std::shared_ptr<std::string>> tags;
+    };
+
+    // Reads elements in reverse order, so references of later chunks are resolved before the skipped value is read.
+    struct test_reverse_executor {
+        static void run(const size_t task_count, const std::function<void(size_t)>& task) {
+            for (size_t i = task_count; i > 0; --i) {
+                task(i - 1);
+            }
+        }
+    };
+
+    struct test_parallel_options : blopp::default_options {
+        static constexpr size_t parallel_read_chunk_size = 1;
+        using read_executor = test_reverse_executor;
+    };
+}
+
+template<>
+struct blopp::object<test_struct_product> {
+    static auto map(auto& context, auto& value) {
+        context.map(
+            value.id,
+            value.name,
+            value.values,
+            value.tags,
+            value.price,
+            value.description);
+    }
+};
+
+template<>
+struct blopp::object<test_struct_product_price> {
+    static auto map(auto& context, auto& value) {
+        context.map(value.id);
+        context.skip(3);
+        context.map(value.price);
+    }
+};
+
+template<>
+struct blopp::object<test_struct_product_skip_all> {
+    static auto map(auto& context, auto& value) {
+        context.map(value.id);
+        context.skip(5);
+    }
+};
+
+template<>
+struct blopp::object<test_struct_shared_tags> {
+    static auto map(auto& context, auto& value) {
+        context.map(
+            value.default_tag,
+            value.tags);
+    }
+};
+
+template<>
+struct blopp::object<test_struct_shared_tags_skip_default> {
+    static auto map(auto& context, auto& value) {
+        context.skip();
+        context.map(value.tags);
+    }
+};
+
+template<>
+struct blopp::object<test_struct_product_skip_too_many> {
+    static auto map(auto& context, auto& value) {
+        context.map(value.id);
+        context.skip(5);
+        context.map(value.price);
+    }
+};
+
+namespace {
+    const auto test_product = test_struct_product{
+        .id = 123,
+        .name = "Apple",
+        .values = std::vector<int32_t>(size_t{ 1000 }, int32_t{ 456 }),
+        .tags = { { 1, "one" }, { 2, "two" } },
+        .price = 12.5,
+        .description = u"Red and round"
+    };
+
+    TEST(projection, ok_skip_properties) {
+        auto write_result = blopp::write(test_product);
+        ASSERT_TRUE(write_result);
+
+        auto read_result = blopp::read<test_struct_product_price>(*write_result);
+        ASSERT_TRUE(read_result);
+        EXPECT_TRUE(read_result->remaining.empty());
+
+        auto& output = read_result->value;
+        EXPECT_EQ(output.id, uint32_t{ 123 });
+        EXPECT_EQ(output.price, 12.5);
+    }
+
+    TEST(projection, ok_skip_properties_strict_options) {
+        auto write_result = blopp::write<strict_options>(test_product);
+        ASSERT_TRUE(write_result);
+
+        auto read_result = blopp::read<strict_options, test_struct_product_skip_all>(*write_result);
+        ASSERT_TRUE(read_result);
+        EXPECT_EQ(read_result->value.id, uint32_t{ 123 });
+    }
+
+    TEST(projection, ok_list_of_projections) {
+        const auto input = std::vector<test_struct_product>(size_t{ 10 }, test_product);
+
+        auto write_result = blopp::write<blopp::compact_default_options>(input);
+        ASSERT_TRUE(write_result);
+
+        auto read_result = blopp::read<blopp::compact_default_options, std::vector<test_struct_product_price>>(*write_result);
+        ASSERT_TRUE(read_result);
+        ASSERT_EQ(read_result->value.size(), size_t{ 10 });
+
+        for (const auto& output : read_result->value) {
+            EXPECT_EQ(output.id, uint32_t{ 123 });
+            EXPECT_EQ(output.price, 12.5);
+        }
+    }
+
+    TEST(projection, ok_skipped_properties_are_not_decoded) {
+        auto write_result = blopp::write(test_product);
+        ASSERT_TRUE(write_result);
+
+        // Corrupt the character size of the skipped name.
+        auto& output = *write_result;
+        const auto name_char_size_position = size_t{ 1 + 8 + 2 + 1 + 4 + 1 + 8 };
+        ASSERT_EQ(output.at(name_char_size_position), uint8_t{ 1 });
+        output.at(name_char_size_position) = uint8_t{ 2 };
+
+        auto read_full_result = blopp::read<test_struct_product>(output);
+        ASSERT_FALSE(read_full_result);
+        EXPECT_EQ(read_full_result.error(), blopp::read_error_code::mismatching_string_char_size);
+
+        auto read_result = blopp::read<test_struct_product_price>(output);
+        ASSERT_TRUE(read_result);
+        EXPECT_EQ(read_result->value.price, 12.5);
+    }
+
+    TEST(projection, ok_skip_shared_ptr_referenced_later) {
+        auto default_tag = std::make_shared<std::string>("default");
+        const auto input = test_struct_shared_tags{
+            .default_tag = default_tag,
+            .tags = { default_tag, std::make_shared<std::string>("other"), default_tag }
+        };
+
+        auto write_result = blopp::write(input);
+        ASSERT_TRUE(write_result);
+
+        auto read_result = blopp::read<test_struct_shared_tags_skip_default>(*write_result);
+        ASSERT_TRUE(read_result);
+
+        auto& tags = read_result->value.tags;
+        ASSERT_EQ(tags.size(), size_t{ 3 });
+        ASSERT_NE(tags.at(0), nullptr);
+        EXPECT_STREQ(tags.at(0)->c_str(), "default");
+        EXPECT_STREQ(tags.at(1)->c_str(), "other");
+        EXPECT_EQ(tags.at(0), tags.at(2));
+    }
+
+    TEST(projection, ok_skip_shared_ptr_referenced_later_parallel) {
+        auto default_tag = std::make_shared<std::string>("default");
+        const auto input = test_struct_shared_tags{
+            .default_tag = default_tag,
+            .tags = { default_tag, std::make_shared<std::string>("other"), default_tag }
+        };
+
+        auto write_result = blopp::write<test_parallel_options>(input);
+        ASSERT_TRUE(write_result);
+
+        auto read_result = blopp::read<test_parallel_options, test_struct_shared_tags_skip_default>(*write_result);
+        ASSERT_TRUE(read_result);
+
+        auto& tags = read_result->value.tags;
+        ASSERT_EQ(tags.size(), size_t{ 3 });
+        ASSERT_NE(tags.at(0), nullptr);
+        EXPECT_STREQ(tags.at(0)->c_str(), "default");
+        EXPECT_EQ(tags.at(0), tags.at(2));
+    }
+
+    TEST(projection, fail_skip_too_many_properties) {
+        auto write_result = blopp::write(test_product);
+        ASSERT_TRUE(write_result);
+
+        auto read_result = blopp::read<test_struct_product_skip_too_many>(*write_result);
+        ASSERT_FALSE(read_result);
+        EXPECT_EQ(read_result.error(), blopp::read_error_code::mismatching_object_property_count);
+    }
+
+    TEST(projection, fail_insufficient_data) {
+        auto write_result = blopp::write(test_product);
+        ASSERT_TRUE(write_result);
+
+        // Cut object offset short, so skipped values exceed the object.
+        auto& output = *write_result;
+        auto object_offset = uint64_t{};
+        std::memcpy(&object_offset, output.data() + 1, sizeof(object_offset));
+        object_offset -= 60;
+        std::memcpy(output.data() + 1, &object_offset, sizeof(object_offset));
+
+        auto read_result = blopp::read<test_struct_product_price>(output);
+        ASSERT_FALSE(read_result);
+        EXPECT_EQ(read_result.error(), blopp::read_error_code::insufficient_data);
+    }
+}
@@ -0,0 +1,137 @@
+#include "blopp_test.hpp"
+#include "blopp_test_store.hpp"
+
+namespace {
+    using blopp_test::test_struct_store;
+    using blopp_test::create_store;
+    using blopp_test::expect_store_eq;
+
+    TEST(read_into, ok_read_into) {
+        const auto input = create_store(5, 1);
+
+        auto write_result = blopp::write(input);
+        ASSERT_TRUE(write_result);
+
+        auto output = test_struct_store{};
+        auto read_result = blopp::read_into(*write_result, output);
+        ASSERT_TRUE(read_result);
+        EXPECT_TRUE(read_result->empty());
+
+        expect_store_eq(output, input);
+    }
+
+    TEST(read_into, ok_reuse_allocations) {
+        const auto input_1 = create_store(5, 1);
+        const auto input_2 = create_store(5, 2);
+
+        auto write_result_1 = blopp::write(input_1);
+        ASSERT_TRUE(write_result_1);
+        auto write_result_2 = blopp::write(input_2);
+        ASSERT_TRUE(write_result_2);
+
+        auto output = test_struct_store{};
+        ASSERT_TRUE(blopp::read_into(*write_result_1, output));
+        expect_store_eq(output, input_1);
+
+        const auto* products_data = output.products.data();
+        const auto* product_values_data = output.products.at(4).values.data();
+        const auto* product_tag = &output.products.at(4).tags.at(1);
+        const auto* description = output.description.get();
+        const auto* category = &output.categories.back();
+        const auto* stock = &output.stock.at("apple");
+
+        ASSERT_TRUE(blopp::read_into(*write_result_2, output));
+        expect_store_eq(output, input_2);
+
+        EXPECT_EQ(output.products.data(), products_data);
+        EXPECT_EQ(output.products.at(4).values.data(), product_values_data);
+        EXPECT_EQ(&output.products.at(4).tags.at(1), product_tag);
+        EXPECT_EQ(output.description.get(), description);
+        EXPECT_EQ(&output.categories.back(), category);
+        EXPECT_EQ(&output.stock.at("apple"), stock);
+    }
+
+    TEST(read_into, ok_different_shape) {
+        const auto input_1 = create_store(10, 1);
+        auto input_2 = create_store(3, 2);
+        input_2.products.at(0).price.reset();
+        input_2.products.at(0).variant = int32_t{ 123 };
+        input_2.categories.clear();
+        input_2.stock = { { "date", 3 }, { "elderberry", 4 }, { "fig", 5 }, { "grape", 6 } };
+        input_2.description.reset();
+
+        auto write_result_1 = blopp::write(input_1);
+        ASSERT_TRUE(write_result_1);
+        auto write_result_2 = blopp::write(input_2);
+        ASSERT_TRUE(write_result_2);
+
+        auto output = test_struct_store{};
+        ASSERT_TRUE(blopp::read_into(*write_result_1, output));
+        expect_store_eq(output, input_1);
+
+        ASSERT_TRUE(blopp::read_into(*write_result_2, output));
+        expect_store_eq(output, input_2);
+
+        ASSERT_TRUE(blopp::read_into(*write_result_1, output));
+        expect_store_eq(output, input_1);
+    }
+
+    TEST(read_into, ok_multimap) {
+        const auto input_1 = std::multimap<int32_t, std::string>{ { 1, "one" }, { 1, "one again" }, { 2, "two" } };
+        const auto input_2 = std::multimap<int32_t, std::string>{ { 3, "three" }, { 3, "three again" } };
+
+        auto write_result_1 = blopp::write(input_1);
+        ASSERT_TRUE(write_result_1);
+        auto write_result_2 = blopp::write(input_2);
+        ASSERT_TRUE(write_result_2);
+
+        auto output = std::multimap<int32_t, std::string>{};
+        ASSERT_TRUE(blopp::read_into(*write_result_1, output));
+        EXPECT_EQ(output, input_1);
+
+        ASSERT_TRUE(blopp::read_into(*write_result_2, output));
+        EXPECT_EQ(output, input_2);
+    }
+
+    TEST(read_into, ok_duplicate_keys_keep_first_value) {
+        const auto input = std::multimap<int32_t, std::string>{
+            { 1, "First" },
+            { 1, "Second" },
+            { 2, "Third" }
+        };
+
+        auto write_result = blopp::write(input);
+        ASSERT_TRUE(write_result);
+
+        auto output = std::map<int32_t, std::string>{ { 5, "Old" }, { 6, "Old" }, { 7, "Old" } };
+        auto read_result = blopp::read_into(*write_result, output);
+        ASSERT_TRUE(read_result);
+
+        ASSERT_EQ(output.size(), size_t{ 2 });
+        EXPECT_EQ(output.at(1), "First");
+        EXPECT_EQ(output.at(2), "Third");
+    }
+
+    TEST(read_into, ok_remaining) {
+        auto write_result = blopp::write(std::string{ "Hello world" });
+        ASSERT_TRUE(write_result);
+        write_result->push_back(uint8_t{ 123 });
+
+        auto output = std::string{};
+        auto read_result = blopp::read_into(*write_result, output);
+        ASSERT_TRUE(read_result);
+        EXPECT_EQ(output, "Hello world");
+        ASSERT_EQ(read_result->size(), size_t{ 1 });
+        EXPECT_EQ(read_result->front(), uint8_t{ 123 });
+    }
+
+    TEST(read_into, fail_insufficient_data) {
+        auto write_result = blopp::write(create_store(5, 1));
+        ASSERT_TRUE(write_result);
+
+        auto output = test_struct_store{};
+        auto read_result = blopp::read_into(std::span{ *write_result }.first(write_result->size() - 1), output);
+        ASSERT_FALSE(read_result);
+        EXPECT_EQ(read_result.error(), blopp::read_error_code::insufficient_data);
+    }
+}
@@ -0,0 +1,191 @@
+#include "blopp_test.hpp"
+
+namespace {
+    struct test_struct_node {
+        int32_t value = 0;
+        std::vector<std::shared_ptr<test_struct_node>> children = {};
+    };
+}
+
+template<>
+struct blopp::object<test_struct_node> {
+    static auto map(auto& context, auto& value) {
+        context.map(
+            value.value,
+            value.children);
+    }
+};
+
+namespace {
+    template<blopp::reference_policy Vpolicy>
+    struct test_policy_options : blopp::default_options {
+        static constexpr auto reference_policy = Vpolicy;
+    };
+
+    struct test_parallel_none_options : test_policy_options<blopp::reference_policy::none> {
+        static constexpr size_t parallel_write_chunk_size = 1;
+    };
+
+    static_assert(blopp::impl::options_reference_policy_v<blopp::default_options> == blopp::reference_policy::ordered_map);
+    static_assert(blopp::impl::options_reference_policy_v<test_policy_options<blopp::reference_policy::hash_map>> == 
+        blopp::reference_policy::hash_map);
+
+    // Layers of nodes, where every node of a layer is a child of every node of the layer above.
+    std::shared_ptr<test_struct_node> create_dag(const size_t layer_count, const size_t layer_size) {
+        auto root = std::make_shared<test_struct_node>();
+        auto parents = std::vector<std::shared_ptr<test_struct_node>>{ root };
+        auto value = int32_t{ 1 };
+
+        for (size_t layer = 0; layer < layer_count; layer++) {
+            auto children = std::vector<std::shared_ptr<test_struct_node>>{};
+            for (size_t i = 0; i < layer_size; i++) {
+                auto child = std::make_shared<test_struct_node>();
+                child->value = value++;
+                children.push_back(child);
+            }
+
+            for (auto& parent : parents) {
+                parent->children = children;
+            }
+
+            parents = std::move(children);
+        }
+
+        return root;
+    }
+
+    template<blopp::reference_policy Vpolicy>
+    void test_read_write_dag() {
+        using options = test_policy_options<Vpolicy>;
+
+        const auto input = create_dag(4, 8);
+
+        auto write_result = blopp::write<options>(input);
+        ASSERT_TRUE(write_result);
+
+        // Equal output for all policies tracking references.
+        auto write_default_result = blopp::write(input);
+        ASSERT_TRUE(write_default_result);
+        EXPECT_EQ(*write_result, *write_default_result);
+
+        auto read_result = blopp::read<options, std::shared_ptr<test_struct_node>>(*write_result);
+        ASSERT_TRUE(read_result);
+
+        auto& output = read_result->value;
+        ASSERT_TRUE(output);
+        ASSERT_EQ(output->children.size(), size_t{ 8 });
+
+        const auto& layer_1 = output->children;
+        for (size_t i = 0; i < layer_1.size(); i++) {
+            EXPECT_EQ(layer_1.at(i)->value, static_cast<int32_t>(i + 1));
+            EXPECT_EQ(layer_1.at(i)->children, layer_1.front()->children);
+        }
+        EXPECT_EQ(layer_1.front()->children.front()->value, int32_t{ 9 });
+    }
+
+    TEST(reference_policy, ok_ordered_map) {
+        test_read_write_dag<blopp::reference_policy::ordered_map>();
+    }
+
+    TEST(reference_policy, ok_hash_map) {
+        test_read_write_dag<blopp::reference_policy::hash_map>();
+    }
+
+    TEST(reference_policy, ok_flat_vector) {
+        test_read_write_dag<blopp::reference_policy::flat_vector>();
+    }
+
+    TEST(reference_policy, ok_none) {
+        using options = test_policy_options<blopp::reference_policy::none>;
+
+        const auto input = create_dag(2, 3);
+
+        auto write_result = blopp::write<options>(input);
+        ASSERT_TRUE(write_result);
+
+        auto read_result = blopp::read<options, std::shared_ptr<test_struct_node>>(*write_result);
+        ASSERT_TRUE(read_result);
+
+        auto& output = read_result->value;
+        ASSERT_EQ(output->children.size(), size_t{ 3 });
+        EXPECT_NE(output->children.at(0)->children, output->children.at(1)->children);
+        EXPECT_EQ(output->children.at(0)->children.at(2)->value, output->children.at(1)->children.at(2)->value);
+    }
+
+    TEST(reference_policy, fail_none_cycle) {
+        auto input = std::make_shared<test_struct_node>();
+        input->children.push_back(std::make_shared<test_struct_node>());
+        input->children.front()->children.push_back(input);
+
+        // Cycles would be written endlessly without references.
+        auto write_result = blopp::write<test_policy_options<blopp::reference_policy::none>>(input);
+        ASSERT_FALSE(write_result);
+        EXPECT_EQ(write_result.error(), blopp::write_error_code::cyclic_shared_ptr);
+
+        // Also when the cycle passes through a chunk of a parallel write.
+        for (int32_t i = 0; i < 4; ++i) {
+            input->children.push_back(std::make_shared<test_struct_node>(test_struct_node{ .value = i }));
+        }
+        input->children.back()->children.push_back(input);
+
+        auto parallel_write_result = blopp::write<test_parallel_none_options>(input);
+        ASSERT_FALSE(parallel_write_result);
+        EXPECT_EQ(parallel_write_result.error(), blopp::write_error_code::cyclic_shared_ptr);
+
+        // Values shared without a cycle are written once per pointer.
+        input->children.front()->children.clear();
+        input->children.back()->children.clear();
+        input->children.at(1)->children.push_back(input->children.at(2));
+        input->children.at(3)->children.push_back(input->children.at(2));
+        EXPECT_TRUE(blopp::write<test_parallel_none_options>(input));
+        EXPECT_TRUE(blopp::write<test_policy_options<blopp::reference_policy::none>>(input));
+
+        auto ordered_write_result = blopp::write(input);
+        EXPECT_TRUE(ordered_write_result);
+
+        input->children.clear();
+    }
+
+    TEST(reference_policy, fail_none_bad_reference_position) {
+        auto write_result = blopp::write(create_dag(2, 3));
+        ASSERT_TRUE(write_result);
+
+        auto read_result = blopp::read<
+            test_policy_options<blopp::reference_policy::none>, std::shared_ptr<test_struct_node>>(*write_result);
+        ASSERT_FALSE(read_result);
+        EXPECT_EQ(read_result.error(), blopp::read_error_code::bad_reference_position);
+    }
+
+    template<blopp::reference_policy Vpolicy>
+    void test_reference_table() {
+        auto table = blopp::impl::reference_table<uint64_t, Vpolicy>{};
+
+        for (uint64_t i = 0; i < 1000; i++) {
+            table.insert(i * 16, i);
+        }
+
+        // Inserted out of order and twice.
+        table.insert(uint64_t{ 8 }, uint64_t{ 2000 });
+        table.insert(uint64_t{ 16 }, uint64_t{ 3000 });
+
+        for (uint64_t i = 0; i < 1000; i++) {
+            const auto* value = table.find(i * 16);
+            ASSERT_NE(value, nullptr);
+            EXPECT_EQ(*value, i);
+            EXPECT_EQ(table.find(i * 16 + 1), nullptr);
+        }
+
+        ASSERT_NE(table.find(uint64_t{ 8 }), nullptr);
+        EXPECT_EQ(*table.find(uint64_t{ 8 }), uint64_t{ 2000 });
+    }
+
+    TEST(reference_policy, ok_reference_table) {
+        test_reference_table<blopp::reference_policy::ordered_map>();
+        test_reference_table<blopp::reference_policy::hash_map>();
+        test_reference_table<blopp::reference_policy::flat_vector>();
+
+        auto table = blopp::impl::reference_table<uint64_t, blopp::reference_policy::none>{};
+        table.insert(uint64_t{ 1 }, uint64_t{ 1 });
+        EXPECT_EQ(table.find(uint64_t{ 1 }), nullptr);
+    }
+}
@@ -0,0 +1,102 @@
+#include "blopp_test.hpp"
+#include "blopp_test_store.hpp"
+
+namespace {
+    using blopp_test::test_struct_store;
+    using blopp_test::create_store;
+
+    // Splits data into segments of segment_size bytes, with an empty segment in between each.
+    std::vector<blopp::read_input_type> create_segments(std::span<const uint8_t> data, const size_t segment_size) {
+        auto result = std::vector<blopp::read_input_type>{};
+        for (size_t position = 0; position < data.size(); position += segment_size) {
+            result.push_back(data.subspan(position, std::min(segment_size, data.size() - position)));
+            result.push_back(blopp::read_input_type{});
+        }
+        return result;
+    }
+
+    TEST(segmented_input, ok_segments) {
+        const auto input = create_store();
+
+        auto write_result = blopp::write(input);
+        ASSERT_TRUE(write_result);
+
+        for (const auto segment_size : { size_t{ 1 }, size_t{ 3 }, size_t{ 7 }, size_t{ 16384 } }) {
+            const auto segments = create_segments(*write_result, segment_size);
+
+            auto read_result = blopp::read<test_struct_store>(segments);
+            ASSERT_TRUE(read_result);
+            EXPECT_EQ(read_result->read_size, write_result->size());
+
+            blopp_test::expect_store_eq(read_result->value, input);
+        }
+    }
+
+    TEST(segmented_input, ok_read_size) {
+        auto write_result = blopp::write(std::string{ "Hello world" });
+        ASSERT_TRUE(write_result);
+
+        const auto trailing_data = std::array<uint8_t, 4>{ 1, 2, 3, 4 };
+        const auto segments = std::array<blopp::read_input_type, 3>{
+            std::span{ *write_result }.first(4),
+            std::span{ *write_result }.subspan(4),
+            trailing_data
+        };
+
+        auto read_result = blopp::read<std::string>(segments);
+        ASSERT_TRUE(read_result);
+        EXPECT_EQ(read_result->value, "Hello world");
+        EXPECT_EQ(read_result->read_size, write_result->size());
+    }
+
+    TEST(segmented_input, ok_view_within_segment) {
+        auto write_result = blopp::write(std::string_view{ "Hello world" });
+        ASSERT_TRUE(write_result);
+
+        const auto segments = std::array<blopp::read_input_type, 2>{
+            std::span{ *write_result }.first(10),
+            std::span{ *write_result }.subspan(10)
+        };
+
+        auto read_result = blopp::read<std::string_view>(segments);
+        ASSERT_TRUE(read_result);
+        EXPECT_EQ(read_result->value, "Hello world");
+    }
+
+    TEST(segmented_input, fail_fragmented_data) {
+        auto write_result = blopp::write(std::string_view{ "Hello world" });
+        ASSERT_TRUE(write_result);
+
+        const auto segments = create_segments(*write_result, size_t{ 12 });
+
+        auto read_result = blopp::read<std::string_view>(segments);
+        ASSERT_FALSE(read_result);
+        EXPECT_EQ(read_result.error(), blopp::read_error_code::fragmented_data);
+    }
+
+    TEST(segmented_input, fail_bad_boolean_value) {
+        const auto input = std::vector<uint8_t>{ 0, 1, 0, 1, 2 };
+
+        auto write_result = blopp::write(input);
+        ASSERT_TRUE(write_result);
+        write_result->at(1 + 8) = static_cast<uint8_t>(blopp::impl::data_types::boolean);
+
+        const auto segments = create_segments(*write_result, size_t{ 3 });
+
+        auto read_result = blopp::read<std::vector<bool>>(segments);
+        ASSERT_FALSE(read_result);
+        EXPECT_EQ(read_result.error(), blopp::read_error_code::bad_boolean_value);
+    }
+
+    TEST(segmented_input, fail_insufficient_data) {
+        auto write_result = blopp::write(create_store());
+        ASSERT_TRUE(write_result);
+
+        const auto data = std::span{ *write_result }.first(write_result->size() - 1);
+        const auto segments = create_segments(data, size_t{ 5 });
+
+        auto read_result = blopp::read<test_struct_store>(segments);
+        ASSERT_FALSE(read_result);
+        EXPECT_EQ(read_result.error(), blopp::read_error_code::insufficient_data);
+    }
+}
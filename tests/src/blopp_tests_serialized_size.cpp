@@ -0,0 +1,122 @@
+#include "blopp_test.hpp"
+#include "blopp_test_binary_format_types.hpp"
+
+namespace {
+    struct test_struct_vec3 {
+        float x, y, z;
+    };
+
+    struct test_struct_shared_ptrs {
+        std::shared_ptr<int32_t> value_1;
+        std::shared_ptr<int32_t> value_2;
+    };
+
+    struct test_struct_all {
+        int32_t value_1;
+        std::string value_2;
+        std::vector<test_struct_vec3> value_3;
+        std::map<int32_t, std::string> value_4;
+        std::optional<int32_t> value_5;
+        std::unique_ptr<int32_t> value_6;
+        std::variant<int32_t, std::string> value_7;
+        test_struct_shared_ptrs value_8;
+    };
+}
+
+template<>
+struct blopp::object<test_struct_vec3> {
+    static auto format(auto& context, auto& value) {
+        context.format(value.x, value.y, value.z);
+    }
+};
+
+template<>
+struct blopp::object<test_struct_shared_ptrs> {
+    static auto map(auto& context, auto& value) {
+        context.map(
+            value.value_1,
+            value.value_2);
+    }
+};
+
+template<>
+struct blopp::object<test_struct_all> {
+    static auto map(auto& context, auto& value) {
+        context.map(
+            value.value_1,
+            value.value_2,
+            value.value_3,
+            value.value_4,
+            value.value_5,
+            value.value_6,
+            value.value_7,
+            value.value_8);
+    }
+};
+
+namespace {
+    template<typename TOptions, typename T>
+    void expect_serialized_size_equals_write_size(const T& value) {
+        auto write_result = blopp::write<TOptions>(value);
+        ASSERT_TRUE(write_result);
+
+        auto size_result = blopp::serialized_size<TOptions>(value);
+        ASSERT_TRUE(size_result);
+
+        EXPECT_EQ(size_result.value(), write_result->size());
+    }
+
+    TEST(serialized_size, ok_fundamentals) {
+        auto size_result = blopp::serialized_size(int32_t{ 123 });
+        ASSERT_TRUE(size_result);
+        EXPECT_EQ(size_result.value(), size_t{ 5 });
+
+        expect_serialized_size_equals_write_size<blopp::default_options>(double{ 1.5 });
+        expect_serialized_size_equals_write_size<blopp::default_options>(bool{ true });
+    }
+
+    TEST(serialized_size, ok_string) {
+        auto size_result = blopp::serialized_size(std::string{ "Hello world" });
+        ASSERT_TRUE(size_result);
+        EXPECT_EQ(size_result.value(), size_t{ 1 + 8 + 1 + 11 });
+
+        expect_serialized_size_equals_write_size<blopp::compact_default_options>(std::u16string{ u"Hello world" });
+    }
+
+    TEST(serialized_size, ok_object) {
+        const auto shared_value = std::make_shared<int32_t>(123);
+
+        auto input = test_struct_all{
+            .value_1 = 1,
+            .value_2 = "test",
+            .value_3 = { { 1.0f, 2.0f, 3.0f }, { 4.0f, 5.0f, 6.0f } },
+            .value_4 = { { 1, "one" }, { 2, "two" } },
+            .value_5 = 5,
+            .value_6 = std::make_unique<int32_t>(6),
+            .value_7 = std::string{ "variant" },
+            .value_8 = {
+                .value_1 = shared_value,
+                .value_2 = shared_value
+            }
+        };
+
+        expect_serialized_size_equals_write_size<blopp::default_options>(input);
+        expect_serialized_size_equals_write_size<blopp::compact_default_options>(input);
+    }
+
+    TEST(serialized_size, ok_write_reserves_exact_size) {
+        const auto input = std::vector<std::string>(size_t{ 100 }, std::string(size_t{ 100 }, 'A'));
+
+        auto write_result = blopp::write(input);
+        ASSERT_TRUE(write_result);
+
+        EXPECT_EQ(write_result->capacity(), write_result->size());
+    }
+
+    TEST(serialized_size, fail_string_offset_overflow) {
+        auto input = std::string(size_t{ 255 }, 'A');
+        auto size_result = blopp::serialized_size<blopp_test::minimal_offset_options>(input);
+        ASSERT_FALSE(size_result);
+        EXPECT_EQ(size_result.error(), blopp::write_error_code::string_offset_overflow);
+    }
+}
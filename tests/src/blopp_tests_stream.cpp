@@ -0,0 +1,145 @@
+#include "blopp_test.hpp"
+#include "blopp_test_store.hpp"
+#include <sstream>
+
+namespace {
+    using blopp_test::test_struct_store;
+    using blopp_test::create_store;
+
+    // Stream buffer without seeking support, such as a pipe.
+    class test_unseekable_streambuf : public std::streambuf {
+
+    public:
+
+        std::vector<uint8_t> data = {};
+
+    protected:
+
+        int_type overflow(int_type value) override {
+            if (value != traits_type::eof()) {
+                data.push_back(static_cast<uint8_t>(value));
+            }
+            return value;
+        }
+
+        std::streamsize xsputn(const char* chars, std::streamsize count) override {
+            data.insert(data.end(), chars, chars + count);
+            return count;
+        }
+
+    };
+
+    // Input stream buffer without seeking support, such as a pipe.
+    class test_unseekable_input_streambuf : public std::streambuf {
+
+    public:
+
+        explicit test_unseekable_input_streambuf(std::vector<uint8_t> input) :
+            data{ std::move(input) }
+        {
+            auto* begin = reinterpret_cast<char*>(data.data());
+            setg(begin, begin, begin + data.size());
+        }
+
+        std::vector<uint8_t> data = {};
+
+    };
+
+    std::vector<uint8_t> to_vector(const std::string& string) {
+        return std::vector<uint8_t>(string.begin(), string.end());
+    }
+
+    TEST(stream, ok_write_chunked) {
+        const auto input = create_store();
+
+        auto write_result = blopp::write(input);
+        ASSERT_TRUE(write_result);
+
+        for (const auto chunk_size : { size_t{ 1 }, size_t{ 7 }, size_t{ 64 }, size_t{ 1000 }, size_t{ 1000000 } }) {
+            auto stream = std::stringstream{};
+
+            auto write_stream_result = blopp::write(input, stream, chunk_size);
+            ASSERT_TRUE(write_stream_result);
+
+            EXPECT_EQ(to_vector(stream.str()), *write_result);
+        }
+    }
+
+    TEST(stream, ok_write_after_existing_data) {
+        const auto input = create_store();
+
+        auto write_result = blopp::write(input);
+        ASSERT_TRUE(write_result);
+
+        auto stream = std::stringstream{};
+        stream << "prefix";
+
+        auto write_stream_result = blopp::write(input, stream, size_t{ 16 });
+        ASSERT_TRUE(write_stream_result);
+
+        auto expected_output = to_vector("prefix");
+        expected_output.insert(expected_output.end(), write_result->begin(), write_result->end());
+        EXPECT_EQ(to_vector(stream.str()), expected_output);
+    }
+
+    TEST(stream, ok_write_unseekable) {
+        const auto input = create_store();
+
+        auto write_result = blopp::write(input);
+        ASSERT_TRUE(write_result);
+
+        auto streambuf = test_unseekable_streambuf{};
+        auto stream = std::ostream{ &streambuf };
+
+        auto write_stream_result = blopp::write(input, stream, size_t{ 16 });
+        ASSERT_TRUE(write_stream_result);
+
+        EXPECT_EQ(streambuf.data, *write_result);
+    }
+
+    TEST(stream, ok_read_unseekable) {
+        const auto input = create_store();
+
+        auto write_result = blopp::write(input);
+        ASSERT_TRUE(write_result);
+
+        auto streambuf = test_unseekable_input_streambuf{ *write_result };
+        auto stream = std::istream{ &streambuf };
+
+        auto read_result = blopp::read<test_struct_store>(stream);
+        ASSERT_TRUE(read_result);
+
+        blopp_test::expect_store_eq(read_result->value, input);
+    }
+
+    TEST(stream, ok_stream_output_sink) {
+        const auto input = create_store();
+
+        auto write_result = blopp::write(input);
+        ASSERT_TRUE(write_result);
+
+        auto stream = std::stringstream{};
+        auto output_sink = blopp::stream_output_sink{ stream, size_t{ 32 } };
+
+        auto write_sink_result = blopp::write(input, output_sink);
+        ASSERT_TRUE(write_sink_result);
+        output_sink.flush();
+        ASSERT_FALSE(output_sink.error());
+
+        EXPECT_EQ(output_sink.position(), write_result->size());
+        EXPECT_EQ(to_vector(stream.str()), *write_result);
+
+        auto read_result = blopp::read<test_struct_store>(stream);
+        ASSERT_TRUE(read_result);
+        blopp_test::expect_store_eq(read_result->value, input);
+    }
+
+    TEST(stream, fail_cannot_write_stream) {
+        auto stream = std::stringstream{};
+        stream.setstate(std::ios::badbit);
+
+        auto write_stream_result = blopp::write(create_store(), stream);
+        ASSERT_FALSE(write_stream_result);
+        EXPECT_EQ(write_stream_result.error(), blopp::write_error_code::cannot_write_stream);
+    }
+}
@@ -73,6 +73,25 @@ namespace {
         EXPECT_STREQ(it->second.c_str(), "Foo bar");
     }
 
+    TEST(type_map, ok_duplicate_keys_keep_first_value) {
+        const auto input = std::multimap<int32_t, std::string>{
+            { 1, "First" },
+            { 1, "Second" },
+            { 2, "Third" }
+        };
+
+        auto write_result = blopp::write(input);
+        ASSERT_TRUE(write_result);
+
+        auto read_result = blopp::read<std::map<int32_t, std::string>>(*write_result);
+        ASSERT_TRUE(read_result);
+
+        auto& output = read_result->value;
+        ASSERT_EQ(output.size(), size_t{ 2 });
+        EXPECT_EQ(output.at(1), "First");
+        EXPECT_EQ(output.at(2), "Third");
+    }
+
     TEST(type_map, fail_map_offset_overflow) {
         const auto input = std::map<std::string, std::string>{
             { "key_1", std::string(size_t{ 70 }, 'A') },
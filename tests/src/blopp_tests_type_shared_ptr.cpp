@@ -166,4 +166,24 @@ namespace {
         EXPECT_EQ(output_3->value_2, int32_t{ true });
         EXPECT_EQ(output_3->value_3, float{ 2.0f });
     }
+
+    TEST(type_shared_ptr, ok_vector_references_appended_to_output) {
+        auto output = blopp::write_output_type{ 0xAA, 0xBB, 0xCC, 0xDD, 0xEE };
+
+        const auto shared_value = std::make_shared<int32_t>(123);
+        const auto input = std::vector<std::shared_ptr<int32_t>>{ shared_value, shared_value };
+
+        auto write_result = blopp::write(input, output);
+        ASSERT_TRUE(write_result);
+        EXPECT_EQ(write_result->data(), output.data() + 5);
+
+        auto read_result = blopp::read<std::vector<std::shared_ptr<int32_t>>>(*write_result);
+        ASSERT_TRUE(read_result);
+
+        auto& output_values = read_result->value;
+        ASSERT_EQ(output_values.size(), size_t{ 2 });
+        ASSERT_TRUE(output_values.at(0));
+        EXPECT_EQ(*output_values.at(0), int32_t{ 123 });
+        EXPECT_EQ(output_values.at(0), output_values.at(1));
+    }
 }
\ No newline at end of file
@@ -0,0 +1,137 @@
+#include "blopp_test.hpp"
+
+namespace {
+    struct test_struct_samples {
+        uint32_t id;
+        std::span<const float> samples;
+        std::span<const bool> flags;
+    };
+}
+
+template<>
+struct blopp::object<test_struct_samples> {
+    static auto map(auto& context, auto& value) {
+        context.map(
+            value.id,
+            value.samples,
+            value.flags);
+    }
+};
+
+namespace {
+    TEST(type_span, ok_span_empty) {
+        auto write_result = blopp::write(std::span<const int32_t>{});
+        ASSERT_TRUE(write_result);
+
+        auto read_result = blopp::read<std::span<const int32_t>>(*write_result);
+        ASSERT_TRUE(read_result);
+        EXPECT_TRUE(read_result->value.empty());
+    }
+
+    TEST(type_span, ok_span_int64) {
+        const auto input = std::vector<int64_t>{ 1, -2, 3, -4, 5 };
+
+        auto write_result = blopp::write(std::span<const int64_t>{ input });
+        ASSERT_TRUE(write_result);
+
+        auto buffer = std::vector<uint64_t>{};
+        auto read_result = blopp_test::read_aligned<std::span<const int64_t>>(*write_result, buffer);
+        ASSERT_TRUE(read_result);
+
+        auto& output = read_result->value;
+        ASSERT_EQ(output.size(), input.size());
+        EXPECT_TRUE(std::equal(output.begin(), output.end(), input.begin()));
+        EXPECT_GE(reinterpret_cast<const uint64_t*>(output.data()), buffer.data());
+        EXPECT_LT(reinterpret_cast<const uint64_t*>(output.data()), buffer.data() + buffer.size());
+    }
+
+    TEST(type_span, ok_same_format_as_vector) {
+        const auto input = std::vector<uint32_t>{ 1, 2, 3, 4, 5 };
+
+        auto write_vector_result = blopp::write(input);
+        ASSERT_TRUE(write_vector_result);
+
+        auto write_span_result = blopp::write(std::span<const uint32_t>{ input });
+        ASSERT_TRUE(write_span_result);
+
+        EXPECT_EQ(*write_vector_result, *write_span_result);
+
+        auto read_vector_result = blopp::read<std::vector<uint32_t>>(*write_span_result);
+        ASSERT_TRUE(read_vector_result);
+        EXPECT_EQ(read_vector_result->value, input);
+    }
+
+    TEST(type_span, ok_object) {
+        const auto samples = std::vector<float>{ 1.0f, 2.0f, 3.0f };
+        const auto flags = std::array<bool, 4>{ true, false, false, true };
+
+        const auto input = test_struct_samples{
+            .id = 123,
+            .samples = samples,
+            .flags = flags
+        };
+
+        auto write_result = blopp::write(input);
+        ASSERT_TRUE(write_result);
+
+        auto buffer = std::vector<uint64_t>{};
+        auto read_result = blopp_test::read_aligned<test_struct_samples>(*write_result, buffer);
+        ASSERT_TRUE(read_result);
+
+        auto& output = read_result->value;
+        EXPECT_EQ(output.id, uint32_t{ 123 });
+        ASSERT_EQ(output.samples.size(), samples.size());
+        EXPECT_TRUE(std::equal(output.samples.begin(), output.samples.end(), samples.begin()));
+        ASSERT_EQ(output.flags.size(), flags.size());
+        EXPECT_TRUE(std::equal(output.flags.begin(), output.flags.end(), flags.begin()));
+    }
+
+    TEST(type_span, fail_misaligned_data) {
+        const auto input = std::vector<uint32_t>{ 1, 2, 3 };
+
+        auto write_result = blopp::write(std::span<const uint32_t>{ input });
+        ASSERT_TRUE(write_result);
+
+        auto buffer = std::vector<uint64_t>((write_result->size() / sizeof(uint64_t)) + 2);
+        auto* buffer_data = reinterpret_cast<uint8_t*>(buffer.data());
+
+        // Only one of four neighbouring offsets places the elements on their alignment.
+        auto misaligned_count = size_t{ 0 };
+        for (size_t offset = 0; offset < sizeof(uint32_t); offset++) {
+            std::copy(write_result->begin(), write_result->end(), buffer_data + offset);
+
+            auto read_result = blopp::read<std::span<const uint32_t>>(std::span<const uint8_t>{ buffer_data + offset, write_result->size() });
+            if (!read_result) {
+                EXPECT_EQ(read_result.error(), blopp::read_error_code::misaligned_data);
+                ++misaligned_count;
+            }
+        }
+
+        EXPECT_EQ(misaligned_count, size_t{ 3 });
+    }
+
+    TEST(type_span, fail_bad_boolean_value) {
+        const auto input = std::vector<uint8_t>{ 0, 1, 2 };
+
+        auto write_result = blopp::write(std::span<const uint8_t>{ input });
+        ASSERT_TRUE(write_result);
+
+        auto& output = *write_result;
+        output.at(1 + 8) = static_cast<uint8_t>(blopp::impl::data_types::boolean);
+
+        auto read_result = blopp::read<std::span<const bool>>(output);
+        ASSERT_FALSE(read_result);
+        EXPECT_EQ(read_result.error(), blopp::read_error_code::bad_boolean_value);
+    }
+
+    TEST(type_span, fail_mismatching_type) {
+        const auto input = std::vector<uint32_t>{ 1, 2, 3 };
+
+        auto write_result = blopp::write(input);
+        ASSERT_TRUE(write_result);
+
+        auto read_result = blopp::read<std::span<const int32_t>>(*write_result);
+        ASSERT_FALSE(read_result);
+        EXPECT_EQ(read_result.error(), blopp::read_error_code::mismatching_type);
+    }
+}
@@ -0,0 +1,128 @@
+#include "blopp_test.hpp"
+
+namespace {
+    struct test_struct_request {
+        uint32_t id;
+        std::string_view name;
+        std::u16string_view title;
+    };
+}
+
+template<>
+struct blopp::object<test_struct_request> {
+    static auto map(auto& context, auto& value) {
+        context.map(
+            value.id,
+            value.name,
+            value.title);
+    }
+};
+
+namespace {
+    TEST(type_string_view, ok_string_view_empty) {
+        auto write_result = blopp::write(std::string_view{});
+        ASSERT_TRUE(write_result);
+
+        auto read_result = blopp::read<std::string_view>(*write_result);
+        ASSERT_TRUE(read_result);
+        EXPECT_TRUE(read_result->value.empty());
+    }
+
+    TEST(type_string_view, ok_string_view) {
+        auto write_result = blopp::write(std::string_view{ "Hello world" });
+        ASSERT_TRUE(write_result);
+
+        auto read_result = blopp::read<std::string_view>(*write_result);
+        ASSERT_TRUE(read_result);
+
+        auto& output = read_result->value;
+        EXPECT_EQ(output, std::string_view{ "Hello world" });
+        EXPECT_GE(reinterpret_cast<const uint8_t*>(output.data()), write_result->data());
+        EXPECT_LT(reinterpret_cast<const uint8_t*>(output.data()), write_result->data() + write_result->size());
+    }
+
+    TEST(type_string_view, ok_same_format_as_string) {
+        auto write_string_result = blopp::write(std::u16string{ u"Hello world" });
+        ASSERT_TRUE(write_string_result);
+
+        auto write_string_view_result = blopp::write(std::u16string_view{ u"Hello world" });
+        ASSERT_TRUE(write_string_view_result);
+
+        EXPECT_EQ(*write_string_result, *write_string_view_result);
+
+        auto read_string_result = blopp::read<std::u16string>(*write_string_view_result);
+        ASSERT_TRUE(read_string_result);
+        EXPECT_EQ(read_string_result->value, std::u16string{ u"Hello world" });
+
+        auto buffer = std::vector<uint64_t>{};
+        auto read_string_view_result = blopp_test::read_aligned<std::u16string_view>(*write_string_result, buffer);
+        ASSERT_TRUE(read_string_view_result);
+        EXPECT_EQ(read_string_view_result->value, std::u16string_view{ u"Hello world" });
+    }
+
+    TEST(type_string_view, ok_object) {
+        const auto input = test_struct_request{
+            .id = 123,
+            .name = "Apple",
+            .title = u"Fruit"
+        };
+
+        auto write_result = blopp::write(input);
+        ASSERT_TRUE(write_result);
+
+        auto buffer = std::vector<uint64_t>{};
+        auto read_result = blopp_test::read_aligned<test_struct_request>(*write_result, buffer);
+        ASSERT_TRUE(read_result);
+
+        auto& output = read_result->value;
+        EXPECT_EQ(output.id, uint32_t{ 123 });
+        EXPECT_EQ(output.name, std::string_view{ "Apple" });
+        EXPECT_EQ(output.title, std::u16string_view{ u"Fruit" });
+    }
+
+    TEST(type_string_view, fail_misaligned_data) {
+        auto write_result = blopp::write(std::u16string_view{ u"Hello world" });
+        ASSERT_TRUE(write_result);
+
+        auto buffer = std::vector<uint64_t>((write_result->size() / sizeof(uint64_t)) + 2);
+        auto* buffer_data = reinterpret_cast<uint8_t*>(buffer.data());
+
+        // Exactly one of two neighbouring offsets places the characters on their alignment.
+        auto misaligned_count = size_t{ 0 };
+        for (size_t offset = 0; offset < sizeof(char16_t); offset++) {
+            std::copy(write_result->begin(), write_result->end(), buffer_data + offset);
+            const auto input = std::span<const uint8_t>{ buffer_data + offset, write_result->size() };
+
+            auto read_result = blopp::read<std::u16string_view>(input);
+            if (!read_result) {
+                EXPECT_EQ(read_result.error(), blopp::read_error_code::misaligned_data);
+                ++misaligned_count;
+            }
+
+            auto read_string_result = blopp::read<std::u16string>(input);
+            ASSERT_TRUE(read_string_result);
+            EXPECT_EQ(read_string_result->value, std::u16string{ u"Hello world" });
+        }
+
+        EXPECT_EQ(misaligned_count, size_t{ 1 });
+    }
+
+    TEST(type_string_view, fail_mismatching_string_char_size) {
+        auto write_result = blopp::write(std::string_view{ "Hello world" });
+        ASSERT_TRUE(write_result);
+
+        auto read_result = blopp::read<std::u16string_view>(*write_result);
+        ASSERT_FALSE(read_result);
+        EXPECT_EQ(read_result.error(), blopp::read_error_code::mismatching_string_char_size);
+    }
+
+    TEST(type_string_view, fail_insufficient_data) {
+        auto write_result = blopp::write(std::string_view{ "Hello world" });
+        ASSERT_TRUE(write_result);
+
+        auto input = std::span{ *write_result };
+        auto read_result = blopp::read<std::string_view>(input.first(input.size() - 1));
+        ASSERT_FALSE(read_result);
+        EXPECT_EQ(read_result.error(), blopp::read_error_code::insufficient_data);
+    }
+}
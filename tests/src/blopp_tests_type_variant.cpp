@@ -78,4 +78,34 @@ namespace {
         EXPECT_EQ(output_struct.value_2, true);
         EXPECT_EQ(output_struct.value_3, 4.0f);
     }
-}
\ No newline at end of file
+
+    TEST(type_variant, ok_variant_duplicate_types) {
+        using duplicate_variant_t = std::variant<int32_t, std::string, int32_t>;
+
+        auto input = duplicate_variant_t{ std::in_place_index<2>, int32_t{ 123 } };
+
+        auto write_result = blopp::write(input);
+        ASSERT_TRUE(write_result);
+
+        auto read_result = blopp::read<duplicate_variant_t>(*write_result);
+        ASSERT_TRUE(read_result);
+
+        auto& output = read_result->value;
+        ASSERT_EQ(output.index(), size_t{ 2 });
+        EXPECT_EQ(std::get<2>(output), 123);
+    }
+
+    TEST(type_variant, fail_bad_variant_index) {
+        auto write_result = blopp::write(variant_test_type{ 1.0f });
+        ASSERT_TRUE(write_result);
+        write_result->at(1) = uint8_t{ 3 };
+
+        auto read_result = blopp::read<variant_test_type>(*write_result);
+        ASSERT_FALSE(read_result);
+        EXPECT_EQ(read_result.error(), blopp::read_error_code::bad_variant_index);
+
+        auto read_trusted_result = blopp::read<blopp::trusted_default_options, variant_test_type>(*write_result);
+        ASSERT_FALSE(read_trusted_result);
+        EXPECT_EQ(read_trusted_result.error(), blopp::read_error_code::bad_variant_index);
+    }
+}
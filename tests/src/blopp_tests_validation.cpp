@@ -0,0 +1,155 @@
+#include "blopp_test.hpp"
+
+namespace {
+    struct test_utf8_options : blopp::default_options {
+        static constexpr auto validate_utf8 = true;
+    };
+
+    struct test_struct_message {
+        std::u8string text = {};
+        std::string raw = {};
+    };
+}
+
+template<>
+struct blopp::object<test_struct_message> {
+    static auto map(auto& context, auto& value) {
+        context.map(
+            value.text,
+            value.raw);
+    }
+};
+
+namespace {
+    bool is_valid_utf8(const std::vector<uint8_t>& data) {
+        return blopp::impl::is_valid_utf8(data.data(), data.size());
+    }
+
+    TEST(validation, ok_has_only_bool_values) {
+        for (size_t size = 0; size < 100; size++) {
+            auto data = std::vector<uint8_t>(size);
+            for (size_t i = 0; i < size; i++) {
+                data.at(i) = static_cast<uint8_t>(i % 2);
+            }
+            EXPECT_TRUE(blopp::impl::has_only_bool_values(data.data(), data.size()));
+
+            for (size_t position = 0; position < size; position++) {
+                for (const auto bad_value : { uint8_t{ 2 }, uint8_t{ 0x80 }, uint8_t{ 0xFF } }) {
+                    auto bad_data = data;
+                    bad_data.at(position) = bad_value;
+                    EXPECT_FALSE(blopp::impl::has_only_bool_values(bad_data.data(), bad_data.size()));
+                }
+            }
+        }
+    }
+
+    TEST(validation, ok_is_valid_utf8) {
+        EXPECT_TRUE(is_valid_utf8({}));
+        EXPECT_TRUE(is_valid_utf8({ 'H', 'e', 'l', 'l', 'o' }));
+        EXPECT_TRUE(is_valid_utf8({ 0xC3, 0xA5 }));
+        EXPECT_TRUE(is_valid_utf8({ 0xE2, 0x82, 0xAC }));
+        EXPECT_TRUE(is_valid_utf8({ 0xED, 0x9F, 0xBF }));
+        EXPECT_TRUE(is_valid_utf8({ 0xF0, 0x9F, 0x98, 0x80 }));
+        EXPECT_TRUE(is_valid_utf8({ 0xF4, 0x8F, 0xBF, 0xBF }));
+
+        auto long_text = std::vector<uint8_t>(size_t{ 100 }, uint8_t{ 'a' });
+        long_text.insert(long_text.begin() + 50, { 0xF0, 0x9F, 0x98, 0x80 });
+        EXPECT_TRUE(is_valid_utf8(long_text));
+    }
+
+    TEST(validation, fail_is_valid_utf8) {
+        EXPECT_FALSE(is_valid_utf8({ 0x80 }));
+        EXPECT_FALSE(is_valid_utf8({ 0xC0, 0x80 }));
+        EXPECT_FALSE(is_valid_utf8({ 0xC1, 0xBF }));
+        EXPECT_FALSE(is_valid_utf8({ 0xC3 }));
+        EXPECT_FALSE(is_valid_utf8({ 0xC3, 0x28 }));
+        EXPECT_FALSE(is_valid_utf8({ 0xE0, 0x80, 0x80 }));
+        EXPECT_FALSE(is_valid_utf8({ 0xED, 0xA0, 0x80 }));
+        EXPECT_FALSE(is_valid_utf8({ 0xE2, 0x82 }));
+        EXPECT_FALSE(is_valid_utf8({ 0xF0, 0x80, 0x80, 0x80 }));
+        EXPECT_FALSE(is_valid_utf8({ 0xF4, 0x90, 0x80, 0x80 }));
+        EXPECT_FALSE(is_valid_utf8({ 0xF5, 0x80, 0x80, 0x80 }));
+        EXPECT_FALSE(is_valid_utf8({ 0xFF }));
+
+        for (size_t position = 0; position < 100; position++) {
+            auto long_text = std::vector<uint8_t>(size_t{ 100 }, uint8_t{ 'a' });
+            long_text.at(position) = 0x80;
+            EXPECT_FALSE(is_valid_utf8(long_text));
+        }
+    }
+
+    TEST(validation, ok_large_bool_containers) {
+        auto input_vector = std::vector<bool>(size_t{ 1000 });
+        auto input_array = std::array<bool, 1000>{};
+        for (size_t i = 0; i < input_vector.size(); i++) {
+            input_vector.at(i) = (i % 3) == 0;
+            input_array.at(i) = (i % 5) == 0;
+        }
+
+        auto write_vector_result = blopp::write(input_vector);
+        ASSERT_TRUE(write_vector_result);
+        auto read_vector_result = blopp::read<std::vector<bool>>(*write_vector_result);
+        ASSERT_TRUE(read_vector_result);
+        EXPECT_EQ(read_vector_result->value, input_vector);
+
+        auto write_array_result = blopp::write(input_array);
+        ASSERT_TRUE(write_array_result);
+        auto read_array_result = blopp::read<std::array<bool, 1000>>(*write_array_result);
+        ASSERT_TRUE(read_array_result);
+        EXPECT_EQ(read_array_result->value, input_array);
+
+        write_array_result->at(write_array_result->size() - 500) = uint8_t{ 2 };
+        auto fail_array_result = blopp::read<std::array<bool, 1000>>(*write_array_result);
+        ASSERT_FALSE(fail_array_result);
+        EXPECT_EQ(fail_array_result.error(), blopp::read_error_code::bad_boolean_value);
+    }
+
+    TEST(validation, ok_utf8_string) {
+        const auto input = test_struct_message{
+            .text = u8"Hello wörld, with an emoji: 😀",
+            .raw = "\xFF\xFE"
+        };
+
+        auto write_result = blopp::write(input);
+        ASSERT_TRUE(write_result);
+
+        auto read_result = blopp::read<test_utf8_options, test_struct_message>(*write_result);
+        ASSERT_TRUE(read_result);
+        EXPECT_TRUE(read_result->value.text == input.text);
+        EXPECT_EQ(read_result->value.raw, input.raw);
+
+        auto verify_result = blopp::verify<test_utf8_options, test_struct_message>(*write_result);
+        EXPECT_TRUE(verify_result);
+    }
+
+    TEST(validation, fail_bad_utf8_string) {
+        const auto input = test_struct_message{
+            .text = std::u8string{ u8"Hello" } + static_cast<char8_t>(0xC0),
+            .raw = {}
+        };
+
+        auto write_result = blopp::write(input);
+        ASSERT_TRUE(write_result);
+
+        auto read_result = blopp::read<test_utf8_options, test_struct_message>(*write_result);
+        ASSERT_FALSE(read_result);
+        EXPECT_EQ(read_result.error(), blopp::read_error_code::bad_utf8_string);
+
+        auto verify_result = blopp::verify<test_utf8_options, test_struct_message>(*write_result);
+        ASSERT_FALSE(verify_result);
+        EXPECT_EQ(verify_result.error(), blopp::read_error_code::bad_utf8_string);
+
+        auto read_unvalidated_result = blopp::read<test_struct_message>(*write_result);
+        ASSERT_TRUE(read_unvalidated_result);
+        EXPECT_TRUE(read_unvalidated_result->value.text == input.text);
+    }
+
+    TEST(validation, fail_bad_utf8_string_view) {
+        auto write_result = blopp::write(std::u8string_view{ u8"\xED\xA0\x80" });
+        ASSERT_TRUE(write_result);
+
+        auto read_result = blopp::read<test_utf8_options, std::u8string_view>(*write_result);
+        ASSERT_FALSE(read_result);
+        EXPECT_EQ(read_result.error(), blopp::read_error_code::bad_utf8_string);
+    }
+}
@@ -0,0 +1,270 @@
+#include "blopp_test.hpp"
+#include "blopp_test_binary_format_types.hpp"
+#include "blopp_test_store.hpp"
+#include <sstream>
+
+namespace {
+    using blopp_test::test_struct_store;
+
+    // Writes a longer name every pass.
+    struct test_struct_pass_counter {
+        mutable size_t pass_count = 0;
+    };
+
+    struct test_varint_trusted_options : blopp::varint_default_options {
+        static constexpr auto trusted_input = true;
+    };
+
+    struct test_varint_index_options : blopp::varint_default_options {
+        static constexpr auto list_element_index = true;
+    };
+
+    struct test_varint_parallel_options : blopp::varint_default_options {
+        static constexpr size_t parallel_write_chunk_size = 4;
+        static constexpr size_t parallel_read_chunk_size = 4;
+    };
+}
+
+template<>
+struct blopp::object<test_struct_pass_counter> {
+    static auto map(auto& context, const test_struct_pass_counter& value) {
+        const auto name = std::string(value.pass_count++ * 100, 'x');
+        context.map(name);
+    }
+};
+
+namespace {
+    // Products of growing size, for offsets and counts of one to several varint bytes.
+    test_struct_store create_store() {
+        auto result = blopp_test::create_store(60);
+
+        for (auto& product : result.products) {
+            product.name += std::string(product.id * 10, 'x');
+            product.values.resize(product.id * product.id, static_cast<int32_t>(product.id));
+        }
+        *result.featured_1 = result.products.at(10);
+
+        return result;
+    }
+
+    template<typename TOptions>
+    void expect_store_read(std::span<const uint8_t> data, const test_struct_store& input) {
+        auto read_result = blopp::read<TOptions, test_struct_store>(data);
+        ASSERT_TRUE(read_result);
+        EXPECT_TRUE(read_result->remaining.empty());
+
+        blopp_test::expect_store_eq(read_result->value, input);
+    }
+
+    TEST(varint, ok_read_write) {
+        const auto input = create_store();
+
+        auto write_result = blopp::write<blopp::varint_default_options>(input);
+        ASSERT_TRUE(write_result);
+        expect_store_read<blopp::varint_default_options>(*write_result, input);
+
+        auto default_write_result = blopp::write(input);
+        ASSERT_TRUE(default_write_result);
+        EXPECT_LT(write_result->size(), default_write_result->size());
+    }
+
+    TEST(varint, ok_varint_counts) {
+        const auto input = create_store();
+
+        auto write_result = blopp::write<blopp_test::varint_count_options>(input);
+        ASSERT_TRUE(write_result);
+        expect_store_read<blopp_test::varint_count_options>(*write_result, input);
+    }
+
+    TEST(varint, ok_trusted_input) {
+        const auto input = create_store();
+
+        auto write_result = blopp::write<blopp::varint_default_options>(input);
+        ASSERT_TRUE(write_result);
+        expect_store_read<test_varint_trusted_options>(*write_result, input);
+    }
+
+    TEST(varint, ok_verify) {
+        auto write_result = blopp::write<blopp::varint_default_options>(create_store());
+        ASSERT_TRUE(write_result);
+
+        auto verify_result = blopp::verify<blopp::varint_default_options, test_struct_store>(*write_result);
+        ASSERT_TRUE(verify_result);
+        EXPECT_TRUE(verify_result->empty());
+    }
+
+    TEST(varint, ok_binary_format) {
+        auto write_result = blopp::write<blopp::varint_default_options>(std::string{ "A" });
+        ASSERT_TRUE(write_result);
+        EXPECT_EQ(*write_result, (std::vector<uint8_t>{ 13, 2, 1, 'A' }));
+
+        write_result = blopp::write<blopp::varint_default_options>(std::vector<uint8_t>{ 1, 2, 3 });
+        ASSERT_TRUE(write_result);
+        EXPECT_EQ(*write_result, (std::vector<uint8_t>{ 15, 5, 7, 3, 1, 2, 3 }));
+
+        // Offset of 201 bytes, written in two bytes, of 7 bits each.
+        write_result = blopp::write<blopp::varint_default_options>(std::string(200, 'A'));
+        ASSERT_TRUE(write_result);
+        ASSERT_EQ(write_result->size(), size_t{ 1 + 2 + 1 + 200 });
+        EXPECT_EQ(write_result->at(1), uint8_t{ 0b11001001 });
+        EXPECT_EQ(write_result->at(2), uint8_t{ 0b00000001 });
+    }
+
+    TEST(varint, ok_offsets_of_nested_blocks) {
+        // Offsets of the outer lists grow with the size of the varints of the inner ones.
+        const auto input = std::vector<std::vector<std::string>>{
+            { std::string(100, 'a'), std::string(20000, 'b') },
+            {},
+            { std::string(1, 'c') }
+        };
+
+        auto write_result = blopp::write<blopp::varint_default_options>(input);
+        ASSERT_TRUE(write_result);
+
+        auto size_result = blopp::serialized_size<blopp::varint_default_options>(input);
+        ASSERT_TRUE(size_result);
+        EXPECT_EQ(size_result.value(), write_result->size());
+
+        auto read_result = blopp::read<blopp::varint_default_options, std::vector<std::vector<std::string>>>(*write_result);
+        ASSERT_TRUE(read_result);
+        EXPECT_EQ(read_result->value, input);
+    }
+
+    TEST(varint, ok_write_outputs) {
+        const auto input = create_store();
+
+        auto write_result = blopp::write<blopp::varint_default_options>(input);
+        ASSERT_TRUE(write_result);
+
+        auto buffer = std::vector<uint8_t>(write_result->size());
+        auto write_to_result = blopp::write_to<blopp::varint_default_options>(buffer, input);
+        ASSERT_TRUE(write_to_result);
+        EXPECT_EQ(buffer, *write_result);
+
+        auto stream = std::stringstream{};
+        auto stream_write_result = blopp::write<blopp::varint_default_options>(input, stream, size_t{ 64 });
+        ASSERT_TRUE(stream_write_result);
+        const auto stream_output = stream.str();
+        EXPECT_EQ((std::vector<uint8_t>{ stream_output.begin(), stream_output.end() }), *write_result);
+    }
+
+    TEST(varint, ok_encoder) {
+        const auto input = create_store();
+
+        auto write_result = blopp::write<blopp::varint_default_options>(input);
+        ASSERT_TRUE(write_result);
+
+        for (const auto window_size : { size_t{ 1 }, size_t{ 13 }, size_t{ 1000 }, size_t{ 1000000 } }) {
+            auto encoder = blopp::encoder<test_struct_store, blopp::varint_default_options>{ input };
+            auto window = std::vector<uint8_t>(window_size);
+            auto output = std::vector<uint8_t>{};
+
+            while (encoder.status() != blopp::encode_status::complete) {
+                auto encode_result = encoder.write(window);
+                ASSERT_TRUE(encode_result);
+                output.insert(output.end(), window.begin(), window.begin() + encode_result->written_size);
+            }
+
+            EXPECT_EQ(output, *write_result);
+        }
+    }
+
+    TEST(varint, ok_decoder) {
+        const auto input = create_store();
+
+        auto write_result = blopp::write<blopp::varint_default_options>(input);
+        ASSERT_TRUE(write_result);
+
+        const auto data = std::span<const uint8_t>{ *write_result };
+
+        for (const auto chunk_size : { size_t{ 1 }, size_t{ 3 }, size_t{ 1000 } }) {
+            auto decoder = blopp::decoder<test_struct_store, blopp::varint_default_options>{};
+
+            for (size_t position = 0; position < data.size(); position += chunk_size) {
+                auto push_result = decoder.push(data.subspan(position, std::min(chunk_size, data.size() - position)));
+                ASSERT_TRUE(push_result);
+            }
+
+            ASSERT_EQ(decoder.status(), blopp::decode_status::complete);
+            EXPECT_EQ(decoder.value().products, input.products);
+        }
+    }
+
+    TEST(varint, ok_list_element_index) {
+        const auto input = create_store();
+
+        auto write_result = blopp::write<test_varint_index_options>(input);
+        ASSERT_TRUE(write_result);
+        expect_store_read<blopp::varint_default_options>(*write_result, input);
+
+        auto product_view = blopp::make_view<test_varint_index_options>(*write_result)
+            .value().as_object().value().at(1).value().as_list().value().at(42).value().as_object();
+        ASSERT_TRUE(product_view);
+        EXPECT_EQ(product_view->at(0).value().as<uint32_t>().value(), uint32_t{ 42 });
+    }
+
+    TEST(varint, ok_parallel) {
+        const auto input = create_store();
+
+        auto write_result = blopp::write<blopp::varint_default_options>(input);
+        ASSERT_TRUE(write_result);
+
+        // Containers with varint offsets are written serially, and read in parallel.
+        auto parallel_write_result = blopp::write<test_varint_parallel_options>(input);
+        ASSERT_TRUE(parallel_write_result);
+        EXPECT_EQ(*parallel_write_result, *write_result);
+
+        expect_store_read<test_varint_parallel_options>(*write_result, input);
+    }
+
+    TEST(varint, ok_write_plans_once) {
+        const auto input = test_struct_pass_counter{};
+
+        // Written by a planning pass and a writing pass, failing as they differ.
+        auto write_result = blopp::write<blopp::varint_default_options>(input);
+        ASSERT_FALSE(write_result);
+        EXPECT_EQ(input.pass_count, size_t{ 2 });
+    }
+
+    TEST(varint, fail_mismatching_varint_plan) {
+        const auto input = test_struct_pass_counter{};
+
+        auto write_result = blopp::write<blopp::varint_default_options>(input);
+        ASSERT_FALSE(write_result);
+        EXPECT_EQ(write_result.error(), blopp::write_error_code::mismatching_varint_plan);
+
+        auto output = blopp::write_output_type{};
+        auto write_output_result = blopp::write<blopp::varint_default_options>(input, output);
+        ASSERT_FALSE(write_output_result);
+        EXPECT_EQ(write_output_result.error(), blopp::write_error_code::mismatching_varint_plan);
+        EXPECT_TRUE(output.empty());
+    }
+
+    TEST(varint, fail_bad_varint) {
+        // More bytes than a 64 bit value is written in.
+        auto read_result = blopp::read<blopp::varint_default_options, std::string>(
+            std::vector<uint8_t>{ 13, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x01, 1 });
+        ASSERT_FALSE(read_result);
+        EXPECT_EQ(read_result.error(), blopp::read_error_code::bad_varint);
+
+        // Variant index over the 16 bits of its type.
+        auto variant_read_result = blopp::read<blopp::varint_default_options, std::variant<int32_t, float>>(
+            std::vector<uint8_t>{ 17, 0x80, 0x80, 0x04, 5, 0, 0, 0, 0 });
+        ASSERT_FALSE(variant_read_result);
+        EXPECT_EQ(variant_read_result.error(), blopp::read_error_code::bad_varint);
+    }
+
+    TEST(varint, fail_insufficient_data) {
+        auto read_result = blopp::read<blopp::varint_default_options, std::string>(std::vector<uint8_t>{ 13, 0x80 });
+        ASSERT_FALSE(read_result);
+        EXPECT_EQ(read_result.error(), blopp::read_error_code::insufficient_data);
+    }
+
+    TEST(varint, fail_count_outside_block) {
+        // Element count of two bytes, in a list block of two bytes.
+        auto read_result = blopp::read<blopp::varint_default_options, std::vector<uint8_t>>(
+            std::vector<uint8_t>{ 15, 2, 7, 0x80, 0x01 });
+        ASSERT_FALSE(read_result);
+        EXPECT_EQ(read_result.error(), blopp::read_error_code::bad_list_offset);
+    }
+}
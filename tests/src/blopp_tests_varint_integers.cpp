@@ -0,0 +1,555 @@
+#include "blopp_test.hpp"
+#include <random>
+
+namespace {
+    struct varint_integers_options : blopp::default_options {
+        static constexpr auto varint_integers = true;
+    };
+
+    struct varint_integers_trusted_options : varint_integers_options {
+        static constexpr auto trusted_input = true;
+    };
+
+    struct varint_integers_parallel_options : varint_integers_options {
+        static constexpr size_t parallel_write_chunk_size = 4;
+        static constexpr size_t parallel_read_chunk_size = 4;
+    };
+
+    enum class test_enum_color : int32_t {
+        red = -1,
+        green = 1,
+        blue = 1000
+    };
+
+    struct test_struct_position {
+        int64_t x = 0;
+        int64_t y = 0;
+    };
+
+    bool operator == (const test_struct_position& lhs, const test_struct_position& rhs) {
+        return lhs.x == rhs.x && lhs.y == rhs.y;
+    }
+
+    struct test_struct_integers {
+        int64_t id = 0;
+        uint32_t count = 0;
+        int16_t delta = 0;
+        uint8_t flags = 0;
+        double price = 0.0;
+        test_enum_color color = test_enum_color::red;
+        std::vector<int64_t> values = {};
+        std::list<int32_t> list_values = {};
+        std::array<uint16_t, 4> array_values = {};
+        std::vector<test_enum_color> colors = {};
+        std::map<int32_t, int64_t> counters = {};
+        std::optional<int64_t> timestamp = {};
+        std::optional<int64_t> missing_timestamp = {};
+        std::unique_ptr<int32_t> level = {};
+        std::shared_ptr<int64_t> shared_1 = {};
+        std::shared_ptr<int64_t> shared_2 = {};
+        std::variant<int64_t, std::string> code = {};
+        std::vector<std::optional<int32_t>> optional_values = {};
+        test_struct_position position = {};
+    };
+
+    struct test_struct_mapped_as_varint {
+        int32_t id = 0;
+        int64_t total = 0;
+        std::vector<int32_t> values = {};
+    };
+
+    struct test_struct_mapped_as_small_varint {
+        int32_t id = 0;
+    };
+
+    struct test_struct_skip_integers {
+        int64_t id = 0;
+        double price = 0.0;
+    };
+}
+
+template<>
+struct blopp::object<test_struct_position> {
+    static auto map(auto& context, auto& value) {
+        context.map(value.x, value.y);
+    }
+};
+
+template<>
+struct blopp::object<test_struct_integers> {
+    static auto map(auto& context, auto& value) {
+        context.map(
+            value.id,
+            value.count,
+            value.delta,
+            value.flags,
+            value.price,
+            value.color,
+            value.values,
+            value.list_values,
+            value.array_values,
+            value.colors,
+            value.counters,
+            value.timestamp,
+            value.missing_timestamp,
+            value.level,
+            value.shared_1,
+            value.shared_2,
+            value.code,
+            value.optional_values,
+            value.position);
+    }
+};
+
+template<>
+struct blopp::object<test_struct_mapped_as_varint> {
+    static auto map(auto& context, auto& value) {
+        context.template map_as<blopp::varint<int64_t>>(value.id);
+        context.map(value.total);
+        context.template map_as<blopp::varint<int32_t>>(value.values);
+    }
+};
+
+template<>
+struct blopp::object<test_struct_mapped_as_small_varint> {
+    static auto map(auto& context, auto& value) {
+        context.template map_as<blopp::varint<int16_t>>(value.id);
+    }
+};
+
+template<>
+struct blopp::object<test_struct_skip_integers> {
+    static auto map(auto& context, auto& value) {
+        context.map(value.id);
+        context.skip(3);
+        context.map(value.price);
+    }
+};
+
+namespace {
+    test_struct_integers create_integers() {
+        auto result = test_struct_integers{
+            .id = 1234567,
+            .count = 3,
+            .delta = -300,
+            .flags = 255,
+            .price = 12.5,
+            .color = test_enum_color::blue,
+            .values = { 0, 1, -1, 63, -64, 64, -65, std::numeric_limits<int64_t>::max(), std::numeric_limits<int64_t>::min() },
+            .list_values = { -5, 5, 500000 },
+            .array_values = { 0, 127, 128, std::numeric_limits<uint16_t>::max() },
+            .colors = { test_enum_color::red, test_enum_color::green, test_enum_color::blue },
+            .counters = { { -1, 10 }, { 1, -1000000 }, { 1000, 0 } },
+            .timestamp = 1700000000,
+            .missing_timestamp = std::nullopt,
+            .level = std::make_unique<int32_t>(-7),
+            .shared_1 = std::make_shared<int64_t>(-123456789),
+            .shared_2 = {},
+            .code = int64_t{ -42 },
+            .optional_values = { 1, std::nullopt, -100000 },
+            .position = { .x = -1, .y = 1 }
+        };
+        result.shared_2 = result.shared_1;
+
+        return result;
+    }
+
+    void expect_integers_eq(const test_struct_integers& output, const test_struct_integers& input) {
+        EXPECT_EQ(output.id, input.id);
+        EXPECT_EQ(output.count, input.count);
+        EXPECT_EQ(output.delta, input.delta);
+        EXPECT_EQ(output.flags, input.flags);
+        EXPECT_EQ(output.price, input.price);
+        EXPECT_EQ(output.color, input.color);
+        EXPECT_EQ(output.values, input.values);
+        EXPECT_EQ(output.list_values, input.list_values);
+        EXPECT_EQ(output.array_values, input.array_values);
+        EXPECT_EQ(output.colors, input.colors);
+        EXPECT_EQ(output.counters, input.counters);
+        EXPECT_EQ(output.timestamp, input.timestamp);
+        EXPECT_EQ(output.missing_timestamp, input.missing_timestamp);
+        ASSERT_NE(output.level, nullptr);
+        EXPECT_EQ(*output.level, *input.level);
+        ASSERT_NE(output.shared_1, nullptr);
+        EXPECT_EQ(*output.shared_1, *input.shared_1);
+        EXPECT_EQ(output.shared_1, output.shared_2);
+        EXPECT_EQ(output.code, input.code);
+        EXPECT_EQ(output.optional_values, input.optional_values);
+        EXPECT_EQ(output.position, input.position);
+    }
+
+    // Values mostly below 64, in runs found at once by the decoder, mixed with values of every size.
+    template<typename T>
+    std::vector<T> create_random_values(const size_t count) {
+        auto random = std::mt19937_64{ 1234 };
+        auto result = std::vector<T>(count);
+
+        for (auto& value : result) {
+            if (random() % 8 == 0) {
+                value = static_cast<T>(random());
+            }
+            else {
+                value = static_cast<T>(static_cast<int64_t>(random() % 128) - 64);
+            }
+        }
+
+        return result;
+    }
+
+    TEST(varint_integers, ok_read_write) {
+        const auto input = create_integers();
+
+        auto write_result = blopp::write<varint_integers_options>(input);
+        ASSERT_TRUE(write_result);
+
+        auto read_result = blopp::read<varint_integers_options, test_struct_integers>(*write_result);
+        ASSERT_TRUE(read_result);
+        EXPECT_TRUE(read_result->remaining.empty());
+        expect_integers_eq(read_result->value, input);
+
+        auto default_write_result = blopp::write(input);
+        ASSERT_TRUE(default_write_result);
+        EXPECT_LT(write_result->size(), default_write_result->size());
+    }
+
+    TEST(varint_integers, ok_read_with_any_options) {
+        const auto input = create_integers();
+
+        auto write_result = blopp::write<varint_integers_options>(input);
+        ASSERT_TRUE(write_result);
+
+        auto read_result = blopp::read<test_struct_integers>(*write_result);
+        ASSERT_TRUE(read_result);
+        expect_integers_eq(read_result->value, input);
+
+        auto trusted_read_result = blopp::read<varint_integers_trusted_options, test_struct_integers>(*write_result);
+        ASSERT_TRUE(trusted_read_result);
+        expect_integers_eq(trusted_read_result->value, input);
+
+        auto verify_result = blopp::verify<blopp::default_options, test_struct_integers>(*write_result);
+        ASSERT_TRUE(verify_result);
+        EXPECT_TRUE(verify_result->empty());
+    }
+
+    TEST(varint_integers, ok_binary_format) {
+        auto write_result = blopp::write<varint_integers_options>(int64_t{ -2 });
+        ASSERT_TRUE(write_result);
+        EXPECT_EQ(*write_result, (std::vector<uint8_t>{ 0b00100110, 3 }));
+
+        // ZigZag encoded 300 is 600, written in two bytes, of 7 bits each.
+        write_result = blopp::write<varint_integers_options>(int32_t{ 300 });
+        ASSERT_TRUE(write_result);
+        EXPECT_EQ(*write_result, (std::vector<uint8_t>{ 0b00100101, 0b11011000, 0b00000100 }));
+
+        write_result = blopp::write<varint_integers_options>(std::numeric_limits<uint64_t>::max());
+        ASSERT_TRUE(write_result);
+        EXPECT_EQ(*write_result, (std::vector<uint8_t>{ 0b00101010, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x01 }));
+
+        // Single bytes, floating points and booleans are written as is.
+        write_result = blopp::write<varint_integers_options>(uint8_t{ 200 });
+        ASSERT_TRUE(write_result);
+        EXPECT_EQ(*write_result, (std::vector<uint8_t>{ 7, 200 }));
+
+        write_result = blopp::write<varint_integers_options>(std::vector<int16_t>{ 1, -1, 64 });
+        ASSERT_TRUE(write_result);
+        EXPECT_EQ(*write_result, (std::vector<uint8_t>{
+            15, 13, 0, 0, 0, 0, 0, 0, 0, 0b00100100, 3, 0, 0, 0, 0, 0, 0, 0, 2, 1, 0b10000000, 0b00000001 }));
+    }
+
+    template<typename T>
+    void expect_nested_nullable_read_write(const T& input, const bool is_varint) {
+        auto write_result = blopp::write<varint_integers_options>(input);
+        ASSERT_TRUE(write_result);
+        ASSERT_FALSE(write_result->empty());
+        EXPECT_EQ((write_result->front() & 0b00100000) != 0, is_varint);
+
+        auto default_write_result = blopp::write(input);
+        ASSERT_TRUE(default_write_result);
+        EXPECT_EQ(write_result->size() < default_write_result->size(), is_varint);
+
+        auto read_result = blopp::read<T>(*write_result);
+        ASSERT_TRUE(read_result);
+        EXPECT_TRUE(read_result->remaining.empty());
+        ASSERT_TRUE(read_result->value);
+        ASSERT_TRUE(*read_result->value);
+        EXPECT_EQ(**read_result->value, int64_t{ -2 });
+
+        auto verify_result = blopp::verify<blopp::default_options, T>(*write_result);
+        ASSERT_TRUE(verify_result);
+        EXPECT_TRUE(verify_result->empty());
+    }
+
+    TEST(varint_integers, ok_nested_nullables) {
+        expect_nested_nullable_read_write(std::optional<std::optional<int64_t>>{ int64_t{ -2 } }, true);
+        expect_nested_nullable_read_write(std::make_unique<std::optional<int64_t>>(int64_t{ -2 }), true);
+
+        // Integers of shared pointers are fixed size, also in nullables held by them.
+        expect_nested_nullable_read_write(std::make_shared<std::optional<int64_t>>(int64_t{ -2 }), false);
+        expect_nested_nullable_read_write(std::optional<std::shared_ptr<int64_t>>{ std::make_shared<int64_t>(-2) }, false);
+    }
+
+    TEST(varint_integers, ok_large_lists) {
+        const auto int64_values = create_random_values<int64_t>(10000);
+        const auto uint32_values = create_random_values<uint32_t>(10001);
+        const auto int16_values = create_random_values<int16_t>(9999);
+
+        auto write_result = blopp::write<varint_integers_options>(int64_values);
+        ASSERT_TRUE(write_result);
+        EXPECT_LT(write_result->size(), int64_values.size() * sizeof(int64_t) / 2);
+
+        auto read_result = blopp::read<std::vector<int64_t>>(*write_result);
+        ASSERT_TRUE(read_result);
+        EXPECT_EQ(read_result->value, int64_values);
+
+        auto uint32_write_result = blopp::write<varint_integers_options>(uint32_values);
+        ASSERT_TRUE(uint32_write_result);
+
+        auto uint32_read_result = blopp::read<std::vector<uint32_t>>(*uint32_write_result);
+        ASSERT_TRUE(uint32_read_result);
+        EXPECT_EQ(uint32_read_result->value, uint32_values);
+
+        auto int16_write_result = blopp::write<varint_integers_options>(int16_values);
+        ASSERT_TRUE(int16_write_result);
+
+        auto int16_read_result = blopp::read<std::vector<int16_t>>(*int16_write_result);
+        ASSERT_TRUE(int16_read_result);
+        EXPECT_EQ(int16_read_result->value, int16_values);
+
+        // Read into a list already holding elements, and into lists without contiguous storage.
+        auto output = std::vector<int64_t>(5, 7);
+        auto read_into_result = blopp::read_into(*write_result, output);
+        ASSERT_TRUE(read_into_result);
+        EXPECT_EQ(output, int64_values);
+
+        auto list_read_result = blopp::read<std::list<int64_t>>(*write_result);
+        ASSERT_TRUE(list_read_result);
+        EXPECT_EQ((std::vector<int64_t>{ list_read_result->value.begin(), list_read_result->value.end() }), int64_values);
+    }
+
+    template<typename T>
+    void expect_list_read_write(const std::vector<T>& input) {
+        auto write_result = blopp::write<varint_integers_options>(input);
+        ASSERT_TRUE(write_result);
+
+        auto read_result = blopp::read<std::vector<T>>(*write_result);
+        ASSERT_TRUE(read_result);
+        EXPECT_EQ(read_result->value, input);
+
+        auto trusted_read_result = blopp::read<varint_integers_trusted_options, std::vector<T>>(*write_result);
+        ASSERT_TRUE(trusted_read_result);
+        EXPECT_EQ(trusted_read_result->value, input);
+    }
+
+    TEST(varint_integers, ok_lists_of_mixed_sizes) {
+        // Values around the limits of one to five byte varints, in varying order.
+        const auto limits = std::vector<int64_t>{ 
+            0, -1, 63, -64, 64, -65, 8191, -8192, 8192, -8193, 1048575, -1048576, 1048576, 
+            134217727, -134217728, 134217728, -134217729 };
+        auto random = std::mt19937_64{ 1234 };
+
+        auto int64_values = std::vector<int64_t>(5000);
+        for (auto& value : int64_values) {
+            value = limits.at(random() % limits.size());
+        }
+        expect_list_read_write(int64_values);
+
+        auto int32_values = std::vector<int32_t>(5001);
+        for (auto& value : int32_values) {
+            value = static_cast<int32_t>(static_cast<int64_t>(random() % 20000) - 10000);
+        }
+        expect_list_read_write(int32_values);
+
+        // Values of random bit widths, so blocks mix varints of all sizes.
+        auto int32_width_values = std::vector<int32_t>(5003);
+        for (auto& value : int32_width_values) {
+            value = static_cast<int32_t>(random() >> (32 + random() % 32));
+        }
+        int32_width_values.front() = std::numeric_limits<int32_t>::min();
+        int32_width_values.back() = std::numeric_limits<int32_t>::max();
+        expect_list_read_write(int32_width_values);
+
+        auto uint32_values = std::vector<uint32_t>(5002);
+        for (auto& value : uint32_values) {
+            value = static_cast<uint32_t>(limits.at(random() % limits.size()));
+        }
+        expect_list_read_write(uint32_values);
+
+        auto int16_values = std::vector<int16_t>(4999);
+        for (auto& value : int16_values) {
+            value = static_cast<int16_t>(random());
+        }
+        int16_values.front() = std::numeric_limits<int16_t>::min();
+        int16_values.back() = std::numeric_limits<int16_t>::max();
+        expect_list_read_write(int16_values);
+
+        auto uint16_values = std::vector<uint16_t>(4998);
+        for (auto& value : uint16_values) {
+            value = static_cast<uint16_t>(random() % 2 == 0 ? random() % 128 : random() % 20000);
+        }
+        uint16_values.back() = std::numeric_limits<uint16_t>::max();
+        expect_list_read_write(uint16_values);
+    }
+
+    TEST(varint_integers, ok_segmented_input) {
+        auto input = create_integers();
+        input.values = create_random_values<int64_t>(1000);
+
+        auto write_result = blopp::write<varint_integers_options>(input);
+        ASSERT_TRUE(write_result);
+
+        const auto data = std::span<const uint8_t>{ *write_result };
+        auto segments = std::vector<blopp::read_input_type>{};
+        for (size_t position = 0; position < data.size(); position += 7) {
+            segments.push_back(data.subspan(position, std::min(size_t{ 7 }, data.size() - position)));
+        }
+
+        auto read_result = blopp::read<varint_integers_options, test_struct_integers>(segments);
+        ASSERT_TRUE(read_result);
+        expect_integers_eq(read_result->value, input);
+    }
+
+    TEST(varint_integers, ok_map_as) {
+        const auto input = test_struct_mapped_as_varint{ .id = -3, .total = 5, .values = { 1, 2, -3 } };
+
+        auto write_result = blopp::write(input);
+        ASSERT_TRUE(write_result);
+
+        // Data type and property count, id of 1 + 1 bytes, total of 1 + 8 bytes, and values of 3 bytes after the list header.
+        const auto object_header_size = size_t{ 1 + 8 + 2 };
+        const auto list_header_size = size_t{ 1 + 8 + 1 + 8 };
+        EXPECT_EQ(write_result->size(), object_header_size + 2 + 9 + list_header_size + 3);
+
+        auto read_result = blopp::read<test_struct_mapped_as_varint>(*write_result);
+        ASSERT_TRUE(read_result);
+        EXPECT_EQ(read_result->value.id, input.id);
+        EXPECT_EQ(read_result->value.total, input.total);
+        EXPECT_EQ(read_result->value.values, input.values);
+    }
+
+    TEST(varint_integers, ok_skip_and_view) {
+        const auto input = create_integers();
+
+        auto write_result = blopp::write<varint_integers_options>(input);
+        ASSERT_TRUE(write_result);
+
+        auto skip_read_result = blopp::read<test_struct_skip_integers>(*write_result);
+        ASSERT_TRUE(skip_read_result);
+        EXPECT_EQ(skip_read_result->value.id, input.id);
+        EXPECT_EQ(skip_read_result->value.price, input.price);
+
+        auto object_view = blopp::make_view(*write_result).value().as_object();
+        ASSERT_TRUE(object_view);
+        EXPECT_EQ(object_view->at(0).value().as<int64_t>().value(), input.id);
+        EXPECT_EQ(object_view->at(5).value().as<test_enum_color>().value(), input.color);
+        EXPECT_EQ(object_view->at(6).value().as_list().value().at(8).value().as<int64_t>().value(), input.values.at(8));
+        EXPECT_EQ(object_view->at(10).value().as_map().value().find(int32_t{ 1 }).value().as<int64_t>().value(), -1000000);
+        EXPECT_EQ(object_view->at(11).value().as<std::optional<int64_t>>().value(), input.timestamp);
+        EXPECT_EQ(object_view->at(14).value().as<std::shared_ptr<int64_t>>().value().operator*(), *input.shared_1);
+        EXPECT_EQ(object_view->at(15).value().as<std::shared_ptr<int64_t>>().value().operator*(), *input.shared_1);
+        EXPECT_EQ(object_view->at(18).value().as<test_struct_position>().value(), input.position);
+    }
+
+    TEST(varint_integers, ok_decoder_and_encoder) {
+        const auto input = create_integers();
+
+        auto write_result = blopp::write<varint_integers_options>(input);
+        ASSERT_TRUE(write_result);
+
+        auto encoder = blopp::encoder<test_struct_integers, varint_integers_options>{ input };
+        auto window = std::vector<uint8_t>(5);
+        auto encoded = std::vector<uint8_t>{};
+        while (encoder.status() != blopp::encode_status::complete) {
+            auto encode_result = encoder.write(window);
+            ASSERT_TRUE(encode_result);
+            encoded.insert(encoded.end(), window.begin(), window.begin() + encode_result->written_size);
+        }
+        EXPECT_EQ(encoded, *write_result);
+
+        auto decoder = blopp::decoder<test_struct_integers>{};
+        for (const auto byte : *write_result) {
+            auto push_result = decoder.push(std::span<const uint8_t>{ &byte, 1 });
+            ASSERT_TRUE(push_result);
+        }
+        ASSERT_EQ(decoder.status(), blopp::decode_status::complete);
+        expect_integers_eq(decoder.value(), input);
+
+        // Messages of a single varint are complete once its last byte is pushed.
+        auto value_write_result = blopp::write<varint_integers_options>(int64_t{ 1000000 });
+        ASSERT_TRUE(value_write_result);
+
+        auto value_decoder = blopp::decoder<int64_t>{};
+        for (size_t i = 0; i < value_write_result->size(); i++) {
+            EXPECT_NE(value_decoder.status(), blopp::decode_status::complete);
+            auto push_result = value_decoder.push(std::span<const uint8_t>{ value_write_result->data() + i, 1 });
+            ASSERT_TRUE(push_result);
+        }
+        ASSERT_EQ(value_decoder.status(), blopp::decode_status::complete);
+        EXPECT_EQ(value_decoder.value(), int64_t{ 1000000 });
+    }
+
+    TEST(varint_integers, ok_parallel) {
+        auto input = std::vector<test_struct_integers>(20);
+        for (auto& value : input) {
+            value = create_integers();
+        }
+
+        auto write_result = blopp::write<varint_integers_options>(input);
+        ASSERT_TRUE(write_result);
+
+        auto parallel_write_result = blopp::write<varint_integers_parallel_options>(input);
+        ASSERT_TRUE(parallel_write_result);
+        EXPECT_EQ(*parallel_write_result, *write_result);
+
+        auto read_result = blopp::read<varint_integers_parallel_options, std::vector<test_struct_integers>>(*write_result);
+        ASSERT_TRUE(read_result);
+        ASSERT_EQ(read_result->value.size(), input.size());
+        for (size_t i = 0; i < input.size(); i++) {
+            expect_integers_eq(read_result->value.at(i), input.at(i));
+        }
+    }
+
+    TEST(varint_integers, fail_bad_varint) {
+        // Value over the 16 bits of int16.
+        auto read_result = blopp::read<int16_t>(std::vector<uint8_t>{ 0b00100100, 0x80, 0x80, 0x04 });
+        ASSERT_FALSE(read_result);
+        EXPECT_EQ(read_result.error(), blopp::read_error_code::bad_varint);
+
+        auto list_read_result = blopp::read<std::vector<int16_t>>(std::vector<uint8_t>{
+            15, 12, 0, 0, 0, 0, 0, 0, 0, 0b00100100, 1, 0, 0, 0, 0, 0, 0, 0, 0x80, 0x80, 0x04 });
+        ASSERT_FALSE(list_read_result);
+        EXPECT_EQ(list_read_result.error(), blopp::read_error_code::bad_varint);
+
+        auto insufficient_read_result = blopp::read<int64_t>(std::vector<uint8_t>{ 0b00100110, 0x80 });
+        ASSERT_FALSE(insufficient_read_result);
+        EXPECT_EQ(insufficient_read_result.error(), blopp::read_error_code::insufficient_data);
+    }
+
+    TEST(varint_integers, fail_elements_outside_list) {
+        // Three varints in a list of two elements.
+        auto read_result = blopp::read<std::vector<int32_t>>(std::vector<uint8_t>{
+            15, 12, 0, 0, 0, 0, 0, 0, 0, 0b00100101, 2, 0, 0, 0, 0, 0, 0, 0, 1, 2, 3 });
+        ASSERT_FALSE(read_result);
+        EXPECT_EQ(read_result.error(), blopp::read_error_code::bad_list_offset);
+    }
+
+    TEST(varint_integers, fail_mismatching_type) {
+        // Varint flag of a float.
+        auto read_result = blopp::read<float>(std::vector<uint8_t>{ 0b00101011, 0, 0, 0, 0 });
+        ASSERT_FALSE(read_result);
+        EXPECT_EQ(read_result.error(), blopp::read_error_code::mismatching_type);
+
+        // Varints can't be viewed as spans of the input.
+        auto write_result = blopp::write<varint_integers_options>(std::vector<int32_t>{ 1, 2, 3 });
+        ASSERT_TRUE(write_result);
+
+        auto span_read_result = blopp::read<std::span<const int32_t>>(*write_result);
+        ASSERT_FALSE(span_read_result);
+        EXPECT_EQ(span_read_result.error(), blopp::read_error_code::mismatching_type);
+    }
+
+    TEST(varint_integers, fail_conversion_overflow) {
+        auto write_result = blopp::write(test_struct_mapped_as_small_varint{ .id = 70000 });
+        ASSERT_FALSE(write_result);
+        EXPECT_EQ(write_result.error(), blopp::write_error_code::conversion_overflow);
+    }
+}
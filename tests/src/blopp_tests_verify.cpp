@@ -0,0 +1,112 @@
+#include "blopp_test.hpp"
+#include "blopp_test_store.hpp"
+
+namespace {
+    using blopp_test::test_struct_product;
+    using blopp_test::test_struct_store;
+    using blopp_test::create_store;
+
+    struct test_trusted_strict_options : blopp::default_binary_format_types {
+        static constexpr auto allow_object_excess_bytes = false;
+        static constexpr auto allow_more_object_members = false;
+        static constexpr auto trusted_input = true;
+    };
+
+    static_assert(blopp::impl::options_trusted_input_v<blopp::trusted_default_options>);
+    static_assert(blopp::impl::options_trusted_input_v<test_trusted_strict_options>);
+    static_assert(!blopp::impl::options_trusted_input_v<blopp::default_options>);
+
+    TEST(verify, ok_verify) {
+        auto write_result = blopp::write(create_store(10));
+        ASSERT_TRUE(write_result);
+
+        auto verify_result = blopp::verify<test_struct_store>(*write_result);
+        ASSERT_TRUE(verify_result);
+        EXPECT_TRUE(verify_result->empty());
+    }
+
+    TEST(verify, ok_remaining) {
+        auto write_result = blopp::write(create_store(2));
+        ASSERT_TRUE(write_result);
+        write_result->push_back(uint8_t{ 123 });
+
+        auto verify_result = blopp::verify<test_struct_store>(*write_result);
+        ASSERT_TRUE(verify_result);
+        ASSERT_EQ(verify_result->size(), size_t{ 1 });
+        EXPECT_EQ(verify_result->front(), uint8_t{ 123 });
+    }
+
+    TEST(verify, ok_trusted_read) {
+        const auto input = create_store(10);
+
+        auto write_result = blopp::write(input);
+        ASSERT_TRUE(write_result);
+
+        ASSERT_TRUE(blopp::verify<test_struct_store>(*write_result));
+
+        auto read_result = blopp::read<blopp::trusted_default_options, test_struct_store>(*write_result);
+        ASSERT_TRUE(read_result);
+        EXPECT_TRUE(read_result->remaining.empty());
+
+        blopp_test::expect_store_eq(read_result->value, input);
+    }
+
+    TEST(verify, ok_trusted_read_strict_options) {
+        const auto input = create_store(3);
+
+        auto write_result = blopp::write<test_trusted_strict_options>(input);
+        ASSERT_TRUE(write_result);
+
+        ASSERT_TRUE((blopp::verify<test_trusted_strict_options, test_struct_store>(*write_result)));
+
+        auto read_result = blopp::read<test_trusted_strict_options, test_struct_store>(*write_result);
+        ASSERT_TRUE(read_result);
+        EXPECT_EQ(read_result->value.products, input.products);
+    }
+
+    TEST(verify, fail_same_errors_as_read) {
+        auto write_result = blopp::write(create_store(3));
+        ASSERT_TRUE(write_result);
+
+        for (size_t size = 0; size < write_result->size(); size++) {
+            const auto input = std::span{ *write_result }.first(size);
+
+            auto verify_result = blopp::verify<test_struct_store>(input);
+            auto read_result = blopp::read<test_struct_store>(input);
+            ASSERT_FALSE(verify_result);
+            ASSERT_FALSE(read_result);
+            EXPECT_EQ(verify_result.error(), read_result.error());
+        }
+
+        for (size_t position = 0; position < write_result->size(); position++) {
+            auto input = *write_result;
+            input.at(position) ^= uint8_t{ 0b10100101 };
+
+            auto verify_result = blopp::verify<test_struct_store>(input);
+            auto read_result = blopp::read<test_struct_store>(input);
+            ASSERT_EQ(static_cast<bool>(verify_result), static_cast<bool>(read_result));
+            if (!verify_result) {
+                EXPECT_EQ(verify_result.error(), read_result.error());
+            }
+        }
+    }
+
+    TEST(verify, fail_mismatching_type) {
+        auto write_result = blopp::write(create_store(3));
+        ASSERT_TRUE(write_result);
+
+        auto verify_result = blopp::verify<test_struct_product>(*write_result);
+        ASSERT_FALSE(verify_result);
+        EXPECT_EQ(verify_result.error(), blopp::read_error_code::mismatching_type);
+    }
+
+    TEST(verify, fail_bad_boolean_value) {
+        auto write_result = blopp::write(std::vector<bool>{ true, false, true });
+        ASSERT_TRUE(write_result);
+        write_result->back() = uint8_t{ 2 };
+
+        auto verify_result = blopp::verify<std::vector<bool>>(*write_result);
+        ASSERT_FALSE(verify_result);
+        EXPECT_EQ(verify_result.error(), blopp::read_error_code::bad_boolean_value);
+    }
+}
@@ -0,0 +1,277 @@
+#include "blopp_test.hpp"
+#include "blopp_test_binary_format_types.hpp"
+#include "blopp_test_store.hpp"
+
+namespace {
+    using blopp_test::test_struct_vec3;
+    using blopp_test::test_struct_product;
+
+    template<typename TOptions>
+    void expect_store_view(const std::vector<uint8_t>& data) {
+        auto root_view = blopp::make_view<TOptions>(data);
+        ASSERT_TRUE(root_view);
+
+        auto store_view = root_view->as_object();
+        ASSERT_TRUE(store_view);
+        EXPECT_EQ(store_view->size(), size_t{ 7 });
+
+        auto name_view = store_view->at(0);
+        ASSERT_TRUE(name_view);
+        auto name = name_view->template as<std::string>();
+        ASSERT_TRUE(name);
+        EXPECT_EQ(name.value(), "Fruit store 0");
+
+        auto products_view = store_view->at(1).value().as_list();
+        ASSERT_TRUE(products_view);
+        EXPECT_EQ(products_view->size(), size_t{ 100 });
+
+        auto product_view = products_view->at(77).value().as_object();
+        ASSERT_TRUE(product_view);
+
+        auto product_name = product_view->at(1).value().template as<std::string_view>();
+        ASSERT_TRUE(product_name);
+        EXPECT_EQ(product_name.value(), "Product 77");
+
+        auto product_values_view = product_view->at(2).value().as_list();
+        ASSERT_TRUE(product_values_view);
+        EXPECT_EQ(product_values_view->size(), size_t{ 77 });
+
+        auto product_value = product_values_view->at(76).value().template as<int32_t>();
+        ASSERT_TRUE(product_value);
+        EXPECT_EQ(product_value.value(), int32_t{ 77 });
+
+        auto product = products_view->at(76).value().template as<test_struct_product>();
+        ASSERT_TRUE(product);
+        EXPECT_EQ(product->id, uint32_t{ 76 });
+        EXPECT_EQ(product->values, std::vector<int32_t>(size_t{ 76 }, int32_t{ 76 }));
+        ASSERT_TRUE(product->price.has_value());
+        EXPECT_EQ(product->price.value(), 76 * 1.5);
+
+        auto product_position = product_view->at(7).value().template as<test_struct_vec3>();
+        ASSERT_TRUE(product_position);
+        EXPECT_EQ(product_position->z, 77.0f);
+
+        auto product_price_view = product_view->at(8);
+        ASSERT_TRUE(product_price_view);
+        EXPECT_FALSE(product_price_view->has_value());
+
+        auto product_variant = product_view->at(9).value().template as<std::variant<int32_t, std::string>>();
+        ASSERT_TRUE(product_variant);
+        ASSERT_EQ(product_variant->index(), size_t{ 0 });
+        EXPECT_EQ(std::get<0>(product_variant.value()), int32_t{ 77 });
+
+        auto stock_view = store_view->at(3).value().as_map();
+        ASSERT_TRUE(stock_view);
+        EXPECT_EQ(stock_view->size(), size_t{ 3 });
+
+        auto stock_key = stock_view->key(1).value().template as<std::string>();
+        ASSERT_TRUE(stock_key);
+        EXPECT_EQ(stock_key.value(), "banana");
+
+        auto stock_value = stock_view->value(2).value().template as<int32_t>();
+        ASSERT_TRUE(stock_value);
+        EXPECT_EQ(stock_value.value(), int32_t{ 30 });
+
+        auto found_stock_value = stock_view->find(std::string_view{ "banana" }).value().template as<int32_t>();
+        ASSERT_TRUE(found_stock_value);
+        EXPECT_EQ(found_stock_value.value(), int32_t{ 20 });
+
+        auto missing_stock_view = stock_view->find(std::string_view{ "durian" });
+        ASSERT_FALSE(missing_stock_view);
+        EXPECT_EQ(missing_stock_view.error(), blopp::read_error_code::out_of_range);
+
+        auto description = store_view->at(6).value().template as<std::unique_ptr<std::string>>();
+        ASSERT_TRUE(description);
+        ASSERT_TRUE(description.value());
+        EXPECT_EQ(*description.value(), "Description of a store 0");
+    }
+
+    TEST(view, ok_navigate) {
+        auto write_result = blopp::write(blopp_test::create_store(100));
+        ASSERT_TRUE(write_result);
+
+        expect_store_view<blopp::default_options>(*write_result);
+    }
+
+    TEST(view, ok_navigate_compact) {
+        auto write_result = blopp::write<blopp::compact_default_options>(blopp_test::create_store(100));
+        ASSERT_TRUE(write_result);
+
+        expect_store_view<blopp::compact_default_options>(*write_result);
+    }
+
+    TEST(view, ok_navigate_varint) {
+        auto write_result = blopp::write<blopp::varint_default_options>(blopp_test::create_store(100));
+        ASSERT_TRUE(write_result);
+
+        expect_store_view<blopp::varint_default_options>(*write_result);
+    }
+
+    TEST(view, ok_fundamental_root) {
+        auto write_result = blopp::write(int32_t{ 123 });
+        ASSERT_TRUE(write_result);
+
+        auto root_view = blopp::make_view(*write_result);
+        ASSERT_TRUE(root_view);
+
+        auto value = root_view->as<int32_t>();
+        ASSERT_TRUE(value);
+        EXPECT_EQ(value.value(), int32_t{ 123 });
+    }
+
+    TEST(view, ok_shared_ptr_reference) {
+        auto write_result = blopp::write(blopp_test::create_store(100));
+        ASSERT_TRUE(write_result);
+
+        auto store_view = blopp::make_view(*write_result).value().as_object();
+        ASSERT_TRUE(store_view);
+
+        // Second pointer is written as a reference to the first one.
+        for (const size_t index : { size_t{ 4 }, size_t{ 5 } }) {
+            auto featured_view = store_view->at(index);
+            ASSERT_TRUE(featured_view);
+            ASSERT_TRUE(featured_view->has_value());
+
+            auto featured = featured_view->as<std::shared_ptr<test_struct_product>>();
+            ASSERT_TRUE(featured);
+            ASSERT_TRUE(featured.value());
+            EXPECT_EQ(featured.value()->id, uint32_t{ 50 });
+
+            auto featured_name = featured_view->as_object().value().at(1).value().as<std::string>();
+            ASSERT_TRUE(featured_name);
+            EXPECT_EQ(featured_name.value(), "Product 50");
+        }
+    }
+
+    TEST(view, ok_leaf_with_reference_outside_leaf) {
+        const auto shared_value = std::make_shared<int32_t>(123);
+        const auto input = std::vector<std::shared_ptr<int32_t>>{ shared_value, shared_value };
+
+        auto write_result = blopp::write(input);
+        ASSERT_TRUE(write_result);
+
+        auto list_view = blopp::make_view(*write_result).value().as_list();
+        ASSERT_TRUE(list_view);
+
+        auto second_value = list_view->at(1).value().as<std::shared_ptr<int32_t>>();
+        ASSERT_TRUE(second_value);
+        ASSERT_TRUE(second_value.value());
+        EXPECT_EQ(*second_value.value(), int32_t{ 123 });
+    }
+
+    TEST(view, fail_forged_reference_position) {
+        const auto shared_value = std::make_shared<int32_t>(123);
+        const auto input = std::vector<std::shared_ptr<int32_t>>{ shared_value, shared_value };
+
+        auto write_result = blopp::write(input);
+        ASSERT_TRUE(write_result);
+
+        // Moves the reference of the second element, ending the output, into the value of the first element.
+        auto& output = *write_result;
+        auto position = uint64_t{ 0 };
+        std::memcpy(&position, output.data() + output.size() - sizeof(position), sizeof(position));
+        position += 1;
+        std::memcpy(output.data() + output.size() - sizeof(position), &position, sizeof(position));
+
+        auto list_view = blopp::make_view(output).value().as_list();
+        ASSERT_TRUE(list_view);
+
+        auto element_view = list_view->at(1);
+        ASSERT_FALSE(element_view);
+        EXPECT_EQ(element_view.error(), blopp::read_error_code::bad_reference_position);
+    }
+
+    TEST(view, fail_forged_reference_type) {
+        const auto input = std::pair{ std::make_shared<int32_t>(123), std::make_shared<float>(1.0f) };
+
+        auto write_result = blopp::write(std::vector<std::variant<std::shared_ptr<int32_t>, std::shared_ptr<float>>>{
+            input.first, input.second, input.second });
+        ASSERT_TRUE(write_result);
+
+        auto& output = *write_result;
+        auto float_position = uint64_t{ 0 };
+        std::memcpy(&float_position, output.data() + output.size() - sizeof(float_position), sizeof(float_position));
+
+        // Points the reference to the float at the integer, written before it as payload, variant index, data type and flags.
+        const auto int_position = float_position - (sizeof(int32_t) + sizeof(uint16_t) + 2);
+        std::memcpy(output.data() + output.size() - sizeof(int_position), &int_position, sizeof(int_position));
+
+        auto list_view = blopp::make_view(output).value().as_list();
+        ASSERT_TRUE(list_view);
+
+        auto element = list_view->at(2).value().as<std::variant<std::shared_ptr<int32_t>, std::shared_ptr<float>>>();
+        ASSERT_FALSE(element);
+        EXPECT_EQ(element.error(), blopp::read_error_code::bad_reference_type);
+    }
+
+    TEST(view, fail_out_of_range) {
+        auto write_result = blopp::write(blopp_test::create_store(100));
+        ASSERT_TRUE(write_result);
+
+        auto store_view = blopp::make_view(*write_result).value().as_object();
+        ASSERT_TRUE(store_view);
+
+        auto property_view = store_view->at(7);
+        ASSERT_FALSE(property_view);
+        EXPECT_EQ(property_view.error(), blopp::read_error_code::out_of_range);
+
+        auto products_view = store_view->at(1).value().as_list();
+        ASSERT_TRUE(products_view);
+
+        auto element_view = products_view->at(100);
+        ASSERT_FALSE(element_view);
+        EXPECT_EQ(element_view.error(), blopp::read_error_code::out_of_range);
+    }
+
+    TEST(view, fail_mismatching_type) {
+        auto write_result = blopp::write(blopp_test::create_store(100));
+        ASSERT_TRUE(write_result);
+
+        auto root_view = blopp::make_view(*write_result);
+        ASSERT_TRUE(root_view);
+
+        auto list_view = root_view->as_list();
+        ASSERT_FALSE(list_view);
+        EXPECT_EQ(list_view.error(), blopp::read_error_code::mismatching_type);
+
+        auto name = root_view->as_object().value().at(0).value().as<int32_t>();
+        ASSERT_FALSE(name);
+        EXPECT_EQ(name.error(), blopp::read_error_code::mismatching_type);
+    }
+
+    TEST(view, fail_null_value) {
+        auto write_result = blopp::write(std::optional<std::vector<int32_t>>{});
+        ASSERT_TRUE(write_result);
+
+        auto root_view = blopp::make_view(*write_result);
+        ASSERT_TRUE(root_view);
+        EXPECT_FALSE(root_view->has_value());
+
+        auto list_view = root_view->as_list();
+        ASSERT_FALSE(list_view);
+        EXPECT_EQ(list_view.error(), blopp::read_error_code::null_value);
+
+        auto value = root_view->as<std::optional<std::vector<int32_t>>>();
+        ASSERT_TRUE(value);
+        EXPECT_FALSE(value->has_value());
+    }
+
+    TEST(view, fail_insufficient_data) {
+        auto write_result = blopp::write(blopp_test::create_store(100));
+        ASSERT_TRUE(write_result);
+
+        const auto input = std::span{ *write_result };
+
+        for (size_t size = 0; size < 64; size++) {
+            auto root_view = blopp::make_view(input.first(size));
+            if (!root_view) {
+                EXPECT_EQ(root_view.error(), blopp::read_error_code::insufficient_data);
+                continue;
+            }
+
+            auto store_view = root_view->as_object();
+            ASSERT_FALSE(store_view);
+            EXPECT_EQ(store_view.error(), blopp::read_error_code::insufficient_data);
+        }
+    }
+}
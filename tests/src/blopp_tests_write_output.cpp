@@ -0,0 +1,143 @@
+#include "blopp_test.hpp"
+#include "blopp_test_binary_format_types.hpp"
+#include "blopp_test_store.hpp"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+    std::atomic<size_t> allocation_count = 0;
+}
+
+// Replacements of malloc and free, which GCC flags once inlined into callers of new and delete.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void* operator new(std::size_t size) {
+    ++allocation_count;
+    if (auto* ptr = std::malloc(size == 0 ? 1 : size); ptr != nullptr) {
+        return ptr;
+    }
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+namespace {
+    using blopp_test::test_struct_store;
+    using blopp_test::create_store;
+
+    TEST(write_output, ok_append) {
+        auto output = blopp::write_output_type{ 0xAA, 0xBB };
+
+        auto write_result = blopp::write(int32_t{ 123 }, output);
+        ASSERT_TRUE(write_result);
+
+        ASSERT_EQ(output.size(), size_t{ 7 });
+        EXPECT_EQ(output.at(0), uint8_t{ 0xAA });
+        EXPECT_EQ(output.at(1), uint8_t{ 0xBB });
+
+        ASSERT_EQ(write_result->size(), size_t{ 5 });
+        EXPECT_EQ(write_result->data(), output.data() + 2);
+
+        auto read_result = blopp::read<int32_t>(*write_result);
+        ASSERT_TRUE(read_result);
+        EXPECT_EQ(read_result->value, int32_t{ 123 });
+        EXPECT_TRUE(read_result->remaining.empty());
+    }
+
+    TEST(write_output, ok_append_multiple) {
+        auto output = blopp::write_output_type{};
+
+        ASSERT_TRUE(blopp::write(std::string{ "first" }, output));
+        ASSERT_TRUE(blopp::write(std::string{ "second" }, output));
+
+        auto read_first_result = blopp::read<std::string>(output);
+        ASSERT_TRUE(read_first_result);
+        EXPECT_STREQ(read_first_result->value.c_str(), "first");
+
+        auto read_second_result = blopp::read<std::string>(read_first_result->remaining);
+        ASSERT_TRUE(read_second_result);
+        EXPECT_STREQ(read_second_result->value.c_str(), "second");
+        EXPECT_TRUE(read_second_result->remaining.empty());
+    }
+
+    TEST(write_output, ok_replace) {
+        auto output = blopp::write_output_type(size_t{ 100 }, uint8_t{ 0xAA });
+        const auto old_capacity = output.capacity();
+
+        auto write_result = blopp::write(int32_t{ 123 }, output, blopp::write_output_mode::replace);
+        ASSERT_TRUE(write_result);
+
+        EXPECT_EQ(output.size(), size_t{ 5 });
+        EXPECT_EQ(output.capacity(), old_capacity);
+        EXPECT_EQ(write_result->data(), output.data());
+        EXPECT_EQ(write_result->size(), size_t{ 5 });
+
+        auto read_result = blopp::read<int32_t>(*write_result);
+        ASSERT_TRUE(read_result);
+        EXPECT_EQ(read_result->value, int32_t{ 123 });
+    }
+
+    TEST(write_output, ok_same_output_as_write) {
+        const auto input = create_store();
+
+        auto write_result = blopp::write(input);
+        ASSERT_TRUE(write_result);
+
+        auto output = blopp::write_output_type{};
+        auto write_output_result = blopp::write(input, output);
+        ASSERT_TRUE(write_output_result);
+
+        EXPECT_EQ(output, *write_result);
+    }
+
+    TEST(write_output, ok_zero_allocations_after_warm_up) {
+        // Shared pointers are tracked by a table allocated per write.
+        auto input = create_store();
+        input.featured_1 = nullptr;
+        input.featured_2 = nullptr;
+        auto output = blopp::write_output_type{};
+
+        auto warm_up_result = blopp::write(input, output, blopp::write_output_mode::replace);
+        ASSERT_TRUE(warm_up_result);
+
+        const auto allocation_count_before = allocation_count.load();
+
+        for (size_t i = 0; i < 1000; i++) {
+            auto write_result = blopp::write(input, output, blopp::write_output_mode::replace);
+            ASSERT_TRUE(write_result);
+        }
+
+        EXPECT_EQ(allocation_count.load(), allocation_count_before);
+
+        auto read_result = blopp::read<test_struct_store>(output);
+        ASSERT_TRUE(read_result);
+        blopp_test::expect_store_eq(read_result->value, input);
+    }
+
+    TEST(write_output, fail_append_keeps_output) {
+        auto output = blopp::write_output_type{ 0xAA, 0xBB };
+
+        auto input = std::string(size_t{ 255 }, 'A');
+        auto write_result = blopp::write<blopp_test::minimal_offset_options>(input, output);
+        ASSERT_FALSE(write_result);
+        EXPECT_EQ(write_result.error(), blopp::write_error_code::string_offset_overflow);
+
+        ASSERT_EQ(output.size(), size_t{ 2 });
+        EXPECT_EQ(output.at(0), uint8_t{ 0xAA });
+        EXPECT_EQ(output.at(1), uint8_t{ 0xBB });
+    }
+}
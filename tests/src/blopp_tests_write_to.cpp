@@ -0,0 +1,92 @@
+#include "blopp_test.hpp"
+#include "blopp_test_binary_format_types.hpp"
+
+namespace {
+    struct test_struct_product {
+        uint32_t id;
+        std::string name;
+        std::vector<int32_t> values;
+    };
+}
+
+template<>
+struct blopp::object<test_struct_product> {
+    static auto map(auto& context, auto& value) {
+        context.map(
+            value.id,
+            value.name,
+            value.values);
+    }
+};
+
+namespace {
+    const auto test_product = test_struct_product{
+        .id = 123,
+        .name = "Apple",
+        .values = { 1, 2, 3, 4 }
+    };
+
+    TEST(write_to, ok_exact_buffer_size) {
+        auto write_result = blopp::write(test_product);
+        ASSERT_TRUE(write_result);
+
+        auto buffer = std::vector<uint8_t>(write_result->size(), uint8_t{ 0xCD });
+
+        auto write_to_result = blopp::write_to(buffer, test_product);
+        ASSERT_TRUE(write_to_result);
+        EXPECT_EQ(write_to_result.value(), write_result->size());
+        EXPECT_EQ(buffer, *write_result);
+
+        auto read_result = blopp::read<test_struct_product>(buffer);
+        ASSERT_TRUE(read_result);
+
+        auto& output = read_result->value;
+        EXPECT_EQ(output.id, uint32_t{ 123 });
+        EXPECT_STREQ(output.name.c_str(), "Apple");
+        EXPECT_EQ(output.values, test_product.values);
+    }
+
+    TEST(write_to, ok_larger_buffer) {
+        auto buffer = std::array<uint8_t, 256>{};
+
+        auto write_to_result = blopp::write_to<blopp::compact_default_options>(buffer, test_product);
+        ASSERT_TRUE(write_to_result);
+
+        auto size_result = blopp::serialized_size<blopp::compact_default_options>(test_product);
+        ASSERT_TRUE(size_result);
+        EXPECT_EQ(write_to_result.value(), size_result.value());
+
+        auto read_result = blopp::read<blopp::compact_default_options, test_struct_product>(
+            std::span{ buffer.data(), write_to_result.value() });
+        ASSERT_TRUE(read_result);
+        EXPECT_TRUE(read_result->remaining.empty());
+        EXPECT_EQ(read_result->value.values, test_product.values);
+    }
+
+    TEST(write_to, fail_insufficient_buffer) {
+        auto size_result = blopp::serialized_size(test_product);
+        ASSERT_TRUE(size_result);
+
+        const auto guard_size = size_t{ 16 };
+        for (size_t buffer_size = 0; buffer_size < size_result.value(); buffer_size++) {
+            auto buffer = std::vector<uint8_t>(buffer_size + guard_size, uint8_t{ 0xCD });
+
+            auto write_to_result = blopp::write_to(std::span{ buffer.data(), buffer_size }, test_product);
+            ASSERT_FALSE(write_to_result);
+            EXPECT_EQ(write_to_result.error(), blopp::write_error_code::insufficient_buffer);
+
+            for (size_t i = buffer_size; i < buffer.size(); i++) {
+                EXPECT_EQ(buffer.at(i), uint8_t{ 0xCD });
+            }
+        }
+    }
+
+    TEST(write_to, fail_string_offset_overflow) {
+        auto buffer = std::array<uint8_t, 512>{};
+
+        auto input = std::string(size_t{ 255 }, 'A');
+        auto write_to_result = blopp::write_to<blopp_test::minimal_offset_options>(buffer, input);
+        ASSERT_FALSE(write_to_result);
+        EXPECT_EQ(write_to_result.error(), blopp::write_error_code::string_offset_overflow);
+    }
+}